@@ -55,7 +55,18 @@ PYBIND11_MODULE(partition, m) {
           "possible number of colours. "
           "Such colourings need not be unique. "
           "Exponential time in the worst case, but often runs "
-          "much faster.");
+          "much faster.")
+      .value(
+          "DSatur", GraphColourMethod::DSatur,
+          "Builds the graph and then greedily colours by always "
+          "colouring next the vertex whose neighbours already use the "
+          "most distinct colours. Usually uses fewer colours than "
+          "LargestFirst.")
+      .value(
+          "JonesPlassmann", GraphColourMethod::JonesPlassmann,
+          "Builds the graph and then colours it in parallel by the "
+          "Jones-Plassmann algorithm, with the highest degree vertices "
+          "first. Suitable for very large sets of Pauli tensors.");
 
   py::class_<MeasurementSetup::MeasurementBitMap>(
       m, "MeasurementBitMap",
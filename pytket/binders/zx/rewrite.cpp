@@ -49,6 +49,20 @@ void init_rewrite(py::module &m) {
           "repeatedly.\n:return: A new :py:class:`Rewrite` representing the "
           "iteration.",
           py::arg("rewrite"))
+      .def_static(
+          "worklist", &Rewrite::worklist,
+          "Applies the given :py:class:`Rewrite` s until none of them "
+          "matches. Rather than rescanning the whole diagram, only vertices "
+          "changed by a rewrite are matched again. Supported by "
+          "spider_fusion, parallel_h_removal, remove_interior_cliffords and "
+          "remove_interior_paulis. The graph-like rewrites only check that "
+          "the diagram is graph-like around each match, so unlike combining "
+          "them with sequence and repeat they may also apply to diagrams "
+          "which are not graph-like as a whole, and the resulting diagram "
+          "may differ.\n\n:param sequence: The list of "
+          ":py:class:`Rewrite` s to be applied.\n:return: The combined "
+          ":py:class:`Rewrite`.",
+          py::arg("sequence"))
       .def_static(
           "decompose_boxes", &Rewrite::decompose_boxes,
           "Replaces every :py:class:`ZXBox` by its internal diagram "
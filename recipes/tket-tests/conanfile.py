@@ -30,8 +30,14 @@ class TketTestsConan(ConanFile):
         "with_coverage": [True, False],
         "full": [True, False],
         "long": [True, False],
+        "with_tsan": [True, False],
+    }
+    default_options = {
+        "with_coverage": False,
+        "full": False,
+        "long": False,
+        "with_tsan": False,
     }
-    default_options = {"with_coverage": False, "full": False, "long": False}
     generators = "cmake"
     exports_sources = "../../tket/tests/*"
     requires = ("tket/1.0.1", "catch2/3.1.0")
@@ -47,12 +53,15 @@ class TketTestsConan(ConanFile):
     def _configure_cmake(self):
         if self._cmake is None:
             self._cmake = CMake(self)
+            self._cmake.definitions["THREAD_SANITIZER"] = self.options.with_tsan
             self._cmake.configure()
         return self._cmake
 
     def configure(self):
         if self.options.with_coverage:
             self.options["tket"].profile_coverage = True
+        if self.options.with_tsan:
+            self.options["tket"].thread_sanitizer = True
 
     def build(self):
         cmake = self._configure_cmake()
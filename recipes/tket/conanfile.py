@@ -30,14 +30,23 @@ class TketConan(ConanFile):
     options = {
         "shared": [True, False],
         "profile_coverage": [True, False],
+        "thread_sanitizer": [True, False],
+        "concurrent_compilation": [True, False],
+    }
+    default_options = {
+        "shared": False,
+        "profile_coverage": False,
+        "thread_sanitizer": False,
+        "concurrent_compilation": False,
     }
-    default_options = {"shared": False, "profile_coverage": False}
     generators = "cmake"
     exports_sources = ["../../tket/src/*", "!*/build/*"]
     requires = (
         # tk* libraries may come from remote:
         # https://tket.jfrog.io/artifactory/api/conan/tket-conan
         "boost/1.79.0",
+        # With concurrent_compilation, this must be built with
+        # WITH_SYMENGINE_THREAD_SAFE=yes; tket fails to compile otherwise.
         "symengine/0.9.0",
         "eigen/3.4.0",
         "nlohmann_json/3.10.5",
@@ -78,6 +87,8 @@ class TketConan(ConanFile):
         if self._cmake is None:
             self._cmake = CMake(self)
             self._cmake.definitions["PROFILE_COVERAGE"] = self.options.profile_coverage
+            self._cmake.definitions["THREAD_SANITIZER"] = self.options.thread_sanitizer
+            self._cmake.definitions["CONCURRENT_COMPILATION"] = self.options.concurrent_compilation
             self._cmake.configure()
         return self._cmake
 
@@ -86,6 +97,10 @@ class TketConan(ConanFile):
             raise ConanInvalidConfiguration(
                 "`profile_coverage` option only available with gcc"
             )
+        if self.options.thread_sanitizer and self.settings.os == "Windows":
+            raise ConanInvalidConfiguration(
+                "`thread_sanitizer` option not available on Windows"
+            )
 
     def configure(self):
         # Disable features that are still under the LGPL.
@@ -111,3 +126,5 @@ class TketConan(ConanFile):
         # unresolved symbols in libraries earlier in the list get resolved by later
         # libraries.
         self.cpp_info.libs = [f"tket-{comp}" for comp in reversed(self.comps)]
+        if self.settings.os in ["Linux", "FreeBSD"]:
+            self.cpp_info.system_libs = ["pthread"]
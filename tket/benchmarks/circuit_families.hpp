@@ -0,0 +1,156 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <vector>
+
+// tket includes
+#include "Circuit/Boxes.hpp"
+#include "Circuit/Circuit.hpp"
+#include "Utils/PauliStrings.hpp"
+
+// Parameterised circuit families shared by the benchmarks. Generators are
+// seeded so that every run of a benchmark sees the same circuits.
+namespace tket {
+namespace benchmarks {
+
+// Draws integers in [0, n) from raw engine output, so the circuits do not
+// depend on the standard library's distribution implementations.
+class Draw {
+ public:
+  explicit Draw(std::uint32_t seed) : engine_(seed) {}
+  unsigned operator()(unsigned n) { return engine_() % n; }
+  double angle() { return static_cast<double>(engine_() % 4096) / 2048.; }
+
+ private:
+  std::mt19937 engine_;
+};
+
+// Random circuit over {H, S, T, Rz, CX}, roughly a third of gates being CX.
+inline Circuit random_circuit(
+    unsigned n_qubits, unsigned n_gates, std::uint32_t seed = 1) {
+  Circuit circ(n_qubits);
+  Draw draw(seed);
+  for (unsigned g = 0; g < n_gates; ++g) {
+    const unsigned q0 = draw(n_qubits);
+    switch (draw(6)) {
+      case 0:
+        circ.add_op<unsigned>(OpType::H, {q0});
+        break;
+      case 1:
+        circ.add_op<unsigned>(OpType::S, {q0});
+        break;
+      case 2:
+        circ.add_op<unsigned>(OpType::T, {q0});
+        break;
+      case 3:
+        circ.add_op<unsigned>(OpType::Rz, draw.angle(), {q0});
+        break;
+      default: {
+        const unsigned q1 = (q0 + 1 + draw(n_qubits - 1)) % n_qubits;
+        circ.add_op<unsigned>(OpType::CX, {q0, q1});
+      }
+    }
+  }
+  return circ;
+}
+
+// Random Clifford circuit over {H, S, V, CX}.
+inline Circuit clifford_circuit(
+    unsigned n_qubits, unsigned n_gates, std::uint32_t seed = 1) {
+  Circuit circ(n_qubits);
+  Draw draw(seed);
+  for (unsigned g = 0; g < n_gates; ++g) {
+    const unsigned q0 = draw(n_qubits);
+    switch (draw(5)) {
+      case 0:
+        circ.add_op<unsigned>(OpType::H, {q0});
+        break;
+      case 1:
+        circ.add_op<unsigned>(OpType::S, {q0});
+        break;
+      case 2:
+        circ.add_op<unsigned>(OpType::V, {q0});
+        break;
+      default: {
+        const unsigned q1 = (q0 + 1 + draw(n_qubits - 1)) % n_qubits;
+        circ.add_op<unsigned>(OpType::CX, {q0, q1});
+      }
+    }
+  }
+  return circ;
+}
+
+// Quantum Fourier transform, without the final qubit reversal.
+inline Circuit qft_circuit(unsigned n_qubits) {
+  Circuit circ(n_qubits);
+  for (unsigned i = 0; i < n_qubits; ++i) {
+    circ.add_op<unsigned>(OpType::H, {i});
+    double angle = 1.;
+    for (unsigned j = i + 1; j < n_qubits; ++j) {
+      angle /= 2.;
+      circ.add_op<unsigned>(OpType::CU1, angle, {j, i});
+    }
+  }
+  return circ;
+}
+
+// Random Pauli string over all of the qubits, with at least one
+// non-identity term.
+inline std::vector<Pauli> random_paulis(unsigned n_qubits, Draw& draw) {
+  std::vector<Pauli> paulis(n_qubits);
+  for (Pauli& p : paulis) p = static_cast<Pauli>(draw(4));
+  if (std::all_of(paulis.begin(), paulis.end(), [](Pauli p) {
+        return p == Pauli::I;
+      })) {
+    paulis[draw(n_qubits)] = Pauli::Z;
+  }
+  return paulis;
+}
+
+// UCC-style ansatz: a sequence of Pauli gadgets with random strings and
+// angles, as produced by Trotterising a sum of Pauli terms.
+inline Circuit ucc_circuit(
+    unsigned n_qubits, unsigned n_terms, std::uint32_t seed = 1) {
+  Circuit circ(n_qubits);
+  Draw draw(seed);
+  std::vector<unsigned> qubits(n_qubits);
+  for (unsigned q = 0; q < n_qubits; ++q) qubits[q] = q;
+  for (unsigned t = 0; t < n_terms; ++t) {
+    circ.add_box(
+        PauliExpBox(random_paulis(n_qubits, draw), draw.angle()), qubits);
+  }
+  return circ;
+}
+
+// Random Pauli strings, e.g. the terms of a Hamiltonian to be measured.
+inline std::list<QubitPauliString> random_pauli_strings(
+    unsigned n_qubits, unsigned n_strings, std::uint32_t seed = 1) {
+  std::list<QubitPauliString> strings;
+  Draw draw(seed);
+  for (unsigned s = 0; s < n_strings; ++s) {
+    const std::vector<Pauli> paulis = random_paulis(n_qubits, draw);
+    strings.push_back(
+        QubitPauliString(std::list<Pauli>(paulis.begin(), paulis.end())));
+  }
+  return strings;
+}
+
+}  // namespace benchmarks
+}  // namespace tket
@@ -0,0 +1,154 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+// tket includes
+#include "Circuit/Circuit.hpp"
+#include "Converters/Converters.hpp"
+#include "MeasurementSetup/MeasurementReduction.hpp"
+#include "Simulation/CircuitSimulator.hpp"
+#include "Utils/Json.hpp"
+#include "ZX/Rewrite.hpp"
+#include "ZX/ZXDiagram.hpp"
+#include "circuit_families.hpp"
+
+using namespace tket;
+
+static void BM_CircuitToZX(benchmark::State& state) {
+  const Circuit circ =
+      benchmarks::random_circuit(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(circuit_to_zx(circ));
+  }
+}
+
+BENCHMARK(BM_CircuitToZX)
+    ->ArgNames({"qubits", "gates"})
+    ->ArgsProduct({{8, 32}, {1000, 4000, 16000}})
+    ->Unit(benchmark::kMillisecond);
+
+// Rebase to a graph-like diagram and remove interior Clifford and Pauli
+// spiders, following theorem 5.4 of https://arxiv.org/abs/1902.03178.
+static void BM_ZXSimplify(benchmark::State& state) {
+  const Circuit circ =
+      benchmarks::random_circuit(state.range(0), state.range(1));
+  const zx::ZXDiagram diag = circuit_to_zx(circ).first;
+  const zx::Rewrite simp = zx::Rewrite::sequence(
+      {zx::Rewrite::rebase_to_zx(), zx::Rewrite::red_to_green(),
+       zx::Rewrite::spider_fusion(), zx::Rewrite::parallel_h_removal(),
+       zx::Rewrite::io_extension(), zx::Rewrite::separate_boundaries(),
+       zx::Rewrite::remove_interior_cliffords(),
+       zx::Rewrite::extend_at_boundary_paulis(),
+       zx::Rewrite::remove_interior_paulis()});
+  unsigned vertices_after = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    zx::ZXDiagram d = diag;
+    state.ResumeTiming();
+    simp.apply(d);
+    vertices_after = d.n_vertices();
+  }
+  state.counters["vertices_before"] = diag.n_vertices();
+  state.counters["vertices_after"] = vertices_after;
+}
+
+BENCHMARK(BM_ZXSimplify)
+    ->ArgNames({"qubits", "gates"})
+    ->ArgsProduct({{8, 32}, {1000, 4000}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_MeasurementReduction(benchmark::State& state) {
+  const std::list<QubitPauliString> strings =
+      benchmarks::random_pauli_strings(state.range(0), state.range(1));
+  const GraphColourMethod method =
+      static_cast<GraphColourMethod>(state.range(2));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(measurement_reduction(
+        strings, PauliPartitionStrat::CommutingSets, method));
+  }
+}
+
+BENCHMARK(BM_MeasurementReduction)
+    ->ArgNames({"qubits", "strings", "method"})
+    ->ArgsProduct(
+        {{8, 16},
+         {100, 400, 1600},
+         {static_cast<long>(GraphColourMethod::Lazy),
+          static_cast<long>(GraphColourMethod::LargestFirst)}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_GetUnitary(benchmark::State& state) {
+  const Circuit circ =
+      benchmarks::random_circuit(state.range(0), 20 * state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tket_sim::get_unitary(circ));
+  }
+}
+
+BENCHMARK(BM_GetUnitary)
+    ->ArgName("qubits")
+    ->DenseRange(2, 10, 2)
+    ->Unit(benchmark::kMillisecond);
+
+// Sample a random Clifford circuit, measured at the end, either with the
+// dense statevector sampler or with the stabiliser tableau sampler.
+static void BM_SampleCliffordShots(
+    benchmark::State& state, bool use_stabiliser) {
+  const unsigned n_qubits = state.range(0);
+  Circuit circ(n_qubits, n_qubits);
+  circ.append(benchmarks::clifford_circuit(n_qubits, 20 * n_qubits));
+  for (unsigned q = 0; q < n_qubits; ++q) circ.add_measure(q, q);
+  for (auto _ : state) {
+    if (use_stabiliser) {
+      benchmark::DoNotOptimize(
+          tket_sim::sample_stabiliser_shots(circ, state.range(1), 1));
+    } else {
+      benchmark::DoNotOptimize(tket_sim::sample_shots(circ, state.range(1), 1));
+    }
+  }
+}
+
+BENCHMARK_CAPTURE(BM_SampleCliffordShots, dense, false)
+    ->ArgNames({"qubits", "shots"})
+    ->ArgsProduct({{4, 8, 12, 16}, {100, 10000}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_SampleCliffordShots, stabiliser, true)
+    ->ArgNames({"qubits", "shots"})
+    ->ArgsProduct({{4, 8, 12, 16}, {100, 10000}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_JsonRoundTrip(benchmark::State& state) {
+  const Circuit circ =
+      benchmarks::random_circuit(state.range(0), state.range(1));
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    const nlohmann::json j = circ;
+    const std::string s = j.dump();
+    const Circuit c = nlohmann::json::parse(s).get<Circuit>();
+    benchmark::DoNotOptimize(c);
+    bytes = s.size();
+  }
+  state.counters["bytes"] = bytes;
+}
+
+BENCHMARK(BM_JsonRoundTrip)
+    ->ArgNames({"qubits", "gates"})
+    ->ArgsProduct({{8, 32}, {1000, 4000, 16000}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+// tket includes
+#include "Circuit/Circuit.hpp"
+#include "Predicates/CompilationUnit.hpp"
+#include "Predicates/CompilerPass.hpp"
+#include "Predicates/PassGenerators.hpp"
+#include "Transformations/OptimisationPass.hpp"
+#include "Transformations/Transform.hpp"
+#include "circuit_families.hpp"
+
+using namespace tket;
+
+// Applies the pass to a fresh copy of the circuit in every iteration; only
+// the pass itself is timed. Gate counts are reported alongside the timings.
+static void run_pass(
+    benchmark::State& state, const Circuit& circ, const PassPtr& pass) {
+  unsigned gates_after = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    CompilationUnit cu(circ);
+    state.ResumeTiming();
+    pass->apply(cu);
+    gates_after = cu.get_circ_ref().n_gates();
+  }
+  state.counters["gates_before"] = circ.n_gates();
+  state.counters["gates_after"] = gates_after;
+}
+
+static void BM_FullPeepholeOptimise_Random(benchmark::State& state) {
+  const Circuit circ =
+      benchmarks::random_circuit(state.range(0), state.range(1));
+  run_pass(state, circ, FullPeepholeOptimise());
+}
+
+BENCHMARK(BM_FullPeepholeOptimise_Random)
+    ->ArgNames({"qubits", "gates"})
+    ->ArgsProduct({{4, 8, 16}, {250, 1000, 4000}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_FullPeepholeOptimise_QFT(benchmark::State& state) {
+  run_pass(
+      state, benchmarks::qft_circuit(state.range(0)), FullPeepholeOptimise());
+}
+
+BENCHMARK(BM_FullPeepholeOptimise_QFT)
+    ->ArgName("qubits")
+    ->RangeMultiplier(2)
+    ->Range(4, 32)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_FullPeepholeOptimise_UCC(benchmark::State& state) {
+  const Circuit circ = benchmarks::ucc_circuit(state.range(0), state.range(1));
+  run_pass(state, circ, FullPeepholeOptimise());
+}
+
+BENCHMARK(BM_FullPeepholeOptimise_UCC)
+    ->ArgNames({"qubits", "terms"})
+    ->ArgsProduct({{4, 8, 12}, {16, 64}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_CliffordSimp(benchmark::State& state) {
+  const Circuit circ =
+      benchmarks::clifford_circuit(state.range(0), state.range(1));
+  const Transform simp = Transforms::clifford_simp();
+  unsigned gates_after = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    Circuit c = circ;
+    state.ResumeTiming();
+    simp.apply(c);
+    gates_after = c.n_gates();
+  }
+  state.counters["gates_before"] = circ.n_gates();
+  state.counters["gates_after"] = gates_after;
+}
+
+BENCHMARK(BM_CliffordSimp)
+    ->ArgNames({"qubits", "gates"})
+    ->ArgsProduct({{4, 16, 64}, {1000, 4000, 16000}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
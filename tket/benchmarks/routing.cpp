@@ -0,0 +1,72 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+// tket includes
+#include "Architecture/Architecture.hpp"
+#include "Circuit/Circuit.hpp"
+#include "Mapping/LexiLabelling.hpp"
+#include "Mapping/LexiRouteRoutingMethod.hpp"
+#include "Placement/Placement.hpp"
+#include "Predicates/CompilationUnit.hpp"
+#include "Predicates/CompilerPass.hpp"
+#include "Predicates/PassGenerators.hpp"
+#include "circuit_families.hpp"
+
+using namespace tket;
+
+// Places the circuit naively, so that the timings are dominated by routing.
+static void run_routing(benchmark::State& state, const Architecture& arc) {
+  const Circuit circ =
+      benchmarks::random_circuit(arc.n_nodes(), state.range(1));
+  const PassPtr pass = gen_full_mapping_pass(
+      arc, std::make_shared<NaivePlacement>(arc),
+      {std::make_shared<LexiLabellingMethod>(),
+       std::make_shared<LexiRouteRoutingMethod>()});
+  unsigned gates_after = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    CompilationUnit cu(circ);
+    state.ResumeTiming();
+    pass->apply(cu);
+    gates_after = cu.get_circ_ref().n_gates();
+  }
+  state.counters["gates_before"] = circ.n_gates();
+  state.counters["gates_after"] = gates_after;
+}
+
+static void BM_LexiRoute_Grid(benchmark::State& state) {
+  const unsigned side = state.range(0);
+  run_routing(state, SquareGrid(side, side));
+}
+
+BENCHMARK(BM_LexiRoute_Grid)
+    ->ArgNames({"side", "gates"})
+    ->ArgsProduct({{3, 5, 7, 10}, {500, 2000}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_LexiRoute_Ring(benchmark::State& state) {
+  run_routing(state, RingArch(state.range(0)));
+}
+
+BENCHMARK(BM_LexiRoute_Ring)
+    ->ArgNames({"qubits", "gates"})
+    ->ArgsProduct({{8, 16, 32, 64}, {500, 2000}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
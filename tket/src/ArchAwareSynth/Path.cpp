@@ -219,13 +219,15 @@ IterationOrder::IterationOrder(const Architecture &arch) {
   std::reverse(iterationorder.begin(), iterationorder.end());
 }
 
-MatrixXb PathHandler::get_connectivity_matrix() const {
+const MatrixXb &PathHandler::get_connectivity_matrix() const {
   return connectivity_matrix_;
 }
 
-MatrixXu PathHandler::get_distance_matrix() const { return distance_matrix_; }
+const MatrixXu &PathHandler::get_distance_matrix() const {
+  return distance_matrix_;
+}
 
-MatrixXu PathHandler::get_path_matrix() const { return path_matrix_; }
+const MatrixXu &PathHandler::get_path_matrix() const { return path_matrix_; }
 
 unsigned PathHandler::get_size() const { return size; }
 
@@ -15,10 +15,13 @@
 #include "SteinerForest.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <optional>
 #include <vector>
 
 #include "Architecture/Architecture.hpp"
 #include "SteinerTree.hpp"
+#include "Utils/ThreadPool.hpp"
 
 namespace tket {
 namespace aas {
@@ -183,8 +186,190 @@ OperationList SteinerForest::operations_available_at_min_costs(
   return operations;
 }
 
+namespace {
+
+/**
+ * The parts of a SteinerForest read by the lookahead search: the trees and
+ * the global cost, but not the circuit or the linear function.
+ *
+ * Each thread of the search has its own copy, which follows the search down
+ * and back up: row operations are applied and then undone, and only update
+ * the trees whose nodes they change, so no tree is copied while searching.
+ */
+class SearchForest {
+ public:
+  explicit SearchForest(const SteinerForest &forest)
+      : global_cost(forest.global_cost) {
+    for (const auto &cost_trees : forest.current_trees) {
+      for (const auto &tree_expr : cost_trees.second) {
+        order_.push_back(trees_.size());
+        trees_.push_back(tree_expr.first);
+      }
+    }
+  }
+
+  unsigned global_cost;
+
+  bool empty() const { return order_.empty(); }
+  unsigned n_trees() const { return order_.size(); }
+  unsigned max_tree_cost() const { return trees_[order_.back()].tree_cost; }
+
+  // Same effect on the trees and cost as SteinerForest::add_row_globally.
+  void add_row_globally(unsigned i, unsigned j) {
+    Step step{order_, global_cost, {}};
+    std::vector<unsigned> remaining;
+    for (unsigned t : order_) {
+      SteinerTree &tree = trees_[t];
+      // SteinerTree::add_row only changes the tree, or has a nonzero cost,
+      // if the control is a one.
+      const SteinerNodeType i_type = tree.node_types[i];
+      if (i_type == SteinerNodeType::OneInTree ||
+          i_type == SteinerNodeType::Leaf) {
+        step.changes.push_back({t, tree.add_row(i, j)});
+        if (tree.fully_reduced()) continue;
+        global_cost += tree.last_operation_cost;
+      }
+      remaining.push_back(t);
+    }
+    // Trees are kept in order of cost, and otherwise in their previous
+    // order, as in the CostedTrees of a SteinerForest.
+    std::stable_sort(
+        remaining.begin(), remaining.end(), [this](unsigned a, unsigned b) {
+          return trees_[a].tree_cost < trees_[b].tree_cost;
+        });
+    order_ = std::move(remaining);
+    history_.push_back(std::move(step));
+  }
+
+  // Undoes the last add_row_globally which has not been undone.
+  void undo_row_globally() {
+    Step &step = history_.back();
+    for (auto it = step.changes.rbegin(); it != step.changes.rend(); ++it) {
+      trees_[it->first].undo_row(it->second);
+    }
+    order_ = std::move(step.order);
+    global_cost = step.global_cost;
+    history_.pop_back();
+  }
+
+  // Same operations, in the same order, as the SteinerForest method.
+  OperationList operations_available_under_the_index(
+      const PathHandler &path, unsigned index) const {
+    OperationList operations;
+    for (unsigned t : order_) {
+      if (trees_[t].tree_cost >= index) break;
+      operations.splice(
+          operations.begin(), trees_[t].operations_available(path));
+    }
+    return operations;
+  }
+
+ private:
+  struct Step {
+    std::vector<unsigned> order;
+    unsigned global_cost;
+    std::vector<std::pair<unsigned, SteinerRowChange>> changes;
+  };
+
+  std::vector<SteinerTree> trees_;
+  // Indices into trees_ of the trees not yet fully reduced
+  std::vector<unsigned> order_;
+  std::vector<Step> history_;
+};
+
+bool is_better(
+    const CostedOperations &candidate, const CostedOperations &best) {
+  return (candidate.first < best.first) ||
+         ((candidate.first == best.first) &&
+          (candidate.second.size() < best.second.size()));
+}
+
+/**
+ * Depth-first search over sequences of row operations, as
+ * recursive_operation_search, but pruning subtrees which cannot beat the
+ * best cost found so far.
+ *
+ * The best cost is shared by all the threads searching the same forest.
+ * A row operation changes the cost of each tree by at least -1, so from a
+ * forest of cost c with t trees, l more operations cannot reach a cost
+ * below c - l * t. Subtrees are only pruned when this bound is strictly
+ * greater than a cost already reached, so they never contain the result
+ * (or anything tied with it), and the result is the same as without
+ * pruning.
+ */
+class LookaheadSearch {
+ public:
+  explicit LookaheadSearch(const PathHandler &path)
+      : path_(path), best_cost_(UINT_MAX) {}
+
+  CostedOperations search(
+      SearchForest &forest, unsigned lookahead,
+      OperationList &row_operations) {
+    forest.add_row_globally(
+        row_operations.back().first, row_operations.back().second);
+    CostedOperations costed_operations =
+        search_after_row(forest, lookahead, row_operations);
+    forest.undo_row_globally();
+    return costed_operations;
+  }
+
+  static bool is_pruned(const CostedOperations &costed_operations) {
+    return costed_operations.second.empty();
+  }
+
+ private:
+  const PathHandler &path_;
+  std::atomic<unsigned> best_cost_;
+
+  CostedOperations search_after_row(
+      SearchForest &forest, unsigned lookahead,
+      OperationList &row_operations) {
+    if ((lookahead == 0) || (forest.empty())) {
+      return reached(forest.global_cost, row_operations);
+    }
+    unsigned index = forest.max_tree_cost();
+    OperationList operations_available =
+        forest.operations_available_under_the_index(path_, index);
+    if (operations_available.empty()) {
+      return reached(forest.global_cost, row_operations);
+    }
+    const long long lower_bound =
+        (long long)forest.global_cost -
+        (long long)lookahead * forest.n_trees();
+    if (lower_bound > (long long)best_cost_.load()) {
+      return pruned();
+    }
+
+    CostedOperations costed_operations = pruned();
+    for (const Operation &op : operations_available) {
+      row_operations.push_back(op);
+      CostedOperations candidate_operations =
+          search(forest, lookahead - 1, row_operations);
+      row_operations.pop_back();
+      if (is_better(candidate_operations, costed_operations)) {
+        costed_operations = std::move(candidate_operations);
+      }
+    }
+    return costed_operations;
+  }
+
+  CostedOperations reached(
+      unsigned cost, const OperationList &row_operations) {
+    unsigned best = best_cost_.load();
+    while (cost < best && !best_cost_.compare_exchange_weak(best, cost)) {
+    }
+    return {cost, row_operations};
+  }
+
+  // Worse than any reachable result.
+  static CostedOperations pruned() { return {UINT_MAX, {}}; }
+};
+
+}  // namespace
+
 CostedOperations best_operations_lookahead(
-    const PathHandler &path, const SteinerForest &forest, unsigned lookahead) {
+    const PathHandler &path, const SteinerForest &forest, unsigned lookahead,
+    unsigned max_number_of_threads) {
   if (lookahead == 0) {
     throw std::logic_error("Must look ahead at least one step");
   }
@@ -193,78 +378,64 @@ CostedOperations best_operations_lookahead(
     throw std::logic_error("Forest is empty");
   }
 
-  OperationList operations_available =
+  OperationList operation_list =
       forest.operations_available_at_min_costs(path);
 
-  if (operations_available.empty()) {
+  if (operation_list.empty()) {
     throw std::logic_error("Cannot find any operations");
   }
+  const std::vector<Operation> operations_available(
+      operation_list.begin(), operation_list.end());
 
-  // set up base case
-  OperationList ops{operations_available.front()};
-  CostedOperations costed_operations =
-      recursive_operation_search(path, forest, lookahead - 1, ops);
-  operations_available.pop_front();
-
-  for (OperationList::iterator op_iter = operations_available.begin();
-       op_iter != operations_available.end(); ++op_iter) {
-    ops = {*op_iter};
-    CostedOperations candidate_operations =
-        recursive_operation_search(path, forest, lookahead - 1, ops);
-
-    if ((candidate_operations.first < costed_operations.first) ||
-        ((candidate_operations.first == costed_operations.first) &&
-         (candidate_operations.second.size() <
-          costed_operations.second.size()))) {
-      costed_operations = std::move(candidate_operations);
-    }
+  // With no lookahead beyond the first operation, each subtree is a single
+  // step and not worth a thread.
+  if (lookahead <= 1) {
+    max_number_of_threads = 1;
   }
+  const unsigned number_of_threads = get_number_of_threads(
+      operations_available.size(), max_number_of_threads);
+
+  // Each first operation roots a subtree of the search. The subtrees are
+  // searched as tasks on the thread pool, and their results go to
+  // per-subtree slots which are compared in order afterwards, so the
+  // result does not depend on the number of threads.
+  const SearchForest root_forest(forest);
+  LookaheadSearch lookahead_search(path);
+  std::vector<CostedOperations> results(operations_available.size());
+  std::vector<std::optional<SearchForest>> search_forests(number_of_threads);
+  parallel_for(
+      operations_available.size(), number_of_threads,
+      [&](std::size_t i, unsigned thread_index) {
+        std::optional<SearchForest> &search_forest =
+            search_forests[thread_index];
+        if (!search_forest) search_forest.emplace(root_forest);
+        try {
+          OperationList ops{operations_available[i]};
+          results[i] =
+              lookahead_search.search(*search_forest, lookahead - 1, ops);
+        } catch (...) {
+          // The search may not have been undone.
+          search_forest.reset();
+          throw;
+        }
+      });
 
+  CostedOperations costed_operations = results.front();
+  for (std::size_t i = 1; i < results.size(); ++i) {
+    if (is_better(results[i], costed_operations)) {
+      costed_operations = std::move(results[i]);
+    }
+  }
+  TKET_ASSERT(!LookaheadSearch::is_pruned(costed_operations));
   return costed_operations;
 }
 
 CostedOperations recursive_operation_search(
     const PathHandler &path, SteinerForest forest, unsigned lookahead,
     OperationList row_operations) {
-  CostedOperations costed_operations;
-  CostedOperations candidate_operations;
-
-  forest.add_row_globally(
-      row_operations.back().first, row_operations.back().second);
-
-  if ((lookahead == 0) || (forest.current_trees.empty())) {
-    return {forest.global_cost, row_operations};
-  }
-  CostedTrees::const_reverse_iterator r_iter = forest.current_trees.rbegin();
-  unsigned index = r_iter->first;
-  OperationList operations_available =
-      forest.operations_available_under_the_index(path, index);
-  if (operations_available.empty()) {
-    return {forest.global_cost, row_operations};
-  } else {
-    row_operations.push_back(operations_available.front());
-    costed_operations =
-        recursive_operation_search(path, forest, lookahead - 1, row_operations);
-    row_operations.pop_back();
-    operations_available.pop_front();
-
-    for (OperationList::iterator op_iter = operations_available.begin();
-         op_iter != operations_available.end(); ++op_iter) {
-      row_operations.push_back(*op_iter);
-      candidate_operations = recursive_operation_search(
-          path, forest, lookahead - 1, row_operations);
-
-      row_operations.pop_back();
-
-      if ((candidate_operations.first < costed_operations.first) ||
-          ((candidate_operations.first == costed_operations.first) &&
-           (candidate_operations.second.size() <
-            costed_operations.second.size()))) {
-        costed_operations = std::move(candidate_operations);
-      }
-    }
-    return costed_operations;
-  }
+  SearchForest search_forest(forest);
+  LookaheadSearch lookahead_search(path);
+  return lookahead_search.search(search_forest, lookahead, row_operations);
 }
 
 Circuit phase_poly_synthesis_int(
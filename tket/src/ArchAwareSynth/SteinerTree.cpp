@@ -338,10 +338,13 @@ OperationList SteinerTree::operations_available(
   return operations;
 }
 
-void SteinerTree::add_row(unsigned i, unsigned j) {
+SteinerRowChange SteinerTree::add_row(unsigned i, unsigned j) {
   /* CNOT with control j and target i */
   SteinerNodeType i_type = node_types[i];
   SteinerNodeType j_type = node_types[j];
+  const SteinerRowChange change{
+      i, j, i_type, j_type, num_neighbours[i], num_neighbours[j],
+      last_operation_cost};
 
   last_operation_cost = cost_of_operation(i, j);
   tree_cost += last_operation_cost;
@@ -428,33 +431,36 @@ void SteinerTree::add_row(unsigned i, unsigned j) {
       TKET_ASSERT(!"Invalid combination of nodes types in add row operation");
     }
   }
+  return change;
 }
 
-bool SteinerTree::fully_reduced() const { return tree_cost == 0; }
-
-static std::pair<unsigned, std::vector<unsigned>> steiner_reduce(
-    Circuit& circ, DiagMatrix& CNOT_matrix, const PathHandler& paths,
-    unsigned col, unsigned root, std::list<unsigned>& nodes, bool upper,
-    CNotSynthType cnottype) {
-  std::pair<unsigned, std::vector<unsigned>> result;
-
-  PathHandler directed_paths;
+void SteinerTree::undo_row(const SteinerRowChange& change) {
+  tree_cost -= last_operation_cost;
+  node_types[change.i] = change.i_type;
+  node_types[change.j] = change.j_type;
+  num_neighbours[change.i] = change.i_neighbours;
+  num_neighbours[change.j] = change.j_neighbours;
+  last_operation_cost = change.last_operation_cost;
+}
 
-  std::list<unsigned> fresh_node_list(nodes);
+bool SteinerTree::fully_reduced() const { return tree_cost == 0; }
 
-  if (upper) {
-    MatrixXb directed_connectivity = paths.get_connectivity_matrix();
-    for (unsigned i = 0; i < directed_connectivity.rows(); ++i) {
-      for (unsigned j = 0; j < directed_connectivity.cols(); ++j) {
-        if (i < root) directed_connectivity(i, j) = 0;
-        if (j < root) directed_connectivity(i, j) = 0;
-      }
+const PathHandler& SteinerCache::get_upper_paths(unsigned root) {
+  MatrixXb directed_connectivity = paths_.get_connectivity_matrix();
+  for (unsigned i = 0; i < directed_connectivity.rows(); ++i) {
+    for (unsigned j = 0; j < directed_connectivity.cols(); ++j) {
+      if (i < root) directed_connectivity(i, j) = 0;
+      if (j < root) directed_connectivity(i, j) = 0;
     }
+  }
+  upper_paths_ = PathHandler(directed_connectivity);
+  return upper_paths_;
+}
 
-    directed_paths = PathHandler(directed_connectivity);
-  } else {
-    MatrixXb directed_connectivity = paths.get_connectivity_matrix();
-    if (cnottype == CNotSynthType::HamPath) {
+const PathHandler& SteinerCache::get_lower_paths() {
+  if (!lower_paths_) {
+    MatrixXb directed_connectivity = paths_.get_connectivity_matrix();
+    if (cnottype_ == CNotSynthType::HamPath) {
       for (unsigned i = 0; i < directed_connectivity.rows(); ++i) {
         for (unsigned j = 0; j < directed_connectivity.cols(); ++j) {
           if (j > i) directed_connectivity(i, j) = 0;
@@ -462,10 +468,41 @@ static std::pair<unsigned, std::vector<unsigned>> steiner_reduce(
         }
       }
     }
+    lower_paths_ = PathHandler(directed_connectivity);
+  }
+  return *lower_paths_;
+}
 
-    directed_paths = PathHandler(directed_connectivity);
+const SteinerTree& SteinerCache::get_tree(
+    const PathHandler& paths, unsigned root,
+    const std::list<unsigned>& nodes) {
+  const bool reusable =
+      reuse_trees_ &&
+      (&paths == &paths_ || (lower_paths_ && &paths == &*lower_paths_));
+  if (!reusable) {
+    std::list<unsigned> fresh_node_list(nodes);
+    scratch_tree_ = SteinerTree(paths, fresh_node_list, root);
+    return scratch_tree_;
   }
-  SteinerTree cnot_tree = SteinerTree(directed_paths, fresh_node_list, root);
+  TreeKey key{&paths, root, nodes};
+  auto found = trees_.find(key);
+  if (found != trees_.end()) {
+    ++n_hits_;
+    return found->second;
+  }
+  std::list<unsigned> fresh_node_list(nodes);
+  SteinerTree tree(paths, fresh_node_list, root);
+  return trees_.insert({std::move(key), std::move(tree)}).first->second;
+}
+
+static std::pair<unsigned, std::vector<unsigned>> steiner_reduce(
+    Circuit& circ, DiagMatrix& CNOT_matrix, SteinerCache& cache, unsigned col,
+    unsigned root, std::list<unsigned>& nodes, bool upper) {
+  std::pair<unsigned, std::vector<unsigned>> result;
+
+  const PathHandler& directed_paths =
+      upper ? cache.get_upper_paths(root) : cache.get_lower_paths();
+  const SteinerTree& cnot_tree = cache.get_tree(directed_paths, root, nodes);
 
   // make list of edges, starting from root to leaves of tree
   std::list<std::pair<unsigned, unsigned>> parent_child_list;
@@ -535,13 +572,12 @@ static std::pair<unsigned, std::vector<unsigned>> steiner_reduce(
 }
 
 static std::pair<unsigned, std::vector<unsigned>> steiner_reduce_rec(
-    Circuit& circ, DiagMatrix& CNOT_matrix, const PathHandler& paths,
-    unsigned col, unsigned root, std::list<unsigned>& nodes) {
+    Circuit& circ, DiagMatrix& CNOT_matrix, SteinerCache& cache, unsigned col,
+    unsigned root, std::list<unsigned>& nodes) {
   std::pair<unsigned, std::vector<unsigned>> result;
 
-  std::list<unsigned> fresh_node_list(nodes);
-
-  SteinerTree cnot_tree = SteinerTree(paths, fresh_node_list, root);
+  const PathHandler& paths = cache.get_paths();
+  const SteinerTree& cnot_tree = cache.get_tree(paths, root, nodes);
 
   // make list of edges, starting from root to leaves of tree
   std::list<std::pair<unsigned, unsigned>> parent_child_list;
@@ -587,8 +623,8 @@ static std::pair<unsigned, std::vector<unsigned>> steiner_reduce_rec(
   return result;
 }
 
-void aas_cnot_synth_rec(
-    DiagMatrix& CNOT_matrix, const PathHandler& paths,
+static void aas_cnot_synth_rec(
+    DiagMatrix& CNOT_matrix, SteinerCache& cache,
     std::vector<unsigned>& pivot_cols, Circuit& cnot_circuit,
     std::vector<unsigned> usablenodes = {}) {
   // order usable nodes from highest to lowest element, the list should already
@@ -610,14 +646,14 @@ void aas_cnot_synth_rec(
     if (!nodes.empty()) {
       nodes.push_back(current_row);
       std::pair<unsigned, std::vector<unsigned>> res = steiner_reduce_rec(
-          cnot_circuit, CNOT_matrix, paths, pivot, current_row, nodes);
+          cnot_circuit, CNOT_matrix, cache, pivot, current_row, nodes);
       max_node_in_tree = res.first;
       new_usable_nodes = res.second;
     }
 
     if (max_node_in_tree > current_row) {
       aas_cnot_synth_rec(
-          CNOT_matrix, paths, pivot_cols, cnot_circuit, new_usable_nodes);
+          CNOT_matrix, cache, pivot_cols, cnot_circuit, new_usable_nodes);
     }
   }
 }
@@ -626,6 +662,13 @@ void aas_cnot_synth_rec(
 // for more information.
 Circuit aas_CNOT_synth(
     DiagMatrix& CNOT_matrix, const PathHandler& paths, CNotSynthType cnottype) {
+  SteinerCache cache(paths, cnottype);
+  return aas_CNOT_synth(CNOT_matrix, cache);
+}
+
+Circuit aas_CNOT_synth(DiagMatrix& CNOT_matrix, SteinerCache& cache) {
+  const PathHandler& paths = cache.get_paths();
+  const CNotSynthType cnottype = cache.get_cnottype();
   unsigned pivot = 0;
   unsigned max_node_in_tree = 0;
   std::vector<unsigned> usable_nodes(paths.get_size());
@@ -661,8 +704,7 @@ Circuit aas_CNOT_synth(
 
     if (row_not_in_notes) nodes.push_front(current_row);
     std::pair<unsigned, std::vector<unsigned>> res = steiner_reduce(
-        cnot_circuit, CNOT_matrix, paths, pivot, current_row, nodes, true,
-        cnottype);
+        cnot_circuit, CNOT_matrix, cache, pivot, current_row, nodes, true);
 
     max_node_in_tree = res.first;
     usable_nodes = res.second;
@@ -684,8 +726,8 @@ Circuit aas_CNOT_synth(
         nodes.push_back(current_row);
 
         std::pair<unsigned, std::vector<unsigned>> res = steiner_reduce(
-            cnot_circuit, CNOT_matrix, paths, pivot, current_row, nodes, false,
-            cnottype);
+            cnot_circuit, CNOT_matrix, cache, pivot, current_row, nodes,
+            false);
 
         max_node_in_tree = res.first;
         usable_nodes = res.second;
@@ -697,7 +739,7 @@ Circuit aas_CNOT_synth(
 
     if ((max_node_in_tree > current_row) && (cnottype == CNotSynthType::Rec)) {
       aas_cnot_synth_rec(
-          CNOT_matrix, paths, pivot_cols, cnot_circuit, usable_nodes);
+          CNOT_matrix, cache, pivot_cols, cnot_circuit, usable_nodes);
     }
 
     --current_row;
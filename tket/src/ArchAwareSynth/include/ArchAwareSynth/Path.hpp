@@ -70,19 +70,19 @@ class PathHandler {
    * get connectivity_matrix_ of the pathhandler
    * @return connectivity_matrix_
    */
-  MatrixXb get_connectivity_matrix() const;
+  const MatrixXb &get_connectivity_matrix() const;
 
   /**
    * get distance_matrix_ of the pathhandler
    * @return distance_matrix_
    */
-  MatrixXu get_distance_matrix() const;
+  const MatrixXu &get_distance_matrix() const;
 
   /**
    * get path_matrix_ of the pathhandler
    * @return path_matrix_
    */
-  MatrixXu get_path_matrix() const;
+  const MatrixXu &get_path_matrix() const;
 
   /**
    * get size of the pathhandler
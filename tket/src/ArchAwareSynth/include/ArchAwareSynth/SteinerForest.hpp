@@ -104,13 +104,19 @@ class SteinerForest {
 };
 
 /**
- * searches for the best operation in the given forest
+ * searches for the best operation in the given forest. The subtrees of the
+ * search starting from each available operation are explored in parallel,
+ * sharing the best cost found so far to prune subtrees which cannot beat
+ * it; the result does not depend on the number of threads.
  * @param path pathhandler used for the calculation
  * @param forest steinerforest used for the calculation
  * @param lookahead maximum steps of recursion used for the iteration
+ * @param max_number_of_threads largest number of threads to use; zero means
+ * get_default_number_of_threads()
  */
 CostedOperations best_operations_lookahead(
-    const PathHandler &path, const SteinerForest &forest, unsigned lookahead);
+    const PathHandler &path, const SteinerForest &forest, unsigned lookahead,
+    unsigned max_number_of_threads = 0);
 
 /**
  * searches for the best operation in the given forest with operation which are
@@ -13,6 +13,10 @@
 // limitations under the License.
 
 #pragma once
+#include <map>
+#include <optional>
+#include <tuple>
+
 #include "Converters/Gauss.hpp"
 #include "Path.hpp"
 
@@ -49,6 +53,20 @@ class InvalidRowOperation : public std::logic_error {
       : std::logic_error(message) {}
 };
 
+/**
+ * What a row operation on a SteinerTree overwrote: the two nodes it may
+ * change and the previous last_operation_cost. Enough to undo it.
+ */
+struct SteinerRowChange {
+  unsigned i;
+  unsigned j;
+  SteinerNodeType i_type;
+  SteinerNodeType j_type;
+  unsigned i_neighbours;
+  unsigned j_neighbours;
+  int last_operation_cost;
+};
+
 /**
  * This clas is creating a steiner tree, which is a mst including all the nodes
  * of a given phase gadget plus all the nodes which are neede to connect all the
@@ -115,11 +133,20 @@ class SteinerTree {
   OperationList operations_available(const PathHandler &pathhandler) const;
 
   /**
-   * Implements a CNOT from node j to node i, updates costs and tree
+   * Implements a CNOT from node j to node i, updates costs and tree. Only
+   * the two nodes and the cost are updated, in constant time.
    * @param i control index
    * @param j target index
+   * @return the overwritten state, for undo_row
+   */
+  SteinerRowChange add_row(unsigned i, unsigned j);
+
+  /**
+   * Undoes a row operation, which must be the last one applied to the tree
+   * that has not been undone
+   * @param change the result of add_row for the operation
    */
-  void add_row(unsigned i, unsigned j);
+  void undo_row(const SteinerRowChange &change);
 
   /**
    * checks is the tree is fully reduced
@@ -190,6 +217,74 @@ class CNotSwapSynth {
   std::stack<std::pair<unsigned, unsigned>> swaps;
 };
 
+/**
+ * Steiner trees and path handlers built during one run of aas_CNOT_synth.
+ *
+ * The path handler for the lower triangle, whose construction finds all
+ * shortest paths, is the same for every row, so it is built once. A Steiner
+ * tree on it or on the full path handler only depends on its root and
+ * terminals, and the recursive synthesis can ask for the same tree again,
+ * so these trees are kept. In the upper triangle each root is only reduced
+ * once, with a path handler of its own, so neither is kept.
+ */
+class SteinerCache {
+ public:
+  /**
+   * @param paths pathhandler used for the reduction, which must outlive
+   * the cache
+   * @param cnottype type of algorithm which could be CNotSynthType::Rec or
+   * CNotSynthType::HamPath
+   * @param reuse_trees whether to keep trees for later requests; if false,
+   * every request builds a new tree
+   */
+  SteinerCache(
+      const PathHandler &paths, CNotSynthType cnottype,
+      bool reuse_trees = true)
+      : paths_(paths),
+        cnottype_(cnottype),
+        reuse_trees_(reuse_trees),
+        n_hits_(0) {}
+
+  CNotSynthType get_cnottype() const { return cnottype_; }
+
+  /** The full path handler, used by the recursive reduction */
+  const PathHandler &get_paths() const { return paths_; }
+
+  /**
+   * Path handler restricted to the nodes from `root` upwards, for the upper
+   * triangle. Valid until the next call.
+   */
+  const PathHandler &get_upper_paths(unsigned root);
+
+  /** Path handler for the lower triangle */
+  const PathHandler &get_lower_paths();
+
+  /**
+   * Steiner tree on `paths` with the given root and terminals. Trees on
+   * get_paths() and get_lower_paths() are reused if requested again; others
+   * are valid until the next call.
+   */
+  const SteinerTree &get_tree(
+      const PathHandler &paths, unsigned root,
+      const std::list<unsigned> &nodes);
+
+  /** Number of requests for a tree which was reused */
+  unsigned n_hits() const { return n_hits_; }
+
+ private:
+  typedef std::tuple<const PathHandler *, unsigned, std::list<unsigned>>
+      TreeKey;
+
+  const PathHandler &paths_;
+  CNotSynthType cnottype_;
+  bool reuse_trees_;
+  unsigned n_hits_;
+  PathHandler upper_paths_;
+  std::optional<PathHandler> lower_paths_;
+  std::map<TreeKey, SteinerTree> trees_;
+  SteinerTree scratch_tree_;
+};
+
 /**
  * This method uses Kissinger & de Meijer's Steiner-Gauss
  * (https://arxiv.org/abs/1904.00633), and reduces the CNOT_matrix, which is
@@ -205,6 +300,15 @@ Circuit aas_CNOT_synth(
     DiagMatrix &CNOT_matrix, const PathHandler &paths,
     CNotSynthType cnottype = CNotSynthType::Rec);
 
+/**
+ * aas_CNOT_synth with the path handler and algorithm of `cache`, taking
+ * Steiner trees from it
+ * @param CNOT_matrix input of executed cnots which should be reduced
+ * @param cache Steiner trees and path handlers for this run
+ * @return routed circuit
+ */
+Circuit aas_CNOT_synth(DiagMatrix &CNOT_matrix, SteinerCache &cache);
+
 /**
  * this method offers the swap bases cnot synth
  * @param CNOT_matrix input of executed cnots which should be reduced
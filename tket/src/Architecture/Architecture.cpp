@@ -101,10 +101,19 @@ std::set<Node> Architecture::get_articulation_points() const {
   return ret;
 }
 
-static bool lexicographical_comparison(
-    const std::vector<size_t>& dist1, const std::vector<size_t>& dist2) {
-  return std::lexicographical_compare(
-      dist1.begin(), dist1.end(), dist2.begin(), dist2.end());
+// 1 if dist1 is lexicographically smaller than dist2, -1 if dist1 is a
+// prefix of dist2, 0 otherwise.
+template <typename Distances>
+static int tri_lexicographical_comparison_impl(
+    const Distances& dist1, const Distances& dist2) {
+  for (std::size_t i = 0; i < dist1.size(); ++i) {
+    if (i == dist2.size() || dist2[i] < dist1[i]) {
+      return 0;
+    } else if (dist1[i] < dist2[i]) {
+      return 1;
+    }
+  }
+  return -1;
 }
 
 std::optional<Node> Architecture::find_worst_node(
@@ -121,24 +130,19 @@ std::optional<Node> Architecture::find_worst_node(
     return std::nullopt;
   }
 
-  std::vector<size_t> worst_distances, temp_distances;
   Node worst_node = *bad_nodes.begin();
-  worst_distances = get_distances(worst_node);
+  graphs::DistanceRow worst_distances = get_distances(worst_node);
   for (Node temp_node : bad_nodes) {
-    temp_distances = get_distances(temp_node);
+    const graphs::DistanceRow temp_distances = get_distances(temp_node);
 
     int distance_comp =
-        tri_lexicographical_comparison(temp_distances, worst_distances);
+        tri_lexicographical_comparison_impl(temp_distances, worst_distances);
     if (distance_comp == 1) {
       worst_node = temp_node;
       worst_distances = temp_distances;
     } else if (distance_comp == -1) {
-      std::vector<size_t> temp_distances_full =
-          original_arch.get_distances(temp_node);
-      std::vector<size_t> worst_distances_full =
-          original_arch.get_distances(worst_node);
-      if (lexicographical_comparison(
-              temp_distances_full, worst_distances_full)) {
+      if (original_arch.get_distances(temp_node) <
+          original_arch.get_distances(worst_node)) {
         worst_node = temp_node;
         worst_distances = temp_distances;
       }
@@ -163,20 +167,7 @@ node_set_t Architecture::remove_worst_nodes(unsigned num) {
 int tri_lexicographical_comparison(
     const std::vector<std::size_t>& dist1,
     const std::vector<std::size_t>& dist2) {
-  // add assertion that these are the same size distance vectors
-  auto start_dist1 = dist1.cbegin();
-  auto start_dist2 = dist2.cbegin();
-
-  while (start_dist1 != dist1.cend()) {
-    if (start_dist2 == dist2.cend() || *start_dist2 < *start_dist1) {
-      return 0;
-    } else if (*start_dist1 < *start_dist2) {
-      return 1;
-    }
-    ++start_dist1;
-    ++start_dist2;
-  }
-  return -1;
+  return tri_lexicographical_comparison_impl(dist1, dist2);
 }
 
 MatrixXb Architecture::get_connectivity() const {
@@ -422,7 +422,9 @@ ProjectorAssertionBox::ProjectorAssertionBox(
 }
 
 ProjectorAssertionBox::ProjectorAssertionBox(const ProjectorAssertionBox &other)
-    : Box(other), m_(other.m_), expected_readouts_(other.expected_readouts_) {}
+    : Box(other),
+      m_(other.m_),
+      expected_readouts_(other.get_expected_readouts()) {}
 
 Op_ptr ProjectorAssertionBox::dagger() const {
   return std::make_shared<ProjectorAssertionBox>(m_.adjoint());
@@ -459,7 +461,7 @@ StabiliserAssertionBox::StabiliserAssertionBox(
     const StabiliserAssertionBox &other)
     : Box(other),
       paulis_(other.paulis_),
-      expected_readouts_(other.expected_readouts_) {}
+      expected_readouts_(other.get_expected_readouts()) {}
 
 Op_ptr StabiliserAssertionBox::dagger() const {
   return std::make_shared<StabiliserAssertionBox>(paulis_);
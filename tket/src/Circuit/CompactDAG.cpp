@@ -0,0 +1,228 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CompactDAG.hpp"
+
+#include <tkassert/Assert.hpp>
+#include <unordered_map>
+
+#include "Circuit.hpp"
+
+namespace tket {
+
+CompactDAG::CompactDAG(const Circuit &circ, VertexVec *vertex_map)
+    : CompactDAG(circ.dag, vertex_map) {}
+
+CompactDAG::CompactDAG(const DAG &dag, VertexVec *vertex_map)
+    : n_vertices_(0), n_edges_(0) {
+  VertexVec order;
+  order.reserve(boost::num_vertices(dag));
+  BGL_FORALL_VERTICES(v, dag, DAG) { order.push_back(v); }
+  add_dag(dag, order);
+  if (vertex_map) {
+    *vertex_map = std::move(order);
+  }
+}
+
+CompactDAG::CompactDAG(const DAG &dag, const VertexVec &order)
+    : n_vertices_(0), n_edges_(0) {
+  TKET_ASSERT(order.size() == boost::num_vertices(dag));
+  add_dag(dag, order);
+}
+
+void CompactDAG::add_dag(const DAG &dag, const VertexVec &order) {
+  vertices_.reserve(vertices_.size() + order.size());
+  edges_.reserve(edges_.size() + boost::num_edges(dag));
+  std::unordered_map<Vertex, VertexIndex> index;
+  index.reserve(order.size());
+  for (const Vertex &v : order) {
+    index[v] = add_vertex(dag[v]);
+  }
+  for (const Vertex &v : order) {
+    const VertexIndex source = index.at(v);
+    // (The member functions hide the boost free functions here).
+    auto [ei, ei_end] = boost::out_edges(v, dag);
+    for (; ei != ei_end; ++ei) {
+      const EdgeProperties &props = dag[*ei];
+      add_edge(
+          source, props.ports.first, index.at(boost::target(*ei, dag)),
+          props.ports.second, props.type);
+    }
+  }
+}
+
+CompactDAG::EdgeIndex CompactDAG::get_nth_in_edge(
+    VertexIndex v, port_t port) const {
+  for (EdgeIndex e : vertices_[v].in_edges) {
+    if (get_target_port(e) == port) return e;
+  }
+  return null_index;
+}
+
+CompactDAG::EdgeIndex CompactDAG::get_nth_out_edge(
+    VertexIndex v, port_t port) const {
+  for (EdgeIndex e : vertices_[v].out_edges) {
+    if (get_source_port(e) == port && get_edgetype(e) != EdgeType::Boolean) {
+      return e;
+    }
+  }
+  return null_index;
+}
+
+CompactDAG::VertexIndex CompactDAG::add_vertex(
+    const VertexProperties &properties) {
+  ++n_vertices_;
+  if (!free_vertices_.empty()) {
+    const VertexIndex v = free_vertices_.back();
+    free_vertices_.pop_back();
+    VertexRecord &record = vertices_[v];
+    record.properties = properties;
+    record.exists = true;
+    return v;
+  }
+  vertices_.push_back({properties, {}, {}, true});
+  return vertices_.size() - 1;
+}
+
+CompactDAG::EdgeIndex CompactDAG::add_edge(
+    VertexIndex source, port_t source_port, VertexIndex target,
+    port_t target_port, EdgeType type) {
+  TKET_ASSERT(vertex_exists(source) && vertex_exists(target));
+  const EdgeRecord record{
+      source, target, {type, {source_port, target_port}}, true};
+  EdgeIndex e;
+  if (!free_edges_.empty()) {
+    e = free_edges_.back();
+    free_edges_.pop_back();
+    edges_[e] = record;
+  } else {
+    e = edges_.size();
+    edges_.push_back(record);
+  }
+  vertices_[source].out_edges.push_back(e);
+  vertices_[target].in_edges.push_back(e);
+  ++n_edges_;
+  return e;
+}
+
+void CompactDAG::remove_edge(EdgeIndex e) {
+  TKET_ASSERT(edge_exists(e));
+  EdgeRecord &record = edges_[e];
+  vertices_[record.source].out_edges.erase(e);
+  vertices_[record.target].in_edges.erase(e);
+  record.exists = false;
+  free_edges_.push_back(e);
+  --n_edges_;
+}
+
+void CompactDAG::remove_vertex(VertexIndex v) {
+  TKET_ASSERT(vertex_exists(v));
+  VertexRecord &record = vertices_[v];
+  while (!record.in_edges.empty()) {
+    remove_edge(record.in_edges[0]);
+  }
+  while (!record.out_edges.empty()) {
+    remove_edge(record.out_edges[0]);
+  }
+  record.properties = VertexProperties();
+  record.in_edges.clear();
+  record.out_edges.clear();
+  record.exists = false;
+  free_vertices_.push_back(v);
+  --n_vertices_;
+}
+
+std::vector<CompactDAG::VertexIndex> CompactDAG::topological_order() const {
+  // Kahn's algorithm; the order vector doubles as the queue.
+  std::vector<unsigned> remaining_in(vertices_.size(), 0);
+  std::vector<VertexIndex> order;
+  order.reserve(n_vertices_);
+  for (VertexIndex v = 0; v < vertices_.size(); ++v) {
+    if (!vertices_[v].exists) continue;
+    remaining_in[v] = vertices_[v].in_edges.size();
+    if (remaining_in[v] == 0) order.push_back(v);
+  }
+  for (unsigned i = 0; i < order.size(); ++i) {
+    for (EdgeIndex e : vertices_[order[i]].out_edges) {
+      const VertexIndex t = edges_[e].target;
+      if (--remaining_in[t] == 0) order.push_back(t);
+    }
+  }
+  if (order.size() != n_vertices_) {
+    throw CircuitInvalidity("CompactDAG contains a cycle");
+  }
+  return order;
+}
+
+std::vector<CompactDAG::VertexIndex> CompactDAG::compact() {
+  const std::vector<VertexIndex> order = topological_order();
+  std::vector<VertexIndex> new_index(vertices_.size(), null_index);
+  for (unsigned i = 0; i < order.size(); ++i) {
+    new_index[order[i]] = i;
+  }
+  std::vector<VertexRecord> old_vertices;
+  std::vector<EdgeRecord> old_edges;
+  old_vertices.swap(vertices_);
+  old_edges.swap(edges_);
+  free_vertices_.clear();
+  free_edges_.clear();
+  n_vertices_ = 0;
+  n_edges_ = 0;
+  vertices_.reserve(order.size());
+  edges_.reserve(old_edges.size() - std::count_if(
+                                        old_edges.cbegin(), old_edges.cend(),
+                                        [](const EdgeRecord &record) {
+                                          return !record.exists;
+                                        }));
+  for (VertexIndex old_v : order) {
+    add_vertex(old_vertices[old_v].properties);
+  }
+  for (VertexIndex old_v : order) {
+    for (EdgeIndex old_e : old_vertices[old_v].out_edges) {
+      const EdgeRecord &record = old_edges[old_e];
+      add_edge(
+          new_index[old_v], record.properties.ports.first,
+          new_index[record.target], record.properties.ports.second,
+          record.properties.type);
+    }
+  }
+  return order;
+}
+
+DAG CompactDAG::to_dag(VertexVec *vertex_map) const {
+  DAG dag;
+  VertexVec new_vertices(
+      vertices_.size(), boost::graph_traits<DAG>::null_vertex());
+  for (VertexIndex v = 0; v < vertices_.size(); ++v) {
+    if (vertices_[v].exists) {
+      new_vertices[v] = boost::add_vertex(dag);
+      dag[new_vertices[v]] = vertices_[v].properties;
+    }
+  }
+  for (const EdgeRecord &record : edges_) {
+    if (record.exists) {
+      const Edge e = boost::add_edge(
+                         new_vertices[record.source],
+                         new_vertices[record.target], dag)
+                         .first;
+      dag[e] = record.properties;
+    }
+  }
+  if (vertex_map) {
+    *vertex_map = std::move(new_vertices);
+  }
+  return dag;
+}
+
+}  // namespace tket
@@ -18,6 +18,7 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <memory>
+#include <mutex>
 
 #include "OpType/OpTypeInfo.hpp"
 #include "Ops/Op.hpp"
@@ -44,7 +45,7 @@ class Box : public Op {
   Box(const Box &other)
       : Op(other.get_type()),
         signature_(other.signature_),
-        circ_(other.circ_),
+        circ_(other.to_circuit_if_generated()),
         id_(other.id_) {}
 
   /** Number of Quantum inputs */
@@ -62,8 +63,14 @@ class Box : public Op {
 
   static Op_ptr deserialize(const nlohmann::json &j);
 
-  /** Circuit represented by box */
+  /**
+   * Circuit represented by box
+   *
+   * The circuit is generated on first use. Boxes are shared between copies of
+   * a circuit, so generation is guarded by a per-box mutex.
+   */
   std::shared_ptr<Circuit> to_circuit() const {
+    std::lock_guard<std::mutex> lock(circ_mutex_);
     if (circ_ == nullptr) generate_circuit();
     return circ_;
   };
@@ -77,11 +84,18 @@ class Box : public Op {
  protected:
   static boost::uuids::uuid idgen() {
     static boost::uuids::random_generator gen = {};
-
+    static std::mutex gen_mutex;
+    std::lock_guard<std::mutex> lock(gen_mutex);
     return gen();
   }
+  /** The circuit, if it has already been generated */
+  std::shared_ptr<Circuit> to_circuit_if_generated() const {
+    std::lock_guard<std::mutex> lock(circ_mutex_);
+    return circ_;
+  }
   op_signature_t signature_;
   mutable std::shared_ptr<Circuit> circ_;
+  mutable std::mutex circ_mutex_;
   boost::uuids::uuid id_;
 
   virtual void generate_circuit() const = 0;
@@ -629,7 +643,10 @@ class ProjectorAssertionBox : public Box {
 
   /** Get the unitary matrix correspnding to this operation */
   Eigen::MatrixXcd get_matrix() const { return m_; }
-  std::vector<bool> get_expected_readouts() const { return expected_readouts_; }
+  std::vector<bool> get_expected_readouts() const {
+    std::lock_guard<std::mutex> lock(circ_mutex_);
+    return expected_readouts_;
+  }
 
   Op_ptr dagger() const override;
 
@@ -685,7 +702,10 @@ class StabiliserAssertionBox : public Box {
 
   /** Get the pauli stabilisers */
   PauliStabiliserList get_stabilisers() const { return paulis_; }
-  std::vector<bool> get_expected_readouts() const { return expected_readouts_; }
+  std::vector<bool> get_expected_readouts() const {
+    std::lock_guard<std::mutex> lock(circ_mutex_);
+    return expected_readouts_;
+  }
 
   Op_ptr dagger() const override;
 
@@ -1140,7 +1140,7 @@ class Circuit {
    * This is the number of vertices in the longest path through the DAG,
    * excluding boundary vertices and vertices representing barriers.
    *
-   * O(D qlog^2(q!) alpha log(alpha!))
+   * O(V + E): a single pass over a topological order of the DAG.
    *
    * @return depth
    */
@@ -1591,6 +1591,14 @@ class Circuit {
 
   /** Signature associated with each named operation group */
   std::map<std::string, op_signature_t> opgroupsigs;
+
+  /**
+   * Number of vertices in the longest path through the DAG, excluding
+   * boundary vertices and vertices for which skip_func returns true.
+   *
+   * Computed in a single pass over a topological order of the DAG.
+   */
+  unsigned depth_excluding(const std::function<bool(Op_ptr)> &skip_func) const;
 };
 
 JSON_DECL(Circuit)
@@ -0,0 +1,292 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+#include "DAGDefs.hpp"
+
+namespace tket {
+
+class Circuit;
+
+/**
+ * A short list of indices, stored inline while it is small and only
+ * spilling onto the heap when it grows beyond N elements.
+ *
+ * Almost every vertex in a circuit has at most a handful of ports, so the
+ * edge lists of a vertex almost always sit in the vertex record itself.
+ */
+template <unsigned N>
+class InlineIndexVector {
+ public:
+  InlineIndexVector() : size_(0) {}
+
+  unsigned size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const unsigned *begin() const { return data(); }
+  const unsigned *end() const { return data() + size_; }
+  unsigned operator[](unsigned i) const { return data()[i]; }
+
+  void push_back(unsigned value) {
+    if (size_ < N) {
+      inline_[size_] = value;
+    } else {
+      if (size_ == N) {
+        heap_.assign(inline_.cbegin(), inline_.cend());
+      }
+      heap_.push_back(value);
+    }
+    ++size_;
+  }
+
+  /** Remove the first occurrence of the value, if present,
+   *  preserving the order of the other elements. */
+  void erase(unsigned value) {
+    unsigned *ptr = data();
+    for (unsigned i = 0; i < size_; ++i) {
+      if (ptr[i] != value) continue;
+      for (unsigned j = i + 1; j < size_; ++j) {
+        ptr[j - 1] = ptr[j];
+      }
+      --size_;
+      if (size_ > N) {
+        heap_.pop_back();
+      } else if (size_ == N) {
+        std::copy(heap_.cbegin(), heap_.cbegin() + N, inline_.begin());
+        heap_.clear();
+      }
+      return;
+    }
+  }
+
+  void clear() {
+    size_ = 0;
+    heap_.clear();
+  }
+
+ private:
+  unsigned size_;
+  std::array<unsigned, N> inline_;
+  std::vector<unsigned> heap_;
+
+  const unsigned *data() const {
+    return size_ > N ? heap_.data() : inline_.data();
+  }
+  unsigned *data() { return size_ > N ? heap_.data() : inline_.data(); }
+};
+
+/**
+ * A compact, index-addressed alternative to the boost adjacency_list
+ * representation of a circuit (@ref DAG).
+ *
+ * Vertices and edges live in two flat vectors and are referred to by their
+ * index in these, so traversals touch contiguous memory instead of chasing
+ * a separate heap node for every vertex and edge. The in- and out-edge lists
+ * of each vertex are stored inline (see @ref InlineIndexVector).
+ * Removed vertices and edges leave a hole which is recorded on a free list
+ * and reused by the next insertion, so indices of the remaining elements are
+ * never invalidated; @ref compact removes the holes (renumbering everything).
+ *
+ * A CompactDAG can be built on demand from a @ref Circuit, as a snapshot
+ * which is independent of the circuit thereafter. Whole-graph traversals
+ * such as @ref Circuit::depth build one numbered in topological order.
+ */
+class CompactDAG {
+ public:
+  typedef unsigned VertexIndex;
+  typedef unsigned EdgeIndex;
+
+  static constexpr unsigned null_index = std::numeric_limits<unsigned>::max();
+
+  /** Number of edges of each vertex which are stored inline. */
+  static constexpr unsigned inline_ports = 4;
+  typedef InlineIndexVector<inline_ports> EdgeList;
+
+  CompactDAG() : n_vertices_(0), n_edges_(0) {}
+
+  /**
+   * Snapshot of the DAG of a circuit (including the boundary vertices).
+   *
+   * @param circ circuit to copy
+   * @param vertex_map if not null, filled with the original vertex
+   *    corresponding to each vertex index of the new graph
+   */
+  explicit CompactDAG(const Circuit &circ, VertexVec *vertex_map = nullptr);
+
+  /** Snapshot of a DAG, as for the Circuit constructor. */
+  explicit CompactDAG(const DAG &dag, VertexVec *vertex_map = nullptr);
+
+  /**
+   * Snapshot of a DAG, with the vertices numbered in a given order.
+   *
+   * If the order is topological, a forward traversal of the snapshot is
+   * then simply a loop over the vertex indices.
+   *
+   * @param dag graph to copy
+   * @param order every vertex of the graph exactly once; vertex index i of
+   *    the snapshot corresponds to order[i]
+   */
+  CompactDAG(const DAG &dag, const VertexVec &order);
+
+  /** Number of vertices currently present */
+  unsigned n_vertices() const { return n_vertices_; }
+
+  /** Number of edges currently present */
+  unsigned n_edges() const { return n_edges_; }
+
+  /**
+   * One more than the largest vertex index in use.
+   *
+   * Vertex indices range over [0, vertex_capacity()), but some of these may
+   * be holes; check with @ref vertex_exists.
+   */
+  unsigned vertex_capacity() const { return vertices_.size(); }
+
+  /** One more than the largest edge index in use. */
+  unsigned edge_capacity() const { return edges_.size(); }
+
+  bool vertex_exists(VertexIndex v) const {
+    return v < vertices_.size() && vertices_[v].exists;
+  }
+  bool edge_exists(EdgeIndex e) const {
+    return e < edges_.size() && edges_[e].exists;
+  }
+
+  const VertexProperties &operator[](VertexIndex v) const {
+    return vertices_[v].properties;
+  }
+  VertexProperties &operator[](VertexIndex v) {
+    return vertices_[v].properties;
+  }
+  const EdgeProperties &get_edge_properties(EdgeIndex e) const {
+    return edges_[e].properties;
+  }
+
+  Op_ptr get_op(VertexIndex v) const { return vertices_[v].properties.op; }
+  OpType get_optype(VertexIndex v) const {
+    return vertices_[v].properties.op->get_type();
+  }
+
+  VertexIndex source(EdgeIndex e) const { return edges_[e].source; }
+  VertexIndex target(EdgeIndex e) const { return edges_[e].target; }
+  port_t get_source_port(EdgeIndex e) const {
+    return edges_[e].properties.ports.first;
+  }
+  port_t get_target_port(EdgeIndex e) const {
+    return edges_[e].properties.ports.second;
+  }
+  EdgeType get_edgetype(EdgeIndex e) const { return edges_[e].properties.type; }
+
+  /** In-edges of a vertex, in order of insertion */
+  const EdgeList &in_edges(VertexIndex v) const {
+    return vertices_[v].in_edges;
+  }
+
+  /** Out-edges of a vertex, in order of insertion */
+  const EdgeList &out_edges(VertexIndex v) const {
+    return vertices_[v].out_edges;
+  }
+
+  unsigned in_degree(VertexIndex v) const {
+    return vertices_[v].in_edges.size();
+  }
+  unsigned out_degree(VertexIndex v) const {
+    return vertices_[v].out_edges.size();
+  }
+
+  /**
+   * The unique in-edge of a vertex on the given port.
+   *
+   * @return the edge, or @ref null_index if there is none
+   */
+  EdgeIndex get_nth_in_edge(VertexIndex v, port_t port) const;
+
+  /**
+   * The non-Boolean out-edge of a vertex on the given port.
+   *
+   * @return the edge, or @ref null_index if there is none
+   */
+  EdgeIndex get_nth_out_edge(VertexIndex v, port_t port) const;
+
+  /** Add a vertex, reusing a free slot if there is one. */
+  VertexIndex add_vertex(const VertexProperties &properties);
+
+  /** Add an edge, reusing a free slot if there is one. */
+  EdgeIndex add_edge(
+      VertexIndex source, port_t source_port, VertexIndex target,
+      port_t target_port, EdgeType type);
+
+  void remove_edge(EdgeIndex e);
+
+  /** Remove a vertex, together with all its incident edges. */
+  void remove_vertex(VertexIndex v);
+
+  /**
+   * All vertices, in a topological order.
+   *
+   * The order is deterministic: it depends only on the vertex and edge
+   * indices.
+   *
+   * @throws CircuitInvalidity if the graph has a cycle
+   */
+  std::vector<VertexIndex> topological_order() const;
+
+  /**
+   * Remove all holes left by deleted elements, renumbering the vertices
+   * in topological order and the edges in order of their source vertices,
+   * so that a forward traversal accesses memory sequentially.
+   *
+   * @return the old index of each new vertex index
+   */
+  std::vector<VertexIndex> compact();
+
+  /**
+   * Convert to a boost DAG.
+   *
+   * @param vertex_map if not null, filled with the new vertex corresponding
+   *    to each vertex index (@ref null_index holes map to null vertices)
+   */
+  DAG to_dag(VertexVec *vertex_map = nullptr) const;
+
+ private:
+  struct VertexRecord {
+    VertexProperties properties;
+    EdgeList in_edges;
+    EdgeList out_edges;
+    bool exists;
+  };
+  struct EdgeRecord {
+    VertexIndex source;
+    VertexIndex target;
+    EdgeProperties properties;
+    bool exists;
+  };
+
+  void add_dag(const DAG &dag, const VertexVec &order);
+
+  std::vector<VertexRecord> vertices_;
+  std::vector<EdgeRecord> edges_;
+  std::vector<VertexIndex> free_vertices_;
+  std::vector<EdgeIndex> free_edges_;
+  unsigned n_vertices_;
+  unsigned n_edges_;
+};
+
+}  // namespace tket
@@ -16,9 +16,13 @@
 // ALL METHODS TO OBTAIN COMPLEX GRAPH INFORMATIION//
 ////////////////////////////////////////////////////
 
+#include <boost/property_map/property_map.hpp>
+#include <limits>
 #include <tklog/TketLog.hpp>
+#include <unordered_map>
 
 #include "Circuit.hpp"
+#include "CompactDAG.hpp"
 #include "OpType/OpType.hpp"
 #include "Ops/OpPtr.hpp"
 #include "Utils/GraphHeaders.hpp"
@@ -620,48 +624,60 @@ SliceVec Circuit::get_reverse_slices() const {
 }
 
 unsigned Circuit::depth() const {
-  unsigned count = 0;
-  std::function<bool(Op_ptr)> skip_func = [&](Op_ptr op) {
-    return (op->get_type() == OpType::Barrier);
-  };
-  Circuit::SliceIterator slice_iter(*this, skip_func);
-  if (!(*slice_iter).empty()) count++;
-  while (!slice_iter.finished()) {
-    slice_iter.cut_ = this->next_cut(
-        slice_iter.cut_.u_frontier, slice_iter.cut_.b_frontier, skip_func);
-    if (!(*slice_iter).empty()) count++;
-  }
-  return count;
+  return depth_excluding(
+      [](Op_ptr op) { return op->get_type() == OpType::Barrier; });
 }
 
 unsigned Circuit::depth_by_type(OpType _type) const {
-  unsigned count = 0;
-  std::function<bool(Op_ptr)> skip_func = [&](Op_ptr op) {
-    return (op->get_type() != _type);
-  };
-  Circuit::SliceIterator slice_iter(*this, skip_func);
-  if (!(*slice_iter).empty()) count++;
-  while (!slice_iter.finished()) {
-    slice_iter.cut_ = this->next_cut(
-        slice_iter.cut_.u_frontier, slice_iter.cut_.b_frontier, skip_func);
-    if (!(*slice_iter).empty()) count++;
-  }
-  return count;
+  return depth_excluding([&](Op_ptr op) { return op->get_type() != _type; });
 }
 
 unsigned Circuit::depth_by_types(const OpTypeSet& _types) const {
-  unsigned count = 0;
-  std::function<bool(Op_ptr)> skip_func = [&](Op_ptr op) {
-    return (_types.find(op->get_type()) == _types.end());
-  };
-  Circuit::SliceIterator slice_iter(*this, skip_func);
-  if (!(*slice_iter).empty()) count++;
-  while (!slice_iter.finished()) {
-    slice_iter.cut_ = this->next_cut(
-        slice_iter.cut_.u_frontier, slice_iter.cut_.b_frontier, skip_func);
-    if (!(*slice_iter).empty()) count++;
+  return depth_excluding(
+      [&](Op_ptr op) { return _types.find(op->get_type()) == _types.end(); });
+}
+
+unsigned Circuit::depth_excluding(
+    const std::function<bool(Op_ptr)>& skip_func) const {
+  // The layer of each vertex, i.e. the number of counted vertices on the
+  // longest path ending there; vertices not reachable from the inputs
+  // (which can never appear in a slice) are marked as unreachable.
+  // The compact graph is numbered in topological order, so every in-edge
+  // comes from a vertex whose layer is already known.
+  static constexpr unsigned unreachable = std::numeric_limits<unsigned>::max();
+  // Use an external colour map, so as not to depend on the vertex indices.
+  std::unordered_map<Vertex, boost::default_color_type> colours;
+  colours.reserve(boost::num_vertices(dag));
+  VertexVec order;
+  order.reserve(boost::num_vertices(dag));
+  boost::topological_sort(
+      dag, std::back_inserter(order),
+      boost::color_map(boost::make_assoc_property_map(colours)));
+  std::reverse(order.begin(), order.end());
+  const CompactDAG graph(dag, order);
+  std::vector<unsigned> layer(graph.n_vertices(), unreachable);
+  unsigned depth = 0;
+  for (CompactDAG::VertexIndex i = 0; i < graph.n_vertices(); ++i) {
+    const Vertex v = order[i];
+    if (detect_initial_Op(v)) {
+      layer[i] = 0;
+      continue;
+    }
+    unsigned max_in_layer = unreachable;
+    for (CompactDAG::EdgeIndex e : graph.in_edges(i)) {
+      const unsigned in_layer = layer[graph.source(e)];
+      if (in_layer == unreachable) continue;
+      if (max_in_layer == unreachable || in_layer > max_in_layer) {
+        max_in_layer = in_layer;
+      }
+    }
+    if (max_in_layer == unreachable) continue;
+    layer[i] = max_in_layer;
+    if (detect_final_Op(v) || skip_func(get_Op_ptr_from_Vertex(v))) continue;
+    ++layer[i];
+    depth = std::max(depth, layer[i]);
   }
-  return count;
+  return depth;
 }
 
 std::map<Vertex, unit_set_t> Circuit::vertex_unit_map() const {
@@ -14,6 +14,7 @@
 
 #include "CliffTableau.hpp"
 
+#include <bit>
 #include <stdexcept>
 
 #include "OpType/OpType.hpp"
@@ -23,49 +24,33 @@
 
 namespace tket {
 
-const std::map<
-    std::pair<CliffTableau::BoolPauli, CliffTableau::BoolPauli>,
-    std::pair<CliffTableau::BoolPauli, Complex>>
-    CliffTableau::mult_lut = {
-        // {{{x1,z1},{x2,z2}}, {{x,z},ph}}
-        {{{false, false}, {false, false}}, {{false, false}, 1.}},
-        {{{false, false}, {false, true}}, {{false, true}, 1.}},
-        {{{false, false}, {true, false}}, {{true, false}, 1.}},
-        {{{false, false}, {true, true}}, {{true, true}, 1.}},
-        {{{false, true}, {false, false}}, {{false, true}, 1.}},
-        {{{false, true}, {false, true}}, {{false, false}, 1.}},
-        {{{false, true}, {true, false}}, {{true, true}, i_}},
-        {{{false, true}, {true, true}}, {{true, false}, -i_}},
-        {{{true, false}, {false, false}}, {{true, false}, 1.}},
-        {{{true, false}, {false, true}}, {{true, true}, -i_}},
-        {{{true, false}, {true, false}}, {{false, false}, 1.}},
-        {{{true, false}, {true, true}}, {{false, true}, i_}},
-        {{{true, true}, {false, false}}, {{true, true}, 1.}},
-        {{{true, true}, {false, true}}, {{true, false}, i_}},
-        {{{true, true}, {true, false}}, {{false, true}, -i_}},
-        {{{true, true}, {true, true}}, {{false, false}, 1.}}};
-
-CliffTableau::CliffTableau(unsigned n) : size_(n) {
-  xpauli_x = MatrixXb::Identity(n, n);
-  xpauli_z = MatrixXb::Zero(n, n);
-  xpauli_phase = VectorXb::Zero(n);
-  zpauli_x = MatrixXb::Zero(n, n);
-  zpauli_z = MatrixXb::Identity(n, n);
-  zpauli_phase = VectorXb::Zero(n);
+// Rows of the identity tableau: the A-channel of each output depends only
+// on the A-channel of the same input
+static PackedPauliRows identity_rows(unsigned n, bool x) {
+  PackedPauliRows rows(n, n);
   for (unsigned i = 0; i < n; i++) {
-    qubits_.insert({Qubit(q_default_reg(), i), i});
+    if (x) {
+      rows.set_x(i, i, true);
+    } else {
+      rows.set_z(i, i, true);
+    }
   }
+  return rows;
 }
 
-CliffTableau::CliffTableau(const qubit_vector_t &qbs) : size_(qbs.size()) {
-  const unsigned n = size_;
-  xpauli_x = MatrixXb::Identity(n, n);
-  xpauli_z = MatrixXb::Zero(n, n);
-  xpauli_phase = VectorXb::Zero(n);
-  zpauli_x = MatrixXb::Zero(n, n);
-  zpauli_z = MatrixXb::Identity(n, n);
-  zpauli_phase = VectorXb::Zero(n);
+CliffTableau::CliffTableau(unsigned n)
+    : size_(n),
+      xpauli(identity_rows(n, true)),
+      zpauli(identity_rows(n, false)) {
+  for (unsigned i = 0; i < n; i++) {
+    qubits_.insert({Qubit(q_default_reg(), i), i});
+  }
+}
 
+CliffTableau::CliffTableau(const qubit_vector_t &qbs)
+    : size_(qbs.size()),
+      xpauli(identity_rows(size_, true)),
+      zpauli(identity_rows(size_, false)) {
   unsigned i = 0;
   for (const Qubit &q : qbs) {
     qubits_.insert({q, i});
@@ -75,23 +60,22 @@ CliffTableau::CliffTableau(const qubit_vector_t &qbs) : size_(qbs.size()) {
 
 static QubitPauliTensor get_pauli(
     const Qubit &qb, const boost::bimap<Qubit, unsigned> &qubits_,
-    const MatrixXb &pauli_x, const MatrixXb &pauli_z,
-    const VectorXb &pauli_phase) {
+    const PackedPauliRows &rows) {
   unsigned uqb = qubits_.left.at(qb);
   Complex phase = 1.;
-  if (pauli_phase(uqb)) phase = -1.;
+  if (rows.get_phase(uqb)) phase = -1.;
   QubitPauliTensor res(phase);
   for (boost::bimap<Qubit, unsigned>::const_iterator iter = qubits_.begin(),
                                                      iend = qubits_.end();
        iter != iend; ++iter) {
     unsigned origin = iter->right;
-    if (pauli_x(uqb, origin)) {
-      if (pauli_z(uqb, origin)) {
+    if (rows.get_x(uqb, origin)) {
+      if (rows.get_z(uqb, origin)) {
         res = res * QubitPauliTensor(iter->left, Pauli::Y);
       } else {
         res = res * QubitPauliTensor(iter->left, Pauli::X);
       }
-    } else if (pauli_z(uqb, origin)) {
+    } else if (rows.get_z(uqb, origin)) {
       res = res * QubitPauliTensor(iter->left, Pauli::Z);
     }
   }
@@ -99,11 +83,11 @@ static QubitPauliTensor get_pauli(
 }
 
 QubitPauliTensor CliffTableau::get_zpauli(const Qubit &qb) const {
-  return get_pauli(qb, qubits_, zpauli_x, zpauli_z, zpauli_phase);
+  return get_pauli(qb, qubits_, zpauli);
 }
 
 QubitPauliTensor CliffTableau::get_xpauli(const Qubit &qb) const {
-  return get_pauli(qb, qubits_, xpauli_x, xpauli_z, xpauli_phase);
+  return get_pauli(qb, qubits_, xpauli);
 }
 
 std::set<Qubit> CliffTableau::get_qubits() const {
@@ -116,96 +100,34 @@ std::set<Qubit> CliffTableau::get_qubits() const {
   return result;
 }
 
-void CliffTableau::row_mult(
-    const MatrixXb::RowXpr &xa, const MatrixXb::RowXpr &za, const bool &pa,
-    const MatrixXb::RowXpr &xb, const MatrixXb::RowXpr &zb, const bool &pb,
-    Complex phase, MatrixXb::RowXpr &xw, MatrixXb::RowXpr &zw, bool &pw) {
-  if (pa) phase *= -1;
-  if (pb) phase *= -1;
-  for (unsigned i = 0; i < size_; i++) {
-    std::pair<BoolPauli, Complex> res =
-        mult_lut.at({{xa(i), za(i)}, {xb(i), zb(i)}});
-    xw(i) = res.first.x;
-    zw(i) = res.first.z;
-    phase *= res.second;
-  }
-  pw = (phase == -1.);
-}
-
-void CliffTableau::col_mult(
-    const MatrixXb::ColXpr &a, const MatrixXb::ColXpr &b, bool flip,
-    MatrixXb::ColXpr &w, VectorXb &pw) {
-  for (unsigned i = 0; i < size_; i++) {
-    pw(i) = pw(i) ^ (a(i) && (b(i) ^ flip));
-    w(i) = a(i) ^ b(i);
-  }
-}
-
 void CliffTableau::apply_S_at_front(unsigned qb) {
-  MatrixXb::ColXpr xx = xpauli_x.col(qb);
-  MatrixXb::ColXpr xz = xpauli_z.col(qb);
-  MatrixXb::ColXpr zx = zpauli_x.col(qb);
-  MatrixXb::ColXpr zz = zpauli_z.col(qb);
-  col_mult(xx, xz, true, xz, xpauli_phase);
-  col_mult(zx, zz, true, zz, zpauli_phase);
+  xpauli.apply_S(qb);
+  zpauli.apply_S(qb);
 }
 
 void CliffTableau::apply_S_at_end(unsigned qb) {
-  MatrixXb::RowXpr xx = xpauli_x.row(qb);
-  MatrixXb::RowXpr xz = xpauli_z.row(qb);
-  MatrixXb::RowXpr zx = zpauli_x.row(qb);
-  MatrixXb::RowXpr zz = zpauli_z.row(qb);
-  row_mult(
-      zx, zz, zpauli_phase(qb), xx, xz, xpauli_phase(qb), i_, xx, xz,
-      xpauli_phase(qb));
+  PackedPauliRows::row_mult(zpauli, qb, xpauli, qb, i_, xpauli, qb);
 }
 
 void CliffTableau::apply_V_at_front(unsigned qb) {
-  MatrixXb::ColXpr xx = xpauli_x.col(qb);
-  MatrixXb::ColXpr xz = xpauli_z.col(qb);
-  MatrixXb::ColXpr zx = zpauli_x.col(qb);
-  MatrixXb::ColXpr zz = zpauli_z.col(qb);
-  col_mult(xx, xz, false, xx, xpauli_phase);
-  col_mult(zx, zz, false, zx, zpauli_phase);
+  xpauli.apply_V(qb);
+  zpauli.apply_V(qb);
 }
 
 void CliffTableau::apply_V_at_end(unsigned qb) {
-  MatrixXb::RowXpr xx = xpauli_x.row(qb);
-  MatrixXb::RowXpr xz = xpauli_z.row(qb);
-  MatrixXb::RowXpr zx = zpauli_x.row(qb);
-  MatrixXb::RowXpr zz = zpauli_z.row(qb);
-  row_mult(
-      xx, xz, xpauli_phase(qb), zx, zz, zpauli_phase(qb), i_, zx, zz,
-      zpauli_phase(qb));
+  PackedPauliRows::row_mult(xpauli, qb, zpauli, qb, i_, zpauli, qb);
 }
 
 void CliffTableau::apply_CX_at_front(unsigned control, unsigned target) {
-  for (unsigned i = 0; i < size_; i++) {
-    xpauli_phase(i) =
-        xpauli_phase(i) ^ (xpauli_x(i, control) && xpauli_z(i, target) &&
-                           !(xpauli_x(i, target) ^ xpauli_z(i, control)));
-    xpauli_x(i, target) = xpauli_x(i, control) ^ xpauli_x(i, target);
-    xpauli_z(i, control) = xpauli_z(i, control) ^ xpauli_z(i, target);
-    zpauli_phase(i) =
-        zpauli_phase(i) ^ (zpauli_x(i, control) && zpauli_z(i, target) &&
-                           !(zpauli_x(i, target) ^ zpauli_z(i, control)));
-    zpauli_x(i, target) = zpauli_x(i, control) ^ zpauli_x(i, target);
-    zpauli_z(i, control) = zpauli_z(i, control) ^ zpauli_z(i, target);
-  }
+  xpauli.apply_CX(control, target);
+  zpauli.apply_CX(control, target);
 }
 
 void CliffTableau::apply_CX_at_end(unsigned control, unsigned target) {
-  MatrixXb::RowXpr xxc = xpauli_x.row(control);
-  MatrixXb::RowXpr xzc = xpauli_z.row(control);
-  MatrixXb::RowXpr zxt = zpauli_x.row(target);
-  MatrixXb::RowXpr zzt = zpauli_z.row(target);
-  row_mult(
-      xxc, xzc, xpauli_phase(control), xpauli_x.row(target),
-      xpauli_z.row(target), xpauli_phase(target), 1., xxc, xzc,
-      xpauli_phase(control));
-  row_mult(
-      zpauli_x.row(control), zpauli_z.row(control), zpauli_phase(control), zxt,
-      zzt, zpauli_phase(target), 1., zxt, zzt, zpauli_phase(target));
+  PackedPauliRows::row_mult(
+      xpauli, control, xpauli, target, 1., xpauli, control);
+  PackedPauliRows::row_mult(
+      zpauli, control, zpauli, target, 1., zpauli, target);
 }
 
 void CliffTableau::apply_gate_at_front(
@@ -404,12 +326,8 @@ void CliffTableau::apply_pauli_at_front(
   pauli_tab.qubits_ = this->qubits_;
   pauli_tab.apply_pauli_at_end(pauli, half_pis);
   CliffTableau product = CliffTableau::compose(pauli_tab, *this);
-  this->xpauli_x = product.xpauli_x;
-  this->xpauli_z = product.xpauli_z;
-  this->xpauli_phase = product.xpauli_phase;
-  this->zpauli_x = product.zpauli_x;
-  this->zpauli_z = product.zpauli_z;
-  this->zpauli_phase = product.zpauli_phase;
+  this->xpauli = product.xpauli;
+  this->zpauli = product.zpauli;
 }
 
 void CliffTableau::apply_pauli_at_end(
@@ -441,15 +359,12 @@ void CliffTableau::apply_pauli_at_end(
 
   // From here, half_pis == 1 or 3
   // They act the same except for a phase flip on the product term
-  MatrixXb product_x = MatrixXb::Zero(1, size_);
-  MatrixXb product_z = MatrixXb::Zero(1, size_);
-  MatrixXb::RowXpr px = product_x.row(0);
-  MatrixXb::RowXpr pz = product_z.row(0);
   if (pauli.coeff != 1. && pauli.coeff != -1.)
     throw std::invalid_argument(
         "Can only apply Paulis with real unit coefficients to "
         "CliffTableaus");
-  bool phase = (pauli.coeff == -1.) ^ (half_pis == 3);
+  PackedPauliRows product(1, size_);
+  product.set_phase(0, (pauli.coeff == -1.) ^ (half_pis == 3));
 
   // Collect the product term
   for (const std::pair<const Qubit, Pauli> &term : pauli.string.map) {
@@ -459,24 +374,16 @@ void CliffTableau::apply_pauli_at_end(
         break;
       }
       case Pauli::X: {
-        row_mult(
-            xpauli_x.row(uqb), xpauli_z.row(uqb), xpauli_phase(uqb), px, pz,
-            phase, 1., px, pz, phase);
+        PackedPauliRows::row_mult(xpauli, uqb, product, 0, 1., product, 0);
         break;
       }
       case Pauli::Y: {
-        row_mult(
-            zpauli_x.row(uqb), zpauli_z.row(uqb), zpauli_phase(uqb), px, pz,
-            phase, 1., px, pz, phase);
-        row_mult(
-            xpauli_x.row(uqb), xpauli_z.row(uqb), xpauli_phase(uqb), px, pz,
-            phase, i_, px, pz, phase);
+        PackedPauliRows::row_mult(zpauli, uqb, product, 0, 1., product, 0);
+        PackedPauliRows::row_mult(xpauli, uqb, product, 0, i_, product, 0);
         break;
       }
       case Pauli::Z: {
-        row_mult(
-            zpauli_x.row(uqb), zpauli_z.row(uqb), zpauli_phase(uqb), px, pz,
-            phase, 1., px, pz, phase);
+        PackedPauliRows::row_mult(zpauli, uqb, product, 0, 1., product, 0);
         break;
       }
     }
@@ -485,33 +392,21 @@ void CliffTableau::apply_pauli_at_end(
   // Apply the product term on the anti-commuting rows
   for (const std::pair<const Qubit, Pauli> &term : pauli.string.map) {
     unsigned uqb = qubits_.left.at(term.first);
-    MatrixXb::RowXpr xx = xpauli_x.row(uqb);
-    MatrixXb::RowXpr xz = xpauli_z.row(uqb);
-    MatrixXb::RowXpr zx = zpauli_x.row(uqb);
-    MatrixXb::RowXpr zz = zpauli_z.row(uqb);
     switch (term.second) {
       case Pauli::I: {
         break;
       }
       case Pauli::X: {
-        row_mult(
-            px, pz, phase, zx, zz, zpauli_phase(uqb), i_, zx, zz,
-            zpauli_phase(uqb));
+        PackedPauliRows::row_mult(product, 0, zpauli, uqb, i_, zpauli, uqb);
         break;
       }
       case Pauli::Y: {
-        row_mult(
-            px, pz, phase, zx, zz, zpauli_phase(uqb), i_, zx, zz,
-            zpauli_phase(uqb));
-        row_mult(
-            px, pz, phase, xx, xz, xpauli_phase(uqb), i_, xx, xz,
-            xpauli_phase(uqb));
+        PackedPauliRows::row_mult(product, 0, zpauli, uqb, i_, zpauli, uqb);
+        PackedPauliRows::row_mult(product, 0, xpauli, uqb, i_, xpauli, uqb);
         break;
       }
       case Pauli::Z: {
-        row_mult(
-            px, pz, phase, xx, xz, xpauli_phase(uqb), i_, xx, xz,
-            xpauli_phase(uqb));
+        PackedPauliRows::row_mult(product, 0, xpauli, uqb, i_, xpauli, uqb);
         break;
       }
     }
@@ -520,8 +415,9 @@ void CliffTableau::apply_pauli_at_end(
 
 std::ostream &operator<<(std::ostream &os, CliffTableau const &tab) {
   MatrixXb full(2 * tab.size_, 2 * tab.size_ + 1);
-  full << tab.xpauli_x, tab.xpauli_z, tab.xpauli_phase, tab.zpauli_x,
-      tab.zpauli_z, tab.zpauli_phase;
+  full << tab.xpauli.get_xmat(), tab.xpauli.get_zmat(),
+      tab.xpauli.get_phases(), tab.zpauli.get_xmat(), tab.zpauli.get_zmat(),
+      tab.zpauli.get_phases();
   os << full;
   return os;
 }
@@ -529,122 +425,103 @@ std::ostream &operator<<(std::ostream &os, CliffTableau const &tab) {
 bool CliffTableau::operator==(const CliffTableau &other) const {
   bool same = this->size_ == other.size_;
   same &= this->qubits_ == other.qubits_;
-  same &= this->xpauli_x == other.xpauli_x;
-  same &= this->xpauli_z == other.xpauli_z;
-  same &= this->xpauli_phase == other.xpauli_phase;
-  same &= this->zpauli_x == other.zpauli_x;
-  same &= this->zpauli_z == other.zpauli_z;
-  same &= this->zpauli_phase == other.zpauli_phase;
+  same &= this->xpauli == other.xpauli;
+  same &= this->zpauli == other.zpauli;
   return same;
 }
 
-static std::vector<Complex> cphase_from_tableau(
-    const MatrixXb &pauli_x, const MatrixXb &pauli_z,
-    const VectorXb &pauli_phase) {
+static std::vector<Complex> cphase_from_tableau(const PackedPauliRows &rows) {
   std::vector<Complex> cphase;
-  const unsigned n = pauli_phase.size();
+  const unsigned n = rows.get_n_rows();
   for (unsigned i = 0; i < n; i++) {
-    Complex cp = pauli_phase(i) ? -1. : 1.;
+    Complex cp = rows.get_phase(i) ? -1. : 1.;
     for (unsigned j = 0; j < n; j++) {
-      if (pauli_x(i, j) && pauli_z(i, j)) cp *= i_;
+      if (rows.get_x(i, j) && rows.get_z(i, j)) cp *= i_;
     }
     cphase.push_back(cp);
   }
   return cphase;
 }
 
+// Add row j of `from` into row i of `to` (ignoring phases), returning whether
+// this introduces a phase flip relative to the cphase bookkeeping
+static bool add_row(
+    const PackedPauliRows &from, unsigned j, PackedPauliRows &to, unsigned i) {
+  const std::uint64_t *fx = from.x_row(j);
+  const std::uint64_t *fz = from.z_row(j);
+  std::uint64_t *tx = to.x_row(i);
+  std::uint64_t *tz = to.z_row(i);
+  std::uint64_t flip = 0;
+  for (unsigned w = 0; w < to.get_n_words(); w++) {
+    flip ^= tz[w] & fx[w];
+    tx[w] ^= fx[w];
+    tz[w] ^= fz[w];
+  }
+  return std::popcount(flip) % 2 == 1;
+}
+
+// Fill row i of `result` with the product of the rows of `first` selected
+// by row i of `second`, returning the cphase the product should have
+static Complex compose_row(
+    const PackedPauliRows &first_x, const std::vector<Complex> &first_x_cphase,
+    const PackedPauliRows &first_z, const std::vector<Complex> &first_z_cphase,
+    const PackedPauliRows &second, const Complex &second_cphase, unsigned i,
+    PackedPauliRows &result) {
+  Complex cphase = second_cphase;
+  bool phase_flip = false;
+  const unsigned n = second.get_n_qubits();
+  for (unsigned j = 0; j < n; j++) {  // col in second
+    if (second.get_x(i, j)) {
+      phase_flip ^= add_row(first_x, j, result, i);
+      cphase *= first_x_cphase[j];
+    }
+    if (second.get_z(i, j)) {
+      phase_flip ^= add_row(first_z, j, result, i);
+      cphase *= first_z_cphase[j];
+    }
+  }
+  if (phase_flip) cphase *= -1.;
+  return cphase;
+}
+
 CliffTableau CliffTableau::compose(
     const CliffTableau &first, const CliffTableau &second) {
   if (first.qubits_ != second.qubits_)
     throw std::logic_error(
         "Cannot compose Clifford Tableaus with different qubit maps");
   const unsigned n = first.size_;
-  std::vector<Complex> first_x_cphase =
-      cphase_from_tableau(first.xpauli_x, first.xpauli_z, first.xpauli_phase);
-  std::vector<Complex> first_z_cphase =
-      cphase_from_tableau(first.zpauli_x, first.zpauli_z, first.zpauli_phase);
-  std::vector<Complex> second_x_cphase = cphase_from_tableau(
-      second.xpauli_x, second.xpauli_z, second.xpauli_phase);
-  std::vector<Complex> second_z_cphase = cphase_from_tableau(
-      second.zpauli_x, second.zpauli_z, second.zpauli_phase);
+  std::vector<Complex> first_x_cphase = cphase_from_tableau(first.xpauli);
+  std::vector<Complex> first_z_cphase = cphase_from_tableau(first.zpauli);
+  std::vector<Complex> second_x_cphase = cphase_from_tableau(second.xpauli);
+  std::vector<Complex> second_z_cphase = cphase_from_tableau(second.zpauli);
 
   CliffTableau result(n);
-  result.xpauli_x.setZero();
-  result.xpauli_z.setZero();
-  result.zpauli_x.setZero();
-  result.zpauli_z.setZero();
+  result.xpauli = PackedPauliRows(n, n);
+  result.zpauli = PackedPauliRows(n, n);
   result.qubits_ = first.qubits_;
 
   // Target cphases
   std::vector<Complex> xpauli_cphase(n);
   std::vector<Complex> zpauli_cphase(n);
 
-  // Calculate xpauli rows
   for (unsigned i = 0; i < n; i++) {  // row in second
-    // Sum rows from first according to second.xpauli
-    xpauli_cphase[i] = second_x_cphase[i];
-    bool phase_flip = false;
-    for (unsigned j = 0; j < n; j++) {  // col in second
-      if (second.xpauli_x(i, j)) {
-        // add first.xpauli to xpauli
-        for (unsigned k = 0; k < n; k++) {
-          phase_flip ^= result.xpauli_z(i, k) && first.xpauli_x(j, k);
-          result.xpauli_x(i, k) = result.xpauli_x(i, k) != first.xpauli_x(j, k);
-          result.xpauli_z(i, k) = result.xpauli_z(i, k) != first.xpauli_z(j, k);
-        }
-        xpauli_cphase[i] *= first_x_cphase[j];
-      }
-      if (second.xpauli_z(i, j)) {
-        // add first.zpauli to xpauli
-        for (unsigned k = 0; k < n; k++) {
-          phase_flip ^= result.xpauli_z(i, k) && first.zpauli_x(j, k);
-          result.xpauli_x(i, k) = result.xpauli_x(i, k) != first.zpauli_x(j, k);
-          result.xpauli_z(i, k) = result.xpauli_z(i, k) != first.zpauli_z(j, k);
-        }
-        xpauli_cphase[i] *= first_z_cphase[j];
-      }
-    }
-    if (phase_flip) xpauli_cphase[i] *= -1.;
-  }
-
-  // Calculate zpauli rows
-  for (unsigned i = 0; i < n; i++) {  // row in second
-    // Sum rows from first according to second.zpauli
-    zpauli_cphase[i] = second_z_cphase[i];
-    bool phase_flip = false;
-    for (unsigned j = 0; j < n; j++) {  // col in second
-      if (second.zpauli_x(i, j)) {
-        // add first.xpauli to zpauli
-        for (unsigned k = 0; k < n; k++) {
-          phase_flip ^= result.zpauli_z(i, k) && first.xpauli_x(j, k);
-          result.zpauli_x(i, k) = result.zpauli_x(i, k) != first.xpauli_x(j, k);
-          result.zpauli_z(i, k) = result.zpauli_z(i, k) != first.xpauli_z(j, k);
-        }
-        zpauli_cphase[i] *= first_x_cphase[j];
-      }
-      if (second.zpauli_z(i, j)) {
-        // add first.zpauli to zpauli
-        for (unsigned k = 0; k < n; k++) {
-          phase_flip ^= result.zpauli_z(i, k) && first.zpauli_x(j, k);
-          result.zpauli_x(i, k) = result.zpauli_x(i, k) != first.zpauli_x(j, k);
-          result.zpauli_z(i, k) = result.zpauli_z(i, k) != first.zpauli_z(j, k);
-        }
-        zpauli_cphase[i] *= first_z_cphase[j];
-      }
-    }
-    if (phase_flip) zpauli_cphase[i] *= -1.;
+    // Sum rows from first according to second.xpauli and second.zpauli
+    xpauli_cphase[i] = compose_row(
+        first.xpauli, first_x_cphase, first.zpauli, first_z_cphase,
+        second.xpauli, second_x_cphase[i], i, result.xpauli);
+    zpauli_cphase[i] = compose_row(
+        first.xpauli, first_x_cphase, first.zpauli, first_z_cphase,
+        second.zpauli, second_z_cphase[i], i, result.zpauli);
   }
 
-  std::vector<Complex> current_x_cphase = cphase_from_tableau(
-      result.xpauli_x, result.xpauli_z, result.xpauli_phase);
-  std::vector<Complex> current_z_cphase = cphase_from_tableau(
-      result.zpauli_x, result.zpauli_z, result.zpauli_phase);
+  std::vector<Complex> current_x_cphase = cphase_from_tableau(result.xpauli);
+  std::vector<Complex> current_z_cphase = cphase_from_tableau(result.zpauli);
 
   for (unsigned i = 0; i < n; i++) {
     TKET_ASSERT((current_x_cphase[i] * xpauli_cphase[i]).imag() == 0);
-    result.xpauli_phase(i) = (current_x_cphase[i] == -xpauli_cphase[i]);
+    result.xpauli.set_phase(i, current_x_cphase[i] == -xpauli_cphase[i]);
     TKET_ASSERT((current_z_cphase[i] * zpauli_cphase[i]).imag() == 0);
-    result.zpauli_phase(i) = (current_z_cphase[i] == -zpauli_cphase[i]);
+    result.zpauli.set_phase(i, current_z_cphase[i] == -zpauli_cphase[i]);
   }
 
   return result;
@@ -0,0 +1,171 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "PackedPauliRows.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <tkassert/Assert.hpp>
+
+#include "Utils/GF2Matrix.hpp"
+#include "Utils/SymplecticPauli.hpp"
+
+namespace tket {
+
+// The power k of a coefficient i^k
+static unsigned i_power(const Complex &coeff) {
+  if (coeff == 1.) return 0;
+  if (coeff == i_) return 1;
+  if (coeff == -1.) return 2;
+  TKET_ASSERT(coeff == -i_);
+  return 3;
+}
+
+PackedPauliRows::PackedPauliRows(unsigned n_rows, unsigned n_qubits)
+    : n_rows_(n_rows),
+      n_qubits_(n_qubits),
+      n_words_(symplectic::number_of_words(n_qubits)),
+      x_(n_rows * n_words_, 0),
+      z_(n_rows * n_words_, 0),
+      phase_(symplectic::number_of_words(n_rows), 0) {}
+
+PackedPauliRows::PackedPauliRows(
+    const MatrixXb &xmat, const MatrixXb &zmat, const VectorXb &phase)
+    : PackedPauliRows(xmat.rows(), xmat.cols()) {
+  TKET_ASSERT(zmat.rows() == xmat.rows() && zmat.cols() == xmat.cols());
+  TKET_ASSERT(phase.size() == xmat.rows());
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    for (unsigned q = 0; q < n_qubits_; ++q) {
+      set_x(r, q, xmat(r, q));
+      set_z(r, q, zmat(r, q));
+    }
+    set_phase(r, phase(r));
+  }
+}
+
+MatrixXb PackedPauliRows::get_xmat() const {
+  MatrixXb xmat(n_rows_, n_qubits_);
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    for (unsigned q = 0; q < n_qubits_; ++q) {
+      xmat(r, q) = get_x(r, q);
+    }
+  }
+  return xmat;
+}
+
+MatrixXb PackedPauliRows::get_zmat() const {
+  MatrixXb zmat(n_rows_, n_qubits_);
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    for (unsigned q = 0; q < n_qubits_; ++q) {
+      zmat(r, q) = get_z(r, q);
+    }
+  }
+  return zmat;
+}
+
+VectorXb PackedPauliRows::get_phases() const {
+  VectorXb phase(n_rows_);
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    phase(r) = get_phase(r);
+  }
+  return phase;
+}
+
+bool PackedPauliRows::operator==(const PackedPauliRows &other) const {
+  return n_rows_ == other.n_rows_ && n_qubits_ == other.n_qubits_ &&
+         x_ == other.x_ && z_ == other.z_ && phase_ == other.phase_;
+}
+
+void PackedPauliRows::row_mult(
+    const PackedPauliRows &a, unsigned ra, const PackedPauliRows &b,
+    unsigned rb, Complex coeff, PackedPauliRows &w, unsigned rw) {
+  TKET_ASSERT(a.n_qubits_ == b.n_qubits_ && a.n_qubits_ == w.n_qubits_);
+  unsigned power = i_power(coeff) + 2 * (a.get_phase(ra) + b.get_phase(rb));
+  power += symplectic::multiply(
+      a.x_row(ra), a.z_row(ra), b.x_row(rb), b.z_row(rb), w.x_row(rw),
+      w.z_row(rw), a.n_words_);
+  w.set_phase(rw, power % 4 == 2);
+}
+
+bool PackedPauliRows::anticommutes(
+    const PackedPauliRows &a, unsigned ra, const PackedPauliRows &b,
+    unsigned rb) {
+  TKET_ASSERT(a.n_qubits_ == b.n_qubits_);
+  return symplectic::anticommute(
+      a.x_row(ra), a.z_row(ra), b.x_row(rb), b.z_row(rb), a.n_words_);
+}
+
+bool PackedPauliRows::odd_y_count(unsigned r) const {
+  const std::uint64_t *x = x_row(r);
+  const std::uint64_t *z = z_row(r);
+  std::uint64_t y = 0;
+  for (unsigned i = 0; i < n_words_; ++i) {
+    y ^= x[i] & z[i];
+  }
+  return std::popcount(y) % 2 == 1;
+}
+
+void PackedPauliRows::apply_S(unsigned qb) {
+  const unsigned i = qb / 64;
+  const unsigned bit = qb % 64;
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    std::uint64_t &xw = x_[r * n_words_ + i];
+    std::uint64_t &zw = z_[r * n_words_ + i];
+    const bool x = (xw >> bit) & 1;
+    const bool z = (zw >> bit) & 1;
+    if (x && !z) phase_[r / 64] ^= std::uint64_t(1) << (r % 64);
+    zw ^= std::uint64_t(x) << bit;
+  }
+}
+
+void PackedPauliRows::apply_V(unsigned qb) {
+  const unsigned i = qb / 64;
+  const unsigned bit = qb % 64;
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    std::uint64_t &xw = x_[r * n_words_ + i];
+    std::uint64_t &zw = z_[r * n_words_ + i];
+    const bool x = (xw >> bit) & 1;
+    const bool z = (zw >> bit) & 1;
+    if (x && z) phase_[r / 64] ^= std::uint64_t(1) << (r % 64);
+    xw ^= std::uint64_t(z) << bit;
+  }
+}
+
+void PackedPauliRows::apply_CX(unsigned qc, unsigned qt) {
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    const bool xc = get_x(r, qc);
+    const bool zc = get_z(r, qc);
+    const bool xt = get_x(r, qt);
+    const bool zt = get_z(r, qt);
+    if (xc && zt && !(xt ^ zc)) {
+      phase_[r / 64] ^= std::uint64_t(1) << (r % 64);
+    }
+    set_x(r, qt, xc ^ xt);
+    set_z(r, qc, zc ^ zt);
+  }
+}
+
+unsigned PackedPauliRows::rank() const {
+  // Rows [x | z], with each half padded to whole words; the zero padding
+  // columns do not change the rank.
+  GF2Matrix mat(n_rows_, 2 * 64 * n_words_);
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    std::copy(x_row(r), x_row(r) + n_words_, mat.row(r));
+    std::copy(z_row(r), z_row(r) + n_words_, mat.row(r) + n_words_);
+  }
+  return mat.row_reduce().size();
+}
+
+}  // namespace tket
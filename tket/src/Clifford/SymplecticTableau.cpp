@@ -40,50 +40,28 @@ Pauli BoolPauli::to_pauli() const {
     return Pauli::I;
 }
 
-const std::map<std::pair<BoolPauli, BoolPauli>, std::pair<BoolPauli, Complex>>
-    BoolPauli::mult_lut = {
-        // {{{x1,z1},{x2,z2}}, {{x,z},ph}}
-        {{{false, false}, {false, false}}, {{false, false}, 1.}},
-        {{{false, false}, {false, true}}, {{false, true}, 1.}},
-        {{{false, false}, {true, false}}, {{true, false}, 1.}},
-        {{{false, false}, {true, true}}, {{true, true}, 1.}},
-        {{{false, true}, {false, false}}, {{false, true}, 1.}},
-        {{{false, true}, {false, true}}, {{false, false}, 1.}},
-        {{{false, true}, {true, false}}, {{true, true}, i_}},
-        {{{false, true}, {true, true}}, {{true, false}, -i_}},
-        {{{true, false}, {false, false}}, {{true, false}, 1.}},
-        {{{true, false}, {false, true}}, {{true, true}, -i_}},
-        {{{true, false}, {true, false}}, {{false, false}, 1.}},
-        {{{true, false}, {true, true}}, {{false, true}, i_}},
-        {{{true, true}, {false, false}}, {{true, true}, 1.}},
-        {{{true, true}, {false, true}}, {{true, false}, i_}},
-        {{{true, true}, {true, false}}, {{false, true}, -i_}},
-        {{{true, true}, {true, true}}, {{false, false}, 1.}}};
-
 SymplecticTableau::SymplecticTableau(
     const MatrixXb &xmat, const MatrixXb &zmat, const VectorXb &phase)
-    : n_rows_(xmat.rows()),
-      n_qubits_(xmat.cols()),
-      xmat_(xmat),
-      zmat_(zmat),
-      phase_(phase) {
-  if (zmat.rows() != n_rows_ || phase_.size() != n_rows_)
+    : n_rows_(xmat.rows()), n_qubits_(xmat.cols()) {
+  if (zmat.rows() != n_rows_ || phase.size() != n_rows_)
     throw std::invalid_argument(
         "Tableau must have the same number of rows in each component.");
   if (zmat.cols() != n_qubits_)
     throw std::invalid_argument(
         "Tableau must have the same number of columns in x and z components.");
+  rows_ = PackedPauliRows(xmat, zmat, phase);
 }
 
+SymplecticTableau::SymplecticTableau(const PackedPauliRows &rows)
+    : n_rows_(rows.get_n_rows()), n_qubits_(rows.get_n_qubits()), rows_(rows) {}
+
 SymplecticTableau::SymplecticTableau(const PauliStabiliserList &rows) {
   n_rows_ = rows.size();
   if (n_rows_ == 0)
     n_qubits_ = 0;
   else
     n_qubits_ = rows[0].string.size();
-  xmat_ = MatrixXb::Zero(n_rows_, n_qubits_);
-  zmat_ = MatrixXb::Zero(n_rows_, n_qubits_);
-  phase_ = VectorXb::Zero(n_rows_);
+  rows_ = PackedPauliRows(n_rows_, n_qubits_);
   for (unsigned i = 0; i < n_rows_; ++i) {
     const PauliStabiliser &stab = rows[i];
     if (stab.string.size() != n_qubits_)
@@ -91,10 +69,10 @@ SymplecticTableau::SymplecticTableau(const PauliStabiliserList &rows) {
           "Tableau must have the same number of qubits in each row.");
     for (unsigned q = 0; q < n_qubits_; ++q) {
       const Pauli &p = stab.string[q];
-      xmat_(i, q) = (p == Pauli::X) || (p == Pauli::Y);
-      zmat_(i, q) = (p == Pauli::Z) || (p == Pauli::Y);
+      rows_.set_x(i, q, (p == Pauli::X) || (p == Pauli::Y));
+      rows_.set_z(i, q, (p == Pauli::Z) || (p == Pauli::Y));
     }
-    phase_(i) = !stab.coeff;
+    rows_.set_phase(i, !stab.coeff);
   }
 }
 
@@ -104,14 +82,16 @@ unsigned SymplecticTableau::get_n_qubits() const { return n_qubits_; }
 PauliStabiliser SymplecticTableau::get_pauli(unsigned i) const {
   std::vector<Pauli> str(n_qubits_);
   for (unsigned q = 0; q < n_qubits_; ++q) {
-    str[q] = BoolPauli{xmat_(i, q), zmat_(i, q)}.to_pauli();
+    str[q] = BoolPauli{rows_.get_x(i, q), rows_.get_z(i, q)}.to_pauli();
   }
-  return PauliStabiliser(str, !phase_(i));
+  return PauliStabiliser(str, !rows_.get_phase(i));
 }
 
 std::ostream &operator<<(std::ostream &os, const SymplecticTableau &tab) {
+  const MatrixXb xmat = tab.get_xmat();
+  const MatrixXb zmat = tab.get_zmat();
   for (unsigned i = 0; i < tab.n_rows_; ++i) {
-    os << tab.xmat_.row(i) << " " << tab.zmat_.row(i) << " " << tab.phase_(i)
+    os << xmat.row(i) << " " << zmat.row(i) << " " << tab.rows_.get_phase(i)
        << std::endl;
   }
   return os;
@@ -120,39 +100,20 @@ std::ostream &operator<<(std::ostream &os, const SymplecticTableau &tab) {
 bool SymplecticTableau::operator==(const SymplecticTableau &other) const {
   bool same = this->n_rows_ == other.n_rows_;
   same &= this->n_qubits_ == other.n_qubits_;
-  same &= this->xmat_ == other.xmat_;
-  same &= this->zmat_ == other.zmat_;
-  same &= this->phase_ == other.phase_;
+  same &= this->rows_ == other.rows_;
   return same;
 }
 
 void SymplecticTableau::row_mult(unsigned ra, unsigned rw, Complex coeff) {
-  MatrixXb::RowXpr xa = xmat_.row(ra);
-  MatrixXb::RowXpr za = zmat_.row(ra);
-  MatrixXb::RowXpr xw = xmat_.row(rw);
-  MatrixXb::RowXpr zw = zmat_.row(rw);
-  row_mult(xa, za, phase_(ra), xw, zw, phase_(rw), coeff, xw, zw, phase_(rw));
+  rows_.row_mult(ra, rw, coeff);
 }
 
-void SymplecticTableau::apply_S(unsigned qb) {
-  MatrixXb::ColXpr xcol = xmat_.col(qb);
-  MatrixXb::ColXpr zcol = zmat_.col(qb);
-  col_mult(xcol, zcol, true, zcol, phase_);
-}
+void SymplecticTableau::apply_S(unsigned qb) { rows_.apply_S(qb); }
 
-void SymplecticTableau::apply_V(unsigned qb) {
-  MatrixXb::ColXpr xcol = xmat_.col(qb);
-  MatrixXb::ColXpr zcol = zmat_.col(qb);
-  col_mult(xcol, zcol, false, xcol, phase_);
-}
+void SymplecticTableau::apply_V(unsigned qb) { rows_.apply_V(qb); }
 
 void SymplecticTableau::apply_CX(unsigned qc, unsigned qt) {
-  for (unsigned i = 0; i < n_rows_; ++i) {
-    phase_(i) = phase_(i) ^ (xmat_(i, qc) && zmat_(i, qt) &&
-                             !(xmat_(i, qt) ^ zmat_(i, qc)));
-    xmat_(i, qt) = xmat_(i, qc) ^ xmat_(i, qt);
-    zmat_(i, qc) = zmat_(i, qc) ^ zmat_(i, qt);
-  }
+  rows_.apply_CX(qc, qt);
 }
 
 void SymplecticTableau::apply_gate(
@@ -278,27 +239,17 @@ void SymplecticTableau::apply_pauli_gadget(
 
   // From here, half_pis == 1 or 3
   // They act the same except for a phase flip on the product term
-  MatrixXb pauli_xrow = MatrixXb::Zero(1, n_qubits_);
-  MatrixXb pauli_zrow = MatrixXb::Zero(1, n_qubits_);
+  PackedPauliRows pauli_row(1, n_qubits_);
   for (unsigned i = 0; i < n_qubits_; ++i) {
     Pauli p = pauli.string.at(i);
-    pauli_xrow(i) = (p == Pauli::X) || (p == Pauli::Y);
-    pauli_zrow(i) = (p == Pauli::Z) || (p == Pauli::Y);
+    pauli_row.set_x(0, i, (p == Pauli::X) || (p == Pauli::Y));
+    pauli_row.set_z(0, i, (p == Pauli::Z) || (p == Pauli::Y));
   }
-  bool phase = (!pauli.coeff) ^ (half_pis == 3);
+  pauli_row.set_phase(0, (!pauli.coeff) ^ (half_pis == 3));
 
   for (unsigned i = 0; i < n_rows_; ++i) {
-    bool anti = false;
-    MatrixXb::RowXpr xr = xmat_.row(i);
-    MatrixXb::RowXpr zr = zmat_.row(i);
-    for (unsigned q = 0; q < n_qubits_; ++q) {
-      anti ^= (xr(q) && pauli_zrow(q));
-      anti ^= (zr(q) && pauli_xrow(q));
-    }
-    if (anti) {
-      row_mult(
-          xr, zr, phase_(i), pauli_xrow.row(0), pauli_zrow.row(0), phase, i_,
-          xr, zr, phase_(i));
+    if (PackedPauliRows::anticommutes(rows_, i, pauli_row, 0)) {
+      PackedPauliRows::row_mult(rows_, i, pauli_row, 0, i_, rows_, i);
     }
   }
 }
@@ -307,11 +258,7 @@ MatrixXb SymplecticTableau::anticommuting_rows() const {
   MatrixXb res = MatrixXb::Zero(n_rows_, n_rows_);
   for (unsigned i = 0; i < n_rows_; ++i) {
     for (unsigned j = 0; j < i; ++j) {
-      bool anti = false;
-      for (unsigned q = 0; q < n_qubits_; ++q) {
-        anti ^= (xmat_(i, q) && zmat_(j, q));
-        anti ^= (xmat_(j, q) && zmat_(i, q));
-      }
+      bool anti = rows_.anticommutes(i, j);
       res(i, j) = anti;
       res(j, i) = anti;
     }
@@ -319,57 +266,24 @@ MatrixXb SymplecticTableau::anticommuting_rows() const {
   return res;
 }
 
-unsigned SymplecticTableau::rank() const {
-  MatrixXb fullmat(n_rows_, 2 * n_qubits_);
-  fullmat << xmat_, zmat_;
-  Eigen::FullPivLU<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>> lu(
-      fullmat.cast<double>());
-  return lu.rank();
-}
+unsigned SymplecticTableau::rank() const { return rows_.rank(); }
 
 SymplecticTableau SymplecticTableau::conjugate() const {
   SymplecticTableau conj(*this);
   for (unsigned i = 0; i < n_rows_; ++i) {
-    unsigned sum = 0;
-    for (unsigned j = 0; j < n_qubits_; ++j) {
-      if (xmat_(i, j) && zmat_(i, j)) ++sum;
+    if (rows_.odd_y_count(i)) {
+      conj.rows_.set_phase(i, !rows_.get_phase(i));
     }
-    if (sum % 2 == 1) conj.phase_(i) ^= true;
   }
   return conj;
 }
 
-void SymplecticTableau::row_mult(
-    const MatrixXb::RowXpr &xa, const MatrixXb::RowXpr &za, const bool &pa,
-    const MatrixXb::RowXpr &xb, const MatrixXb::RowXpr &zb, const bool &pb,
-    Complex phase, MatrixXb::RowXpr &xw, MatrixXb::RowXpr &zw, bool &pw) {
-  if (pa) phase *= -1;
-  if (pb) phase *= -1;
-  for (unsigned i = 0; i < n_qubits_; i++) {
-    std::pair<BoolPauli, Complex> res =
-        BoolPauli::mult_lut.at({{xa(i), za(i)}, {xb(i), zb(i)}});
-    xw(i) = res.first.x;
-    zw(i) = res.first.z;
-    phase *= res.second;
-  }
-  pw = (phase == -1.);
-}
-
-void SymplecticTableau::col_mult(
-    const MatrixXb::ColXpr &a, const MatrixXb::ColXpr &b, bool flip,
-    MatrixXb::ColXpr &w, VectorXb &pw) {
-  for (unsigned i = 0; i < n_rows_; i++) {
-    pw(i) = pw(i) ^ (a(i) && (b(i) ^ flip));
-    w(i) = a(i) ^ b(i);
-  }
-}
-
 void to_json(nlohmann::json &j, const SymplecticTableau &tab) {
   j["nrows"] = tab.n_rows_;
   j["nqubits"] = tab.n_qubits_;
-  j["xmat"] = tab.xmat_;
-  j["zmat"] = tab.zmat_;
-  j["phase"] = tab.phase_;
+  j["xmat"] = tab.get_xmat();
+  j["zmat"] = tab.get_zmat();
+  j["phase"] = tab.get_phase();
 }
 
 void from_json(const nlohmann::json &j, SymplecticTableau &tab) {
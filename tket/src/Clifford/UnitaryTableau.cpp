@@ -14,6 +14,7 @@
 
 #include "UnitaryTableau.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "OpType/OpTypeInfo.hpp"
@@ -21,12 +22,13 @@
 
 namespace tket {
 
-UnitaryTableau::UnitaryTableau(unsigned n) : tab_({}) {
-  MatrixXb xmat(2 * n, n);
-  xmat << MatrixXb::Identity(n, n), MatrixXb::Zero(n, n);
-  MatrixXb zmat(2 * n, n);
-  zmat << MatrixXb::Zero(n, n), MatrixXb::Identity(n, n);
-  tab_ = SymplecticTableau(xmat, zmat, VectorXb::Zero(2 * n));
+UnitaryTableau::UnitaryTableau(unsigned n) : tab_(PauliStabiliserList{}) {
+  PackedPauliRows rows(2 * n, n);
+  for (unsigned i = 0; i < n; ++i) {
+    rows.set_x(i, i, true);
+    rows.set_z(i + n, i, true);
+  }
+  tab_ = SymplecticTableau(rows);
   qubits_ = boost::bimap<Qubit, unsigned>();
   for (unsigned i = 0; i < n; ++i) {
     qubits_.insert({Qubit(i), i});
@@ -44,7 +46,7 @@ UnitaryTableau::UnitaryTableau(const qubit_vector_t& qbs)
 UnitaryTableau::UnitaryTableau(
     const MatrixXb& xx, const MatrixXb& xz, const VectorXb& xph,
     const MatrixXb& zx, const MatrixXb& zz, const VectorXb& zph)
-    : tab_({}) {
+    : tab_(PauliStabiliserList{}) {
   unsigned n_qubits = xx.rows();
   if ((xx.cols() != n_qubits) || (xz.rows() != n_qubits) ||
       (xz.cols() != n_qubits) || (xph.size() != n_qubits) ||
@@ -182,6 +184,67 @@ void UnitaryTableau::apply_CX_at_end(
   tab_.apply_CX(uc, ut);
 }
 
+bool UnitaryTableau::measurement_is_random(const Qubit& qb) const {
+  unsigned uqb = qubits_.left.at(qb);
+  unsigned nqb = qubits_.size();
+  for (unsigned i = 0; i < nqb; ++i) {
+    if (tab_.rows_.get_x(i + nqb, uqb)) return true;
+  }
+  return false;
+}
+
+bool UnitaryTableau::measure_at_end(const Qubit& qb, bool outcome_if_random) {
+  unsigned uqb = qubits_.left.at(qb);
+  unsigned nqb = qubits_.size();
+  PackedPauliRows& rows = tab_.rows_;
+  const unsigned n_words = rows.get_n_words();
+
+  // Find a stabiliser anticommuting with Z on the qubit
+  unsigned p = nqb;
+  for (unsigned i = 0; i < nqb; ++i) {
+    if (rows.get_x(i + nqb, uqb)) {
+      p = i;
+      break;
+    }
+  }
+
+  if (p == nqb) {
+    // The outcome is determined: Z on the qubit is the product of the
+    // stabilisers whose destabilisers anticommute with it
+    PackedPauliRows product(1, nqb);
+    for (unsigned i = 0; i < nqb; ++i) {
+      if (rows.get_x(i, uqb)) {
+        PackedPauliRows::row_mult(rows, i + nqb, product, 0, 1., product, 0);
+      }
+    }
+    return product.get_phase(0);
+  }
+
+  // The outcome is random: make every other row commute with Z on the
+  // qubit, then replace the stabiliser p by +/-Z, moving it to the
+  // corresponding destabiliser
+  const unsigned zp = p + nqb;
+  for (unsigned i = 0; i < 2 * nqb; ++i) {
+    if (i != zp && i != p && rows.get_x(i, uqb)) {
+      rows.row_mult(zp, i);
+    }
+  }
+  std::copy_n(rows.x_row(zp), n_words, rows.x_row(p));
+  std::copy_n(rows.z_row(zp), n_words, rows.z_row(p));
+  rows.set_phase(p, rows.get_phase(zp));
+  std::fill_n(rows.x_row(zp), n_words, 0);
+  std::fill_n(rows.z_row(zp), n_words, 0);
+  rows.set_z(zp, uqb, true);
+  rows.set_phase(zp, outcome_if_random);
+  return outcome_if_random;
+}
+
+void UnitaryTableau::reset_at_end(const Qubit& qb, bool outcome_if_random) {
+  if (measure_at_end(qb, outcome_if_random)) {
+    apply_gate_at_end(OpType::X, {qb});
+  }
+}
+
 void UnitaryTableau::apply_gate_at_front(
     OpType type, const qubit_vector_t& qbs) {
   switch (type) {
@@ -307,15 +370,14 @@ void UnitaryTableau::apply_pauli_at_front(
 
   // From here, half_pis == 1 or 3
   // They act the same except for a phase flip on the product term
-  MatrixXb product_x = MatrixXb::Zero(1, qubits_.size());
-  MatrixXb product_z = MatrixXb::Zero(1, qubits_.size());
-  MatrixXb::RowXpr px = product_x.row(0);
-  MatrixXb::RowXpr pz = product_z.row(0);
   if (pauli.coeff != 1. && pauli.coeff != -1.)
     throw std::domain_error(
         "Can only apply Pauli gadgets with real unit coefficients to "
         "UnitaryTableaux");
-  bool phase = (pauli.coeff == -1.) ^ (half_pis == 1);
+  const unsigned nqb = qubits_.size();
+  PackedPauliRows product(1, nqb);
+  product.set_phase(0, (pauli.coeff == -1.) ^ (half_pis == 1));
+  PackedPauliRows& rows = tab_.rows_;
 
   // Collect the product term
   for (const std::pair<const Qubit, Pauli>& term : pauli.string.map) {
@@ -325,28 +387,18 @@ void UnitaryTableau::apply_pauli_at_front(
         break;
       }
       case Pauli::X: {
-        tab_.row_mult(
-            tab_.xmat_.row(uqb), tab_.zmat_.row(uqb), tab_.phase_(uqb), px, pz,
-            phase, 1., px, pz, phase);
+        PackedPauliRows::row_mult(rows, uqb, product, 0, 1., product, 0);
         break;
       }
       case Pauli::Y: {
-        tab_.row_mult(
-            tab_.xmat_.row(uqb), tab_.zmat_.row(uqb), tab_.phase_(uqb), px, pz,
-            phase, 1., px, pz, phase);
-        tab_.row_mult(
-            tab_.xmat_.row(uqb + qubits_.size()),
-            tab_.zmat_.row(uqb + qubits_.size()),
-            tab_.phase_(uqb + qubits_.size()), px, pz, phase, 1., px, pz,
-            phase);
+        PackedPauliRows::row_mult(rows, uqb, product, 0, 1., product, 0);
+        PackedPauliRows::row_mult(
+            rows, uqb + nqb, product, 0, 1., product, 0);
         break;
       }
       case Pauli::Z: {
-        tab_.row_mult(
-            tab_.xmat_.row(uqb + qubits_.size()),
-            tab_.zmat_.row(uqb + qubits_.size()),
-            tab_.phase_(uqb + qubits_.size()), px, pz, phase, 1., px, pz,
-            phase);
+        PackedPauliRows::row_mult(
+            rows, uqb + nqb, product, 0, 1., product, 0);
         break;
       }
     }
@@ -355,33 +407,23 @@ void UnitaryTableau::apply_pauli_at_front(
   // Apply the product term on the anti-commuting rows
   for (const std::pair<const Qubit, Pauli>& term : pauli.string.map) {
     unsigned uqb = qubits_.left.at(term.first);
-    MatrixXb::RowXpr xx = tab_.xmat_.row(uqb);
-    MatrixXb::RowXpr xz = tab_.zmat_.row(uqb);
-    MatrixXb::RowXpr zx = tab_.xmat_.row(uqb + qubits_.size());
-    MatrixXb::RowXpr zz = tab_.zmat_.row(uqb + qubits_.size());
     switch (term.second) {
       case Pauli::I: {
         break;
       }
       case Pauli::X: {
-        tab_.row_mult(
-            px, pz, phase, zx, zz, tab_.phase_(uqb + qubits_.size()), -i_, zx,
-            zz, tab_.phase_(uqb + qubits_.size()));
+        PackedPauliRows::row_mult(
+            product, 0, rows, uqb + nqb, -i_, rows, uqb + nqb);
         break;
       }
       case Pauli::Y: {
-        tab_.row_mult(
-            px, pz, phase, zx, zz, tab_.phase_(uqb + qubits_.size()), -i_, zx,
-            zz, tab_.phase_(uqb + qubits_.size()));
-        tab_.row_mult(
-            px, pz, phase, xx, xz, tab_.phase_(uqb), -i_, xx, xz,
-            tab_.phase_(uqb));
+        PackedPauliRows::row_mult(
+            product, 0, rows, uqb + nqb, -i_, rows, uqb + nqb);
+        PackedPauliRows::row_mult(product, 0, rows, uqb, -i_, rows, uqb);
         break;
       }
       case Pauli::Z: {
-        tab_.row_mult(
-            px, pz, phase, xx, xz, tab_.phase_(uqb), -i_, xx, xz,
-            tab_.phase_(uqb));
+        PackedPauliRows::row_mult(product, 0, rows, uqb, -i_, rows, uqb);
         break;
       }
     }
@@ -494,8 +536,9 @@ UnitaryTableau UnitaryTableau::dagger() const {
     for (unsigned j = 0; j < nqb; ++j) {
       // Take effect of some input on some output and invert
       auto inv_cell = invert_cell_map().at(
-          {BoolPauli{tab_.xmat_(i, j), tab_.zmat_(i, j)},
-           BoolPauli{tab_.xmat_(i + nqb, j), tab_.zmat_(i + nqb, j)}});
+          {BoolPauli{tab_.rows_.get_x(i, j), tab_.rows_.get_z(i, j)},
+           BoolPauli{
+               tab_.rows_.get_x(i + nqb, j), tab_.rows_.get_z(i + nqb, j)}});
       // Transpose tableau and fill in cell
       dxx(j, i) = inv_cell.first.x;
       dxz(j, i) = inv_cell.first.z;
@@ -510,9 +553,9 @@ UnitaryTableau UnitaryTableau::dagger() const {
   // Correct phases
   for (unsigned i = 0; i < nqb; ++i) {
     QubitPauliTensor xr = dag.get_xrow(qubits_.right.at(i));
-    dag.tab_.phase_(i) = get_row_product(xr).coeff == -1.;
+    dag.tab_.rows_.set_phase(i, get_row_product(xr).coeff == -1.);
     QubitPauliTensor zr = dag.get_zrow(qubits_.right.at(i));
-    dag.tab_.phase_(i + nqb) = get_row_product(zr).coeff == -1.;
+    dag.tab_.rows_.set_phase(i + nqb, get_row_product(zr).coeff == -1.);
   }
 
   return dag;
@@ -531,17 +574,19 @@ UnitaryTableau UnitaryTableau::conjugate() const {
 
 std::ostream& operator<<(std::ostream& os, const UnitaryTableau& tab) {
   unsigned nqs = tab.qubits_.size();
+  const MatrixXb xmat = tab.tab_.get_xmat();
+  const MatrixXb zmat = tab.tab_.get_zmat();
+  const VectorXb phase = tab.tab_.get_phase();
   for (unsigned i = 0; i < nqs; ++i) {
     Qubit qi = tab.qubits_.right.at(i);
-    os << "X@" << qi.repr() << "\t->\t" << tab.tab_.xmat_.row(i) << "   "
-       << tab.tab_.zmat_.row(i) << "   " << tab.tab_.phase_(i) << std::endl;
+    os << "X@" << qi.repr() << "\t->\t" << xmat.row(i) << "   "
+       << zmat.row(i) << "   " << phase(i) << std::endl;
   }
   os << "--" << std::endl;
   for (unsigned i = 0; i < nqs; ++i) {
     Qubit qi = tab.qubits_.right.at(i);
-    os << "Z@" << qi.repr() << "\t->\t" << tab.tab_.xmat_.row(i + nqs) << "   "
-       << tab.tab_.zmat_.row(i + nqs) << "   " << tab.tab_.phase_(i + nqs)
-       << std::endl;
+    os << "Z@" << qi.repr() << "\t->\t" << xmat.row(i + nqs) << "   "
+       << zmat.row(i + nqs) << "   " << phase(i + nqs) << std::endl;
   }
   return os;
 }
@@ -550,6 +595,8 @@ bool UnitaryTableau::operator==(const UnitaryTableau& other) const {
   if (get_qubits() != other.get_qubits()) return false;
 
   unsigned nq = qubits_.size();
+  const PackedPauliRows& rows = tab_.rows_;
+  const PackedPauliRows& other_rows = other.tab_.rows_;
 
   for (unsigned i = 0; i < nq; ++i) {
     Qubit qi = qubits_.right.at(i);
@@ -557,13 +604,13 @@ bool UnitaryTableau::operator==(const UnitaryTableau& other) const {
     for (unsigned j = 0; j < nq; ++j) {
       Qubit qj = qubits_.right.at(j);
       unsigned oj = other.qubits_.left.at(qj);
-      if (tab_.xmat_(i, j) != other.tab_.xmat_(oi, oj)) return false;
-      if (tab_.zmat_(i, j) != other.tab_.zmat_(oi, oj)) return false;
-      if (tab_.xmat_(i + nq, j) != other.tab_.xmat_(oi + nq, oj)) return false;
-      if (tab_.zmat_(i + nq, j) != other.tab_.zmat_(oi + nq, oj)) return false;
+      if (rows.get_x(i, j) != other_rows.get_x(oi, oj)) return false;
+      if (rows.get_z(i, j) != other_rows.get_z(oi, oj)) return false;
+      if (rows.get_x(i + nq, j) != other_rows.get_x(oi + nq, oj)) return false;
+      if (rows.get_z(i + nq, j) != other_rows.get_z(oi + nq, oj)) return false;
     }
-    if (tab_.phase_(i) != other.tab_.phase_(oi)) return false;
-    if (tab_.phase_(i + nq) != other.tab_.phase_(oi + nq)) return false;
+    if (rows.get_phase(i) != other_rows.get_phase(oi)) return false;
+    if (rows.get_phase(i + nq) != other_rows.get_phase(oi + nq)) return false;
   }
 
   return true;
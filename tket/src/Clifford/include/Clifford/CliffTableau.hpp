@@ -15,6 +15,7 @@
 #pragma once
 
 #include "OpType/OpType.hpp"
+#include "PackedPauliRows.hpp"
 #include "Utils/BiMapHeaders.hpp"
 #include "Utils/MatrixAnalysis.hpp"
 #include "Utils/PauliStrings.hpp"
@@ -63,12 +64,8 @@ class CliffTableau {
    */
   CliffTableau(const CliffTableau &other)
       : size_(other.size_),
-        xpauli_x(other.xpauli_x),
-        xpauli_z(other.xpauli_z),
-        xpauli_phase(other.xpauli_phase),
-        zpauli_x(other.zpauli_x),
-        zpauli_z(other.zpauli_z),
-        zpauli_phase(other.zpauli_phase),
+        xpauli(other.xpauli),
+        zpauli(other.zpauli),
         qubits_(other.qubits_){};
 
   /**
@@ -146,61 +143,15 @@ class CliffTableau {
   const unsigned size_;
 
   /**
-   * (A)pauli_(B): matrix representing the dependence of the A-channel of each
-   * output on the (B) channel of each input
-   *
-   * (A)pauli_phase: whether or not there is a phase-flip on the A-channel of
+   * (A)pauli: rows representing the dependence of the A-channel of each
+   * output on the X and Z channels of each input, with a phase-flip bit for
    * each output
    */
-  MatrixXb xpauli_x;
-  MatrixXb xpauli_z;
-  VectorXb xpauli_phase;
-  MatrixXb zpauli_x;
-  MatrixXb zpauli_z;
-  VectorXb zpauli_phase;
+  PackedPauliRows xpauli;
+  PackedPauliRows zpauli;
 
   /** Map from qubit IDs to their row/column index in tableau */
   boost::bimap<Qubit, unsigned> qubits_;
-
-  /**
-   * Boolean encoding of Pauli
-   * <x, z> = <false, false> ==> I
-   * <x, z> = <false, true>  ==> Z
-   * <x, z> = <true,  false> ==> X
-   * <x, z> = <true,  true>  ==> Y
-   */
-  struct BoolPauli {
-    bool x;
-    bool z;
-
-    /**
-     * Lexicographic ordering by <x, z>
-     */
-    bool operator<(const BoolPauli &other) const {
-      if (x == other.x) {
-        return z < other.z;
-      }
-      return x < other.x;
-    }
-  };
-
-  /**
-   * Look-up table for Pauli multiplication with boolean encoding
-   */
-  static const std::map<
-      std::pair<BoolPauli, BoolPauli>, std::pair<BoolPauli, Complex>>
-      mult_lut;
-
-  /**
-   * Helper methods for manipulating the tableau when applying gates
-   */
-  void row_mult(
-      const MatrixXb::RowXpr &xa, const MatrixXb::RowXpr &za, const bool &pa,
-      const MatrixXb::RowXpr &xb, const MatrixXb::RowXpr &zb, const bool &pb,
-      Complex phase, MatrixXb::RowXpr &xw, MatrixXb::RowXpr &zw, bool &pw);
-  void col_mult(
-      const MatrixXb::ColXpr &a, const MatrixXb::ColXpr &b, bool flip,
-      MatrixXb::ColXpr &w, VectorXb &pw);
 };
 
 std::ostream &operator<<(std::ostream &os, CliffTableau const &tab);
@@ -0,0 +1,148 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Utils/Constants.hpp"
+#include "Utils/MatrixAnalysis.hpp"
+
+namespace tket {
+
+/**
+ * Word-packed storage for the rows of a tableau.
+ *
+ * Each row is a Pauli string in symplectic form with a sign: the x and z
+ * components of row r are arrays of 64-qubit words starting at x_row(r) and
+ * z_row(r), and the phase bit p gives the sign (-1)^p. Phases are packed
+ * into words too.
+ *
+ * Row multiplication XORs whole words, and tracks the phase from popcounts
+ * of the qubits on which the two rows anticommute. Gates are applied as
+ * column operations, one bit per row.
+ */
+class PackedPauliRows {
+ public:
+  /** Construct n_rows identity rows on n_qubits qubits */
+  explicit PackedPauliRows(unsigned n_rows = 0, unsigned n_qubits = 0);
+
+  /**
+   * Construct from unpacked components
+   * (which must have consistent dimensions)
+   */
+  PackedPauliRows(
+      const MatrixXb &xmat, const MatrixXb &zmat, const VectorXb &phase);
+
+  unsigned get_n_rows() const { return n_rows_; }
+  unsigned get_n_qubits() const { return n_qubits_; }
+  unsigned get_n_words() const { return n_words_; }
+
+  bool get_x(unsigned r, unsigned q) const {
+    return (x_[r * n_words_ + q / 64] >> (q % 64)) & 1;
+  }
+  bool get_z(unsigned r, unsigned q) const {
+    return (z_[r * n_words_ + q / 64] >> (q % 64)) & 1;
+  }
+  bool get_phase(unsigned r) const { return (phase_[r / 64] >> (r % 64)) & 1; }
+
+  void set_x(unsigned r, unsigned q, bool value) {
+    set_bit(x_[r * n_words_ + q / 64], q % 64, value);
+  }
+  void set_z(unsigned r, unsigned q, bool value) {
+    set_bit(z_[r * n_words_ + q / 64], q % 64, value);
+  }
+  void set_phase(unsigned r, bool value) {
+    set_bit(phase_[r / 64], r % 64, value);
+  }
+
+  /** The packed x components of row r */
+  std::uint64_t *x_row(unsigned r) { return x_.data() + r * n_words_; }
+  const std::uint64_t *x_row(unsigned r) const {
+    return x_.data() + r * n_words_;
+  }
+
+  /** The packed z components of row r */
+  std::uint64_t *z_row(unsigned r) { return z_.data() + r * n_words_; }
+  const std::uint64_t *z_row(unsigned r) const {
+    return z_.data() + r * n_words_;
+  }
+
+  /** Unpacked copies of the components */
+  MatrixXb get_xmat() const;
+  MatrixXb get_zmat() const;
+  VectorXb get_phases() const;
+
+  bool operator==(const PackedPauliRows &other) const;
+
+  /**
+   * Row multiplication across (possibly distinct) row sets.
+   * Sets row rw of w to coeff * (row ra of a) * (row rb of b), keeping only
+   * the sign of the result: the phase bit is set iff it is -1.
+   * The rows must have the same number of qubits, and row rw may coincide
+   * with either of the others.
+   *
+   * @param coeff a power of i
+   */
+  static void row_mult(
+      const PackedPauliRows &a, unsigned ra, const PackedPauliRows &b,
+      unsigned rb, Complex coeff, PackedPauliRows &w, unsigned rw);
+
+  /**
+   * Multiplies rows ra and rw, stores the result in row rw
+   */
+  void row_mult(unsigned ra, unsigned rw, Complex coeff = 1.) {
+    row_mult(*this, ra, *this, rw, coeff, *this, rw);
+  }
+
+  /** Whether row ra of a and row rb of b anticommute */
+  static bool anticommutes(
+      const PackedPauliRows &a, unsigned ra, const PackedPauliRows &b,
+      unsigned rb);
+
+  /** Whether rows r1 and r2 anticommute */
+  bool anticommutes(unsigned r1, unsigned r2) const {
+    return anticommutes(*this, r1, *this, r2);
+  }
+
+  /** Whether row r has an odd number of Y terms */
+  bool odd_y_count(unsigned r) const;
+
+  /**
+   * Column operations applying an S/V/CX gate to the given qubit(s)
+   * of every row
+   */
+  void apply_S(unsigned qb);
+  void apply_V(unsigned qb);
+  void apply_CX(unsigned qc, unsigned qt);
+
+  /** Rank over GF(2) of the rows, as vectors of 2 * n_qubits bits */
+  unsigned rank() const;
+
+ private:
+  unsigned n_rows_;
+  unsigned n_qubits_;
+  unsigned n_words_;
+  std::vector<std::uint64_t> x_;
+  std::vector<std::uint64_t> z_;
+  std::vector<std::uint64_t> phase_;
+
+  static void set_bit(std::uint64_t &word, unsigned bit, bool value) {
+    const std::uint64_t mask = std::uint64_t(1) << bit;
+    word = value ? (word | mask) : (word & ~mask);
+  }
+};
+
+}  // namespace tket
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "OpType/OpType.hpp"
+#include "PackedPauliRows.hpp"
 #include "Utils/MatrixAnalysis.hpp"
 #include "Utils/PauliStrings.hpp"
 
@@ -41,13 +42,6 @@ struct BoolPauli {
   bool operator<(const BoolPauli &other) const;
 
   Pauli to_pauli() const;
-
-  /**
-   * Look-up table for Pauli multiplication with boolean encoding
-   */
-  static const std::map<
-      std::pair<BoolPauli, BoolPauli>, std::pair<BoolPauli, Complex>>
-      mult_lut;
 };
 
 class SymplecticTableau {
@@ -64,6 +58,7 @@ class SymplecticTableau {
    * assumption that rows are intended to capture stabilizers of some system and
    * thus have real coefficients. Pulling these together, each row represents a
    * (phaseful) Pauli string. Qubits are indexed by unsigneds in a linear array.
+   * The rows are stored word-packed (see PackedPauliRows).
    *
    * This class provides the data structure, mechanisms for row multiplication,
    * gate application and validity checks.
@@ -90,6 +85,7 @@ class SymplecticTableau {
   explicit SymplecticTableau(
       const MatrixXb &xmat, const MatrixXb &zmat, const VectorXb &phase);
   explicit SymplecticTableau(const PauliStabiliserList &rows);
+  explicit SymplecticTableau(const PackedPauliRows &rows);
 
   /**
    * Other required constructors
@@ -114,6 +110,13 @@ class SymplecticTableau {
    */
   PauliStabiliser get_pauli(unsigned i) const;
 
+  /**
+   * Unpacked copies of the tableau contents
+   */
+  MatrixXb get_xmat() const { return rows_.get_xmat(); }
+  MatrixXb get_zmat() const { return rows_.get_zmat(); }
+  VectorXb get_phase() const { return rows_.get_phases(); }
+
   /**
    * Format in output stream as a binary tableau
    * Prints as "xmat zmat phase"
@@ -167,26 +170,13 @@ class SymplecticTableau {
   /**
    * Tableau contents
    */
-  MatrixXb xmat_;
-  MatrixXb zmat_;
-  VectorXb phase_;
+  PackedPauliRows rows_;
 
   /**
    * Complex conjugate of the state by conjugating rows
    */
   SymplecticTableau conjugate() const;
 
-  /**
-   * Helper methods for manipulating the tableau when applying gates
-   */
-  void row_mult(
-      const MatrixXb::RowXpr &xa, const MatrixXb::RowXpr &za, const bool &pa,
-      const MatrixXb::RowXpr &xb, const MatrixXb::RowXpr &zb, const bool &pb,
-      Complex phase, MatrixXb::RowXpr &xw, MatrixXb::RowXpr &zw, bool &pw);
-  void col_mult(
-      const MatrixXb::ColXpr &a, const MatrixXb::ColXpr &b, bool flip,
-      MatrixXb::ColXpr &w, VectorXb &pw);
-
   friend class UnitaryTableau;
   friend Circuit unitary_tableau_to_circuit(const UnitaryTableau &tab);
   friend std::ostream &operator<<(std::ostream &os, const UnitaryTableau &tab);
@@ -117,6 +117,33 @@ class UnitaryTableau {
   void apply_pauli_at_front(const QubitPauliTensor& pauli, unsigned half_pis);
   void apply_pauli_at_end(const QubitPauliTensor& pauli, unsigned half_pis);
 
+  /**
+   * Treat the tableau as describing the stabiliser state C|0>^n, whose
+   * stabilisers are the Z rows and destabilisers the X rows, and measure a
+   * qubit at the end of the circuit in the computational basis, following
+   * Aaronson & Gottesman. The tableau is updated to that of a unitary which
+   * prepares the post-measurement state.
+   *
+   * @param qb The qubit to measure
+   * @param outcome_if_random The outcome to collapse to if the measurement is
+   * not determined by the state
+   * @return The measurement outcome
+   */
+  bool measure_at_end(const Qubit& qb, bool outcome_if_random);
+
+  /**
+   * Whether measuring \p qb in the computational basis at the end of the
+   * circuit would give a uniformly random outcome, rather than a determined
+   * one. Takes time O(N) for N qubits.
+   */
+  bool measurement_is_random(const Qubit& qb) const;
+
+  /**
+   * Measure \p qb at the end of the circuit as in measure_at_end, then
+   * flip it back to |0> if the outcome was 1.
+   */
+  void reset_at_end(const Qubit& qb, bool outcome_if_random);
+
   /**
    * Combine two tableaux in sequence.
    * Will throw an exception if the tableaux are not over the same set of
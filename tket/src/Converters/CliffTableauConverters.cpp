@@ -45,7 +45,7 @@ Circuit tableau_to_circuit(const CliffTableau &tab) {
   /*
    * Step 1: Use Hadamards (in our case, Vs) to make C (zpauli_x) have full rank
    */
-  MatrixXb echelon = tabl.zpauli_x;
+  MatrixXb echelon = tabl.zpauli.get_xmat();
   std::map<unsigned, unsigned> leading_val_to_col;
   for (unsigned i = 0; i < size; i++) {
     for (unsigned j = 0; j < size; j++) {
@@ -67,7 +67,9 @@ Circuit tableau_to_circuit(const CliffTableau &tab) {
     tabl.apply_V_at_front(i);
     tabl.apply_V_at_front(i);
     tabl.apply_V_at_front(i);
-    echelon.col(i) = tabl.zpauli_z.col(i);
+    for (unsigned j = 0; j < size; j++) {
+      echelon(j, i) = tabl.zpauli.get_z(j, i);
+    }
     for (unsigned j = 0; j < size; j++) {
       if (echelon(j, i)) {
         if (leading_val_to_col.find(j) == leading_val_to_col.end()) {
@@ -91,7 +93,7 @@ Circuit tableau_to_circuit(const CliffTableau &tab) {
    * \ I D /
    */
   for (const std::pair<unsigned, unsigned> &qbs :
-       gaussian_elimination_col_ops(tabl.zpauli_x)) {
+       gaussian_elimination_col_ops(tabl.zpauli.get_xmat())) {
     c.add_op<unsigned>(OpType::CX, {qbs.first, qbs.second});
     tabl.apply_CX_at_front(qbs.first, qbs.second);
   }
@@ -103,7 +105,7 @@ Circuit tableau_to_circuit(const CliffTableau &tab) {
    * for some invertible M.
    */
   std::pair<MatrixXb, MatrixXb> zp_z_llt =
-      binary_LLT_decomposition(tabl.zpauli_z);
+      binary_LLT_decomposition(tabl.zpauli.get_zmat());
   for (unsigned i = 0; i < size; i++) {
     if (zp_z_llt.second(i, i)) {
       c.add_op<unsigned>(OpType::S, {i});
@@ -151,7 +153,7 @@ Circuit tableau_to_circuit(const CliffTableau &tab) {
    * By commutativity relations, IB^T = A0^T + I, therefore B = I.
    */
   for (const std::pair<unsigned, unsigned> &qbs :
-       gaussian_elimination_col_ops(tabl.zpauli_x)) {
+       gaussian_elimination_col_ops(tabl.zpauli.get_xmat())) {
     c.add_op<unsigned>(OpType::CX, {qbs.first, qbs.second});
     tabl.apply_CX_at_front(qbs.first, qbs.second);
   }
@@ -174,7 +176,7 @@ Circuit tableau_to_circuit(const CliffTableau &tab) {
    * some invertible N.
    */
   std::pair<MatrixXb, MatrixXb> xp_z_llt =
-      binary_LLT_decomposition(tabl.xpauli_z);
+      binary_LLT_decomposition(tabl.xpauli.get_zmat());
   for (unsigned i = 0; i < size; i++) {
     if (xp_z_llt.second(i, i)) {
       c.add_op<unsigned>(OpType::S, {i});
@@ -219,7 +221,7 @@ Circuit tableau_to_circuit(const CliffTableau &tab) {
    * \ 0 I /
    */
   for (const std::pair<unsigned, unsigned> &qbs :
-       gaussian_elimination_col_ops(tabl.xpauli_x)) {
+       gaussian_elimination_col_ops(tabl.xpauli.get_xmat())) {
     c.add_op<unsigned>(OpType::CX, {qbs.first, qbs.second});
     tabl.apply_CX_at_front(qbs.first, qbs.second);
   }
@@ -228,12 +230,12 @@ Circuit tableau_to_circuit(const CliffTableau &tab) {
    * DELAYED STEPS: Set all phases to 0 by applying Z or X gates
    */
   for (unsigned i = 0; i < size; i++) {
-    if (tabl.xpauli_phase(i)) {
+    if (tabl.xpauli.get_phase(i)) {
       c.add_op<unsigned>(OpType::Z, {i});
       tabl.apply_S_at_front(i);
       tabl.apply_S_at_front(i);
     }
-    if (tabl.zpauli_phase(i)) {
+    if (tabl.zpauli.get_phase(i)) {
       c.add_op<unsigned>(OpType::X, {i});
       tabl.apply_V_at_front(i);
       tabl.apply_V_at_front(i);
@@ -24,27 +24,23 @@ void CXMaker::row_add(unsigned r0, unsigned r1) {
 }
 
 void DiagMatrix::row_add(unsigned r0, unsigned r1) {
-  for (unsigned i = 0; i < _matrix.row(r0).size(); ++i) {
-    _matrix.row(r1)[i] ^= _matrix.row(r0)[i];
-  }
+  _matrix.row_add(r0, r1);
 }
 
 void DiagMatrix::col_add(unsigned c0, unsigned c1) {
-  for (unsigned i = 0; i < _matrix.col(c0).size(); ++i) {
-    _matrix.col(c1)[i] ^= _matrix.col(c0)[i];
-  }
+  _matrix.col_add(c0, c1);
 }
 
 void DiagMatrix::gauss(CXMaker& cxmaker, unsigned blocksize) {
+  // The elimination reduces the matrix itself as it goes.
   std::vector<std::pair<unsigned, unsigned>> row_ops =
-      gaussian_elimination_row_ops(_matrix, blocksize);
+      _matrix.gaussian_elimination_row_ops(blocksize);
   for (std::pair<unsigned, unsigned> op : row_ops) {
-    row_add(op.first, op.second);
     cxmaker.row_add(op.first, op.second);
   }
 }
 
-bool DiagMatrix::is_id() const { return _matrix.isIdentity(); }
+bool DiagMatrix::is_id() const { return _matrix.is_identity(); }
 
 bool DiagMatrix::is_id_until_columns(unsigned limit) const {
   TKET_ASSERT(limit <= n_rows());
@@ -70,16 +66,16 @@ bool DiagMatrix::is_id_until_columns(unsigned limit) const {
   return true;
 }
 
-unsigned DiagMatrix::n_rows() const { return _matrix.rows(); }
+unsigned DiagMatrix::n_rows() const { return _matrix.get_n_rows(); }
 
-unsigned DiagMatrix::n_cols() const { return _matrix.cols(); }
+unsigned DiagMatrix::n_cols() const { return _matrix.get_n_cols(); }
 
 std::ostream& operator<<(std::ostream& out, const DiagMatrix& diam) {
   out << "give the DiagMatrix: " << std::endl;
-  for (unsigned i = 0; i < diam._matrix.row(0).size(); ++i) {
+  for (unsigned i = 0; i < diam.n_cols(); ++i) {
     out << " ";
-    for (unsigned j = 0; j < diam._matrix.row(0).size(); ++j) {
-      out << diam._matrix.row(i)[j] << ", ";
+    for (unsigned j = 0; j < diam.n_cols(); ++j) {
+      out << diam._matrix(i, j) << ", ";
     }
     out << std::endl;
   }
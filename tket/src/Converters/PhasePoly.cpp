@@ -27,6 +27,7 @@
 #include "Ops/MetaOp.hpp"
 #include "Ops/OpJsonFactory.hpp"
 #include "Ops/OpPtr.hpp"
+#include "Utils/GF2Matrix.hpp"
 #include "Utils/GraphHeaders.hpp"
 #include "Utils/Json.hpp"
 
@@ -93,7 +94,8 @@ static std::pair<std::list<phase_term_t>, std::list<phase_term_t>> split(
 Circuit gray_synth(
     unsigned n_qubits, const std::list<phase_term_t>& parities,
     const MatrixXb& linear_transformation) {
-  MatrixXb A = linear_transformation;
+  // Stored transposed, since it is only updated by column operations.
+  GF2Matrix A_cols = GF2Matrix(linear_transformation).transpose();
   Circuit circ(n_qubits);
   std::list<SynthStruct> Q;  // used to recur over
   std::set<unsigned>
@@ -115,13 +117,11 @@ Circuit gray_synth(
         if (ctrl != tgt && vec[ctrl]) {
           circ.add_op<unsigned>(OpType::CX, {ctrl, tgt});
           adjust_vectors(ctrl, tgt, Q);
-          for (unsigned i = 0; i < A.rows(); i++) {
-            // do column operation on linear
-            // transformation
-            // this will allow us to correct for the CXs
-            // we produce here using Gaussian elim
-            A(i, ctrl) ^= A(i, tgt);
-          }
+          // do column operation on linear
+          // transformation
+          // this will allow us to correct for the CXs
+          // we produce here using Gaussian elim
+          A_cols.row_add(tgt, ctrl);
         }
       }
       circ.add_op<unsigned>(OpType::Rz, angle, {tgt});
@@ -139,7 +139,7 @@ Circuit gray_synth(
       Q.push_front({S0, S.remaining_indices, S.target});
     }
   }
-  DiagMatrix m(A);
+  DiagMatrix m(A_cols.transpose());
   CXMaker cxmaker(n_qubits, false);
   m.gauss(cxmaker);
   circ.append(cxmaker._circ.dagger());
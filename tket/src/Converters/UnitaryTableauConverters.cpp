@@ -41,10 +41,10 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    */
 
   /*
-   * Step 1: Use Hadamards (in our case, Vs) to make C (z rows of xmat_) have
+   * Step 1: Use Hadamards (in our case, Vs) to make C (z rows of xmat) have
    * full rank
    */
-  MatrixXb echelon = tabl.xmat_.block(size, 0, size, size);
+  MatrixXb echelon = tabl.get_xmat().block(size, 0, size, size);
   std::map<unsigned, unsigned> leading_val_to_col;
   for (unsigned i = 0; i < size; i++) {
     for (unsigned j = 0; j < size; j++) {
@@ -66,7 +66,9 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
     tabl.apply_V(i);
     tabl.apply_V(i);
     tabl.apply_V(i);
-    echelon.col(i) = tabl.zmat_.block(size, i, size, 1);
+    for (unsigned j = 0; j < size; j++) {
+      echelon(j, i) = tabl.rows_.get_z(size + j, i);
+    }
     for (unsigned j = 0; j < size; j++) {
       if (echelon(j, i)) {
         if (leading_val_to_col.find(j) == leading_val_to_col.end()) {
@@ -89,7 +91,7 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    * / A B \
    * \ I D /
    */
-  MatrixXb to_reduce = tabl.xmat_.block(size, 0, size, size);
+  MatrixXb to_reduce = tabl.get_xmat().block(size, 0, size, size);
   for (const std::pair<unsigned, unsigned>& qbs :
        gaussian_elimination_col_ops(to_reduce)) {
     c.add_op<unsigned>(OpType::CX, {qbs.first, qbs.second});
@@ -103,7 +105,7 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    * for some invertible M.
    */
   std::pair<MatrixXb, MatrixXb> zp_z_llt =
-      binary_LLT_decomposition(tabl.zmat_.block(size, 0, size, size));
+      binary_LLT_decomposition(tabl.get_zmat().block(size, 0, size, size));
   for (unsigned i = 0; i < size; i++) {
     if (zp_z_llt.second(i, i)) {
       c.add_op<unsigned>(OpType::S, {i});
@@ -150,7 +152,7 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    * \ I 0 /
    * By commutativity relations, IB^T = A0^T + I, therefore B = I.
    */
-  to_reduce = tabl.xmat_.block(size, 0, size, size);
+  to_reduce = tabl.get_xmat().block(size, 0, size, size);
   for (const std::pair<unsigned, unsigned>& qbs :
        gaussian_elimination_col_ops(to_reduce)) {
     c.add_op<unsigned>(OpType::CX, {qbs.first, qbs.second});
@@ -175,7 +177,7 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    * some invertible N.
    */
   std::pair<MatrixXb, MatrixXb> xp_z_llt =
-      binary_LLT_decomposition(tabl.zmat_.block(0, 0, size, size));
+      binary_LLT_decomposition(tabl.get_zmat().block(0, 0, size, size));
   for (unsigned i = 0; i < size; i++) {
     if (xp_z_llt.second(i, i)) {
       c.add_op<unsigned>(OpType::S, {i});
@@ -220,7 +222,8 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    * \ 0 I /
    */
   for (const std::pair<unsigned, unsigned>& qbs :
-       gaussian_elimination_col_ops(tabl.xmat_.block(0, 0, size, size))) {
+       gaussian_elimination_col_ops(
+           tabl.get_xmat().block(0, 0, size, size))) {
     c.add_op<unsigned>(OpType::CX, {qbs.first, qbs.second});
     tabl.apply_CX(qbs.first, qbs.second);
   }
@@ -229,12 +232,12 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    * DELAYED STEPS: Set all phases to 0 by applying Z or X gates
    */
   for (unsigned i = 0; i < size; i++) {
-    if (tabl.phase_(i)) {
+    if (tabl.rows_.get_phase(i)) {
       c.add_op<unsigned>(OpType::Z, {i});
       tabl.apply_S(i);
       tabl.apply_S(i);
     }
-    if (tabl.phase_(i + size)) {
+    if (tabl.rows_.get_phase(i + size)) {
       c.add_op<unsigned>(OpType::X, {i});
       tabl.apply_V(i);
       tabl.apply_V(i);
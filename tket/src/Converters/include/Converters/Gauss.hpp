@@ -16,6 +16,7 @@
 
 #include "Circuit/Circuit.hpp"
 #include "Converters.hpp"
+#include "Utils/GF2Matrix.hpp"
 
 namespace tket {
 
@@ -32,6 +33,7 @@ class DiagMatrix {
  public:
   DiagMatrix() {}
   explicit DiagMatrix(const MatrixXb& matrix) : _matrix(matrix) {}
+  explicit DiagMatrix(const GF2Matrix& matrix) : _matrix(matrix) {}
   void row_add(unsigned r0, unsigned r1);
   void col_add(unsigned c0, unsigned c1);
   void gauss(CXMaker& cxmaker, unsigned blocksize = 6);
@@ -41,7 +43,7 @@ class DiagMatrix {
   unsigned n_rows() const;
   unsigned n_cols() const;
 
-  MatrixXb _matrix;
+  GF2Matrix _matrix;
 };
 
 }  // namespace tket
@@ -14,137 +14,172 @@
 
 #include "PauliPartition.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <numeric>
+#include <set>
 #include <tkassert/Assert.hpp>
 
-#include "Graphs/AdjacencyData.hpp"
 #include "Graphs/GraphColouring.hpp"
-#include "Utils/GraphHeaders.hpp"
+#include "Utils/SymplecticPauli.hpp"
+#include "Utils/ThreadPool.hpp"
 
 namespace tket {
 
-PauliPartitionerGraph::PauliPartitionerGraph(
-    const std::list<QubitPauliString>& strings, PauliPartitionStrat strat) {
-  pac_graph = {};
-  for (const QubitPauliString& tensor : strings) {
-    PauliACVertex new_vert = boost::add_vertex(tensor, pac_graph);
-    BGL_FORALL_VERTICES(v, pac_graph, PauliACGraph) {
-      if (v != new_vert) {
-        switch (strat) {
-          case (PauliPartitionStrat::NonConflictingSets): {
-            bool conflict = !tensor.conflicting_qubits(pac_graph[v]).empty();
-            if (conflict) boost::add_edge(new_vert, v, pac_graph);
-            break;
-          }
-          case (PauliPartitionStrat::CommutingSets): {
-            if (!tensor.commutes_with(pac_graph[v])) {
-              boost::add_edge(new_vert, v, pac_graph);
-            }
-            break;
-          }
-          default: {
-            throw UnknownPauliPartitionStrat();
-          }
-        }
-      }
-    }
-  }
-}
+namespace {
 
-// Consider templatising this and putting it into the graph routines.
-// The purpose is to take a boost graph and convert it
-// into our format, ready for graph colouring.
-// Surely an insignificant overhead unless the graph is tiny.
-// MAYBE consider changing our graph colouring routines,
-// by templatising/converting to boost-style.
-class AbstractGraphData {
+// The strings packed as symplectic bit-words over their common qubits:
+// string i occupies words [i*n_words, (i+1)*n_words) of both x_ and z_,
+// so that each pairwise test is a handful of word operations.
+class PackedPauliStrings {
  public:
-  // All the conversion work is done inside the constructor.
-  explicit AbstractGraphData(const PauliACGraph& pac_graph);
-
-  // Return the ID of the string (and also assign a new ID if the string
-  // was not seen before); the eventual IDs will form an interval {0,1,2,...,n}.
-  std::size_t get_vertex_id(const QubitPauliString& pauli_string);
+  explicit PackedPauliStrings(const std::vector<QubitPauliString>& strings);
 
-  typedef
-      // KEY: the Pauli string present in a vertex
-      // VALUE: an integer label for that vertex.
-      //      The labels will be a contiguous interval {0,1,2,...,m}.
-      std::map<QubitPauliString, std::size_t>
-          VertexMap;
+  std::size_t size() const { return size_; }
 
-  const graphs::AdjacencyData& get_adjacency_data() const;
+  // Whether strings i and j anticommute, i.e. whether they carry
+  // different non-identity Paulis on an odd number of qubits.
+  bool anticommute(std::size_t i, std::size_t j) const {
+    return symplectic::anticommute(
+        &x_[i * n_words_], &z_[i * n_words_], &x_[j * n_words_],
+        &z_[j * n_words_], n_words_);
+  }
 
-  const VertexMap& get_vertex_map() const;
+  // Whether strings i and j carry different non-identity Paulis
+  // on at least one qubit.
+  bool conflict(std::size_t i, std::size_t j) const {
+    return symplectic::conflict(
+        &x_[i * n_words_], &z_[i * n_words_], &x_[j * n_words_],
+        &z_[j * n_words_], n_words_);
+  }
 
  private:
-  graphs::AdjacencyData m_adjacency_data;
-  VertexMap m_vertex_map;
+  std::size_t size_;
+  std::size_t n_words_;
+  std::vector<std::uint64_t> x_;
+  std::vector<std::uint64_t> z_;
 };
 
-std::size_t AbstractGraphData::get_vertex_id(
-    const QubitPauliString& pauli_string) {
-  const auto citer = m_vertex_map.find(pauli_string);
-  if (citer != m_vertex_map.cend()) {
-    return citer->second;
+PackedPauliStrings::PackedPauliStrings(
+    const std::vector<QubitPauliString>& strings)
+    : size_(strings.size()) {
+  std::set<Qubit> qubit_set;
+  for (const QubitPauliString& qps : strings) {
+    for (const std::pair<const Qubit, Pauli>& qp : qps.map) {
+      qubit_set.insert(qp.first);
+    }
+  }
+  const qubit_index_t index =
+      make_qubit_index(qubit_vector_t(qubit_set.cbegin(), qubit_set.cend()));
+  n_words_ = symplectic::number_of_words(index.size());
+  x_.reserve(size_ * n_words_);
+  z_.reserve(size_ * n_words_);
+  for (const QubitPauliString& qps : strings) {
+    const SymplecticPauliTensor spt = to_symplectic(qps, index);
+    TKET_ASSERT(spt.get_x_words().size() == n_words_);
+    x_.insert(x_.end(), spt.get_x_words().cbegin(), spt.get_x_words().cend());
+    z_.insert(z_.end(), spt.get_z_words().cbegin(), spt.get_z_words().cend());
   }
-  // Haven't seen this vertex before!
-  const auto new_id = m_vertex_map.size();
-  m_vertex_map[pauli_string] = new_id;
-  return new_id;
 }
 
-const AbstractGraphData::VertexMap& AbstractGraphData::get_vertex_map() const {
-  return m_vertex_map;
+}  // namespace
+
+// Call "f" with the adjacency test for the strategy, so that the
+// strategy is resolved once rather than for every pair of strings.
+template <typename Function>
+static auto with_adjacency(
+    const PackedPauliStrings& packed, PauliPartitionStrat strat, Function f) {
+  switch (strat) {
+    case PauliPartitionStrat::NonConflictingSets:
+      return f([&packed](std::size_t i, std::size_t j) {
+        return packed.conflict(i, j);
+      });
+    case PauliPartitionStrat::CommutingSets:
+      return f([&packed](std::size_t i, std::size_t j) {
+        return packed.anticommute(i, j);
+      });
+    default:
+      throw UnknownPauliPartitionStrat();
+  }
 }
 
-const graphs::AdjacencyData& AbstractGraphData::get_adjacency_data() const {
-  return m_adjacency_data;
+// Rows are handed out to the threads in blocks.
+// Within a block the columns are swept in tiles, so that the words of
+// a tile's strings stay in cache while all the rows are tested on them.
+static constexpr std::size_t row_block_size = 64;
+static constexpr std::size_t column_tile_size = 512;
+
+// Using several threads is only worthwhile if there are at least
+// this many strings.
+static constexpr std::size_t min_strings_for_threads = 1024;
+
+// Element[i] lists, in increasing order, the j > i adjacent to i.
+template <typename Adjacent>
+static std::vector<std::vector<graphs::CSRGraph::vertex_t>>
+get_upper_neighbours(
+    std::size_t n_strings, const Adjacent& adjacent,
+    unsigned max_number_of_threads) {
+  std::vector<std::vector<graphs::CSRGraph::vertex_t>> upper_neighbours(
+      n_strings);
+  const std::size_t n_blocks =
+      (n_strings + row_block_size - 1) / row_block_size;
+  if (n_strings < min_strings_for_threads) {
+    max_number_of_threads = 1;
+  }
+
+  // Each row is written by exactly one task, so no further
+  // synchronisation is needed.
+  parallel_for(
+      n_blocks, max_number_of_threads, [&](std::size_t block, unsigned) {
+        const std::size_t row_begin = block * row_block_size;
+        const std::size_t row_end =
+            std::min(row_begin + row_block_size, n_strings);
+        for (std::size_t col_begin = row_begin + 1; col_begin < n_strings;
+             col_begin += column_tile_size) {
+          const std::size_t col_end =
+              std::min(col_begin + column_tile_size, n_strings);
+          for (std::size_t i = row_begin; i < row_end; ++i) {
+            for (std::size_t j = std::max(col_begin, i + 1); j < col_end;
+                 ++j) {
+              if (adjacent(i, j)) {
+                upper_neighbours[i].push_back(
+                    static_cast<graphs::CSRGraph::vertex_t>(j));
+              }
+            }
+          }
+        }
+      });
+  return upper_neighbours;
 }
 
-AbstractGraphData::AbstractGraphData(const PauliACGraph& pac_graph)
-    : m_adjacency_data(boost::num_vertices(pac_graph)) {
-  const auto vertex_iterators = boost::vertices(pac_graph);
-  for (auto v_iter = vertex_iterators.first; v_iter != vertex_iterators.second;
-       ++v_iter) {
-    // NOTE: on Windows, *v_iter appears to be of type uint64,
-    // but presumably this is an internal Boost implementation detail
-    // and we cannot rely on this.
-    // (It might even be that the Boost vertex IDs are contiguous,
-    // just like ours, in which case this conversion
-    // is unnecessary - but again, we cannot rely on this).
-    const auto this_vertex_id = get_vertex_id(pac_graph[*v_iter]);
-    const auto neighbour_iterators =
-        boost::adjacent_vertices(*v_iter, pac_graph);
-
-    for (auto n_iter = neighbour_iterators.first;
-         n_iter != neighbour_iterators.second; ++n_iter) {
-      m_adjacency_data.add_edge(
-          this_vertex_id, get_vertex_id(pac_graph[*n_iter]));
-    }
-  }
+PauliPartitionerGraph::PauliPartitionerGraph(
+    const std::list<QubitPauliString>& strings, PauliPartitionStrat strat,
+    unsigned max_number_of_threads)
+    : strings_(strings.cbegin(), strings.cend()),
+      max_number_of_threads_(max_number_of_threads) {
+  const PackedPauliStrings packed(strings_);
+  graph_ = graphs::CSRGraph(
+      with_adjacency(packed, strat, [&](const auto& adjacent) {
+        return get_upper_neighbours(
+            strings_.size(), adjacent, max_number_of_threads);
+      }));
 }
 
 static std::map<unsigned, std::list<QubitPauliString>>
-get_partitioned_paulis_for_exhaustive_method(const PauliACGraph& pac_graph) {
-  const AbstractGraphData data(pac_graph);
+get_partitioned_paulis_for_exhaustive_method(
+    const std::vector<QubitPauliString>& strings,
+    const graphs::CSRGraph& graph) {
   const graphs::GraphColouringResult colouring =
-      graphs::GraphColouringRoutines ::get_colouring(data.get_adjacency_data());
+      graphs::GraphColouringRoutines::get_colouring(graph);
 
-  TKET_ASSERT(data.get_vertex_map().size() == colouring.colours.size());
+  TKET_ASSERT(strings.size() == colouring.colours.size());
 
   std::map<unsigned, std::list<QubitPauliString>> colour_map;
 
-  for (const auto& entry : data.get_vertex_map()) {
-    const QubitPauliString& vertex = entry.first;
-    const size_t id = entry.second;
-    TKET_ASSERT(id < colouring.colours.size());
-
-    // "id" is the index of this vertex.
-    const size_t colour = colouring.colours[id];
+  for (std::size_t v = 0; v < strings.size(); ++v) {
+    const size_t colour = colouring.colours[v];
     TKET_ASSERT(colour < colouring.number_of_colours);
-
-    colour_map[colour].push_back(vertex);
+    colour_map[colour].push_back(strings[v]);
   }
   if (!colour_map.empty()) {
     TKET_ASSERT(colour_map.size() == 1 + colour_map.crbegin()->first);
@@ -153,32 +188,26 @@ get_partitioned_paulis_for_exhaustive_method(const PauliACGraph& pac_graph) {
   return colour_map;
 }
 
-static std::map<unsigned, std::list<QubitPauliString>>
-get_partitioned_paulis_for_largest_first_method(const PauliACGraph& pac_graph) {
-  std::vector<unsigned> order_vec(boost::num_vertices(pac_graph));
+static graphs::GraphColouringResult get_largest_first_colouring(
+    const graphs::CSRGraph& graph) {
+  std::vector<std::size_t> order_vec(graph.get_number_of_vertices());
   std::iota(order_vec.begin(), order_vec.end(), 0);
 
-  std::sort(order_vec.begin(), order_vec.end(), [&](unsigned i, unsigned j) {
-    return (boost::out_degree(i, pac_graph) > boost::out_degree(j, pac_graph));
-  });
-
-  /* Some boost machinery */
-  std::vector<unsigned> colour_vec(boost::num_vertices(pac_graph));
-  boost::iterator_property_map<
-      unsigned*,
-      boost::property_map<PauliACGraph, boost::vertex_index_t>::const_type>
-      colour_prop_map(
-          &colour_vec.front(), boost::get(boost::vertex_index, pac_graph));
-  boost::sequential_vertex_coloring(
-      pac_graph,
-      boost::make_iterator_property_map(
-          order_vec.begin(), boost::identity_property_map()),
-      colour_prop_map);
+  std::stable_sort(
+      order_vec.begin(), order_vec.end(), [&](std::size_t i, std::size_t j) {
+        return graph.get_degree(i) > graph.get_degree(j);
+      });
+  return graphs::GraphColouringRoutines::get_greedy_colouring(graph, order_vec);
+}
 
+static std::map<unsigned, std::list<QubitPauliString>>
+get_partitioned_paulis_for_greedy_colouring(
+    const std::vector<QubitPauliString>& strings,
+    const graphs::GraphColouringResult& colouring) {
+  TKET_ASSERT(strings.size() == colouring.colours.size());
   std::map<unsigned, std::list<QubitPauliString>> colour_map;
-  BGL_FORALL_VERTICES(v, pac_graph, PauliACGraph) {
-    unsigned v_colour = colour_prop_map[v];
-    colour_map[v_colour].push_back(pac_graph[v]);
+  for (std::size_t v = 0; v < strings.size(); ++v) {
+    colour_map[colouring.colours[v]].push_back(strings[v]);
   }
   return colour_map;
 }
@@ -187,10 +216,22 @@ std::map<unsigned, std::list<QubitPauliString>>
 PauliPartitionerGraph::partition_paulis(GraphColourMethod method) const {
   switch (method) {
     case GraphColourMethod::LargestFirst:
-      return get_partitioned_paulis_for_largest_first_method(pac_graph);
+      return get_partitioned_paulis_for_greedy_colouring(
+          strings_, get_largest_first_colouring(graph_));
 
     case GraphColourMethod::Exhaustive:
-      return get_partitioned_paulis_for_exhaustive_method(pac_graph);
+      return get_partitioned_paulis_for_exhaustive_method(strings_, graph_);
+
+    case GraphColourMethod::DSatur:
+      return get_partitioned_paulis_for_greedy_colouring(
+          strings_,
+          graphs::GraphColouringRoutines::get_dsatur_colouring(graph_));
+
+    case GraphColourMethod::JonesPlassmann:
+      return get_partitioned_paulis_for_greedy_colouring(
+          strings_,
+          graphs::GraphColouringRoutines::get_jones_plassmann_colouring(
+              graph_, max_number_of_threads_));
 
     case GraphColourMethod::Lazy:
       throw std::logic_error(
@@ -205,46 +246,36 @@ PauliPartitionerGraph::partition_paulis(GraphColourMethod method) const {
 static std::list<std::list<QubitPauliString>>
 get_term_sequence_for_lazy_colouring_method(
     const std::list<QubitPauliString>& strings, PauliPartitionStrat strat) {
-  std::list<std::list<QubitPauliString>> terms;
-  for (const QubitPauliString& qpt : strings) {
-    if (terms.empty()) {
-      terms.push_back({qpt});
-      continue;
-    }
-
-    bool found_bin = false;
-    for (std::list<std::list<QubitPauliString>>::iterator term_iter =
-             terms.begin();
-         term_iter != terms.end(); ++term_iter) {
-      const std::list<QubitPauliString>& qpt_list = *term_iter;
-      bool viable_bin = true;
-      for (const QubitPauliString& qpt2 : qpt_list) {
-        switch (strat) {
-          case (PauliPartitionStrat::NonConflictingSets): {
-            bool conflict = !qpt.conflicting_qubits(qpt2).empty();
-            if (conflict) viable_bin = false;
-            break;
-          }
-          case (PauliPartitionStrat::CommutingSets): {
-            if (!qpt.commutes_with(qpt2)) viable_bin = false;
-            break;
-          }
-          default: {
-            throw UnknownPauliPartitionStrat();
+  const std::vector<QubitPauliString> string_vec(
+      strings.cbegin(), strings.cend());
+  const PackedPauliStrings packed(string_vec);
+
+  // Each string goes into the first bin containing nothing adjacent to it.
+  const std::vector<std::vector<std::size_t>> bins = with_adjacency(
+      packed, strat, [&](const auto& adjacent) {
+        std::vector<std::vector<std::size_t>> result;
+        for (std::size_t i = 0; i < string_vec.size(); ++i) {
+          auto bin = std::find_if(
+              result.begin(), result.end(),
+              [&](const std::vector<std::size_t>& members) {
+                return std::none_of(
+                    members.cbegin(), members.cend(),
+                    [&](std::size_t j) { return adjacent(i, j); });
+              });
+          if (bin == result.end()) {
+            result.push_back({i});
+          } else {
+            bin->push_back(i);
           }
         }
+        return result;
+      });
 
-        if (viable_bin == false) break;
-      }
-      if (viable_bin) {
-        term_iter->push_back(qpt);
-        found_bin = true;
-        break;
-      }
-    }
-
-    if (found_bin == false) {
-      terms.push_back({qpt});
+  std::list<std::list<QubitPauliString>> terms;
+  for (const std::vector<std::size_t>& members : bins) {
+    std::list<QubitPauliString>& term = terms.emplace_back();
+    for (std::size_t i : members) {
+      term.push_back(string_vec[i]);
     }
   }
   return terms;
@@ -276,6 +307,10 @@ std::list<std::list<QubitPauliString>> term_sequence(
     case GraphColourMethod::LargestFirst:
       // Deliberate fall through
     case GraphColourMethod::Exhaustive:
+      // Deliberate fall through
+    case GraphColourMethod::DSatur:
+      // Deliberate fall through
+    case GraphColourMethod::JonesPlassmann:
       return get_term_sequence_with_constructed_dependency_graph(
           strings, strat, method);
     default:
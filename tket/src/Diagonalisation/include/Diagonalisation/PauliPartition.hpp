@@ -15,6 +15,7 @@
 #pragma once
 
 #include "DiagUtils.hpp"
+#include "Graphs/CSRGraph.hpp"
 
 namespace tket {
 
@@ -26,17 +27,6 @@ class UnknownPauliPartitionStrat : public std::logic_error {
             "Pauli tensors.") {}
 };
 
-/**
- * A PauliACGraph is a graph where each vertex is a Pauli tensor, and
- * an edge corresponds to anticommuting tensors
- */
-
-typedef boost::adjacency_list<
-    boost::vecS, boost::vecS, boost::undirectedS, QubitPauliString>
-    PauliACGraph;
-
-typedef boost::graph_traits<PauliACGraph>::vertex_descriptor PauliACVertex;
-
 /**
  * A choice of strategies to partition Pauli tensors into sets
  */
@@ -73,24 +63,55 @@ enum class GraphColourMethod {
    * number of colours. Exponential time in the worst case,
    * but usually returns a result in reasonable time.
    */
-  Exhaustive
+  Exhaustive,
+  /**
+   * Builds the graph, then greedily colours by DSATUR: always colouring
+   * next the vertex whose neighbours already use the most colours.
+   * Usually fewer colours than LargestFirst, in O(E log V) time.
+   */
+  DSatur,
+  /**
+   * Builds the graph, then colours it in parallel by the Jones-Plassmann
+   * algorithm, with largest-degree-first priorities. Suitable for very
+   * large sets of tensors.
+   */
+  JonesPlassmann
 };
 
 /**
- * A helper class for converting QubitOperator into PauliACGraphs and
- * then colouring the PauliACGraph using some method.
+ * A helper class for building the anticommutation (or conflict) graph of
+ * a set of Pauli strings, and then colouring it using some method.
+ *
+ * The strings are packed once into symplectic bit-words, so that each
+ * pairwise test is a few word operations, and the pairs are tested in
+ * parallel tiles. The graph is stored in compressed sparse row form,
+ * vertex i being the i'th string in the input order.
  */
 class PauliPartitionerGraph {
  public:
+  /**
+   * Build the graph.
+   * @param strings The Pauli strings.
+   * @param strat Whether the edges join conflicting or anticommuting strings.
+   * @param max_number_of_threads The largest number of threads to use,
+   *    here and for parallel colouring; zero means
+   *    get_default_number_of_threads().
+   */
   explicit PauliPartitionerGraph(
-      const std::list<QubitPauliString>& strings, PauliPartitionStrat strat);
+      const std::list<QubitPauliString>& strings, PauliPartitionStrat strat,
+      unsigned max_number_of_threads = 0);
 
   // KEY: the colour  VALUE: all the Pauli strings assigned that colour.
   std::map<unsigned, std::list<QubitPauliString>> partition_paulis(
       GraphColourMethod method) const;
 
+  /** The graph; vertex i is the i'th string passed to the constructor. */
+  const graphs::CSRGraph& get_graph() const { return graph_; }
+
  private:
-  PauliACGraph pac_graph;
+  std::vector<QubitPauliString> strings_;
+  graphs::CSRGraph graph_;
+  unsigned max_number_of_threads_;
 };
 
 /**
@@ -15,6 +15,7 @@
 #include "Gate.hpp"
 
 #include <algorithm>
+#include <mutex>
 #include <stdexcept>
 #include <tkrng/RNG.hpp>
 #include <vector>
@@ -262,6 +263,8 @@ static bool params_contain_nan(const std::vector<Expr>& params) {
 
 static double random_perturbation() {
   static RNG rng;
+  static std::mutex rng_mutex;
+  std::lock_guard<std::mutex> lock(rng_mutex);
   int a = rng.get_size_t(10);
   return (a - 5) * EPS;
 }
@@ -519,14 +522,32 @@ std::vector<Expr> Gate::get_params_reduced() const {
   return params;
 }
 
-std::vector<Expr> Gate::get_tk1_angles() const {
-  const Expr half =
-      SymEngine::div(SymEngine::integer(1), SymEngine::integer(2));
-  const Expr quarter =
-      SymEngine::div(SymEngine::integer(1), SymEngine::integer(4));
-  const Expr eighth =
-      SymEngine::div(SymEngine::integer(1), SymEngine::integer(8));
-  switch (get_type()) {
+// The TK1 angles are computed from the same table whether the parameters
+// are symbolic or numeric; only the scalar type differs.
+template <typename T>
+static T exact_fraction(int num, int den);
+
+template <>
+Expr exact_fraction<Expr>(int num, int den) {
+  return SymEngine::div(SymEngine::integer(num), SymEngine::integer(den));
+}
+
+template <>
+double exact_fraction<double>(int num, int den) {
+  return static_cast<double>(num) / den;
+}
+
+static Expr negated(const Expr& e) { return minus_times(e); }
+
+static double negated(double x) { return -x; }
+
+template <typename T>
+static std::vector<T> tk1_angles(
+    OpType type, const std::vector<T>& params, unsigned n_qubits) {
+  const T half = exact_fraction<T>(1, 2);
+  const T quarter = exact_fraction<T>(1, 4);
+  const T eighth = exact_fraction<T>(1, 8);
+  switch (type) {
     case OpType::noop: {
       return {0, 0, 0, 0};
     }
@@ -567,49 +588,58 @@ std::vector<Expr> Gate::get_tk1_angles() const {
       return {half, half, half, half};
     }
     case OpType::Rx: {
-      return {0, params_.at(0), 0, 0};
+      return {0, params.at(0), 0, 0};
     }
     case OpType::Ry: {
-      return {half, params_.at(0), -half, 0};
+      return {half, params.at(0), -half, 0};
     }
     case OpType::Rz:
     case OpType::PhaseGadget: {
-      return {0, 0, params_.at(0), 0};
+      return {0, 0, params.at(0), 0};
     }
     case OpType::U1: {
-      return {0, 0, params_.at(0), params_.at(0) / 2};
+      return {0, 0, params.at(0), params.at(0) / 2};
     }
     case OpType::U2: {
       return {
-          params_.at(0) + half, half, params_.at(1) - half,
-          (params_.at(0) + params_.at(1)) / 2};
+          params.at(0) + half, half, params.at(1) - half,
+          (params.at(0) + params.at(1)) / 2};
     }
     case OpType::U3: {
       return {
-          params_.at(1) + half, params_.at(0), params_.at(2) - half,
-          (params_.at(1) + params_.at(2)) / 2};
+          params.at(1) + half, params.at(0), params.at(2) - half,
+          (params.at(1) + params.at(2)) / 2};
     }
     case OpType::NPhasedX: {
-      if (n_qubits_ != 1) {
+      if (n_qubits != 1) {
         throw BadOpType(
             "OpType::NPhasedX can only be decomposed into a TK1 "
             "if it acts on a single qubit",
             OpType::NPhasedX);
       }
-      return {params_.at(1), params_.at(0), minus_times(params_.at(1)), 0};
+      return {params.at(1), params.at(0), negated(params.at(1)), 0};
     }
     case OpType::PhasedX: {
-      return {params_.at(1), params_.at(0), minus_times(params_.at(1)), 0};
+      return {params.at(1), params.at(0), negated(params.at(1)), 0};
     }
     case OpType::TK1: {
-      return {params_.at(0), params_.at(1), params_.at(2), 0};
+      return {params.at(0), params.at(1), params.at(2), 0};
     }
     default: {
-      throw BadOpType("Cannot compute TK1 angles", get_type());
+      throw BadOpType("Cannot compute TK1 angles", type);
     }
   }
 }
 
+std::vector<Expr> Gate::get_tk1_angles() const {
+  return tk1_angles(get_type(), params_, n_qubits_);
+}
+
+std::optional<std::vector<double>> Gate::get_tk1_angles_numeric() const {
+  if (!numeric_params_) return std::nullopt;
+  return tk1_angles(get_type(), *numeric_params_, n_qubits_);
+}
+
 std::vector<Expr> Gate::get_params() const { return params_; }
 
 SymSet Gate::free_symbols() const { return expr_free_symbols(get_params()); }
@@ -841,8 +871,30 @@ Eigen::MatrixXcd Gate::get_unitary() const {
   }
 }
 
+static std::optional<std::vector<double>> numeric_values(
+    const std::vector<Expr>& params) {
+  std::vector<double> values;
+  values.reserve(params.size());
+  for (const Expr& param : params) {
+    std::optional<double> value = eval_number(param);
+    if (!value) return std::nullopt;
+    values.push_back(*value);
+  }
+  return values;
+}
+
+static bool exact_values(const std::vector<Expr>& params) {
+  return std::none_of(params.begin(), params.end(), [](const Expr& e) {
+    return eval_real_double(e).has_value();
+  });
+}
+
 Gate::Gate(OpType type, const std::vector<Expr>& params, unsigned n_qubits)
-    : Op(type), params_(params), n_qubits_(n_qubits) {
+    : Op(type),
+      params_(params),
+      numeric_params_(numeric_values(params)),
+      exact_params_(exact_values(params)),
+      n_qubits_(n_qubits) {
   if (!is_gate_type(type)) {
     throw BadOpType(type);
   }
@@ -851,6 +903,10 @@ Gate::Gate(OpType type, const std::vector<Expr>& params, unsigned n_qubits)
   }
 }
 
-Gate::Gate() : Op(OpType::noop), params_() {}
+Gate::Gate()
+    : Op(OpType::noop),
+      params_(),
+      numeric_params_(std::vector<double>()),
+      exact_params_(true) {}
 
 }  // namespace tket
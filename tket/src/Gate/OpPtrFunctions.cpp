@@ -14,12 +14,108 @@
 
 #include "OpPtrFunctions.hpp"
 
+#include <bit>
+#include <boost/functional/hash.hpp>
+#include <cmath>
+#include <optional>
+#include <unordered_map>
+
 #include "Gate.hpp"
 #include "Ops/MetaOp.hpp"
 #include "SymTable.hpp"
 
 namespace tket {
 
+namespace {
+
+/**
+ * Identifies a gate whose parameters are all plain numbers, i.e. SymEngine
+ * Integer or RealDouble values. Such parameters are stored exactly, so two
+ * gates with equal keys have identical parameter expressions.
+ */
+struct NumericGateKey {
+  OpType type;
+  unsigned n_qubits;
+  /** For each parameter, whether it is an Integer, and its value's bits */
+  std::vector<std::pair<bool, std::uint64_t>> params;
+
+  bool operator==(const NumericGateKey &other) const = default;
+};
+
+struct NumericGateKeyHash {
+  std::size_t operator()(const NumericGateKey &key) const {
+    std::size_t seed = 0;
+    boost::hash_combine(seed, static_cast<unsigned>(key.type));
+    boost::hash_combine(seed, key.n_qubits);
+    boost::hash_range(seed, key.params.begin(), key.params.end());
+    return seed;
+  }
+};
+
+std::optional<NumericGateKey> get_numeric_key(
+    OpType type, const std::vector<Expr> &params, unsigned n_qubits) {
+  NumericGateKey key{type, n_qubits, {}};
+  key.params.reserve(params.size());
+  for (const Expr &param : params) {
+    const SymEngine::Basic &b = *param.get_basic();
+    double value;
+    if (SymEngine::is_a<SymEngine::RealDouble>(b)) {
+      value =
+          SymEngine::down_cast<const SymEngine::RealDouble &>(b).as_double();
+    } else if (SymEngine::is_a<SymEngine::Integer>(b)) {
+      std::optional<double> v = eval_expr(param);
+      // Only keep integers which are represented exactly
+      if (!v || std::abs(*v) >= 0x1p53) return std::nullopt;
+      value = *v;
+    } else {
+      return std::nullopt;
+    }
+    // NaN never equals itself, so should not be looked up
+    if (!std::isfinite(value)) return std::nullopt;
+    key.params.push_back(
+        {SymEngine::is_a<SymEngine::Integer>(b),
+         std::bit_cast<std::uint64_t>(value)});
+  }
+  return key;
+}
+
+/**
+ * Cache of interned numeric gates, one per thread.
+ *
+ * Large circuits contain many copies of a few gates (CX, H, Rz(0.25), ...),
+ * so each is constructed once and the immutable Op_ptr shared between all
+ * its uses. The cache stops growing once it holds max_size gates, so that
+ * circuits with many distinct angles do not keep them all alive.
+ *
+ * Gates are only shared between ops built on the same thread, since the
+ * reference counts of their parameter expressions are not atomic unless
+ * SymEngine is built thread-safe.
+ */
+class NumericGateCache {
+ public:
+  static NumericGateCache &get() {
+    thread_local NumericGateCache cache;
+    return cache;
+  }
+
+  Op_ptr get_gate(const NumericGateKey &key, const std::vector<Expr> &params) {
+    auto found = gates_.find(key);
+    if (found != gates_.end()) return found->second;
+    Op_ptr gate =
+        std::make_shared<const Gate>(key.type, params, key.n_qubits);
+    if (gates_.size() < max_size) gates_.emplace(key, gate);
+    return gate;
+  }
+
+  void clear() { gates_.clear(); }
+
+ private:
+  static constexpr std::size_t max_size = 1 << 16;
+  std::unordered_map<NumericGateKey, Op_ptr, NumericGateKeyHash> gates_;
+};
+
+}  // namespace
+
 Op_ptr get_op_ptr(OpType chosen_type, const Expr& param, unsigned n_qubits) {
   return get_op_ptr(chosen_type, std::vector<Expr>{param}, n_qubits);
 }
@@ -27,6 +123,12 @@ Op_ptr get_op_ptr(OpType chosen_type, const Expr& param, unsigned n_qubits) {
 Op_ptr get_op_ptr(
     OpType chosen_type, const std::vector<Expr>& params, unsigned n_qubits) {
   if (is_gate_type(chosen_type)) {
+    // Numeric parameters have no symbols to register
+    std::optional<NumericGateKey> key =
+        get_numeric_key(chosen_type, params, n_qubits);
+    if (key) {
+      return NumericGateCache::get().get_gate(*key, params);
+    }
     SymTable::register_symbols(expr_free_symbols(params));
     return std::make_shared<const Gate>(chosen_type, params, n_qubits);
   } else {
@@ -34,4 +136,6 @@ Op_ptr get_op_ptr(
   }
 }
 
+void clear_numeric_gate_cache() { NumericGateCache::get().clear(); }
+
 }  // namespace tket
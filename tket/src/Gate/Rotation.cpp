@@ -14,6 +14,9 @@
 
 #include "Rotation.hpp"
 
+#include <cmath>
+#include <tuple>
+
 #include "OpType/OpDesc.hpp"
 #include "OpType/OpType.hpp"
 #include "Utils/Expression.hpp"
@@ -22,14 +25,20 @@
 
 namespace tket {
 
+// The quaternion arithmetic below is shared by the symbolic and numeric
+// representations; only the scalar type differs. These overloads supply the
+// operations which differ between the two.
+
+static double atan2_bypi(double a, double b) {
+  if (std::abs(a) < EPS && std::abs(b) < EPS) return 0.;
+  return atan2(a, b) / PI;
+}
+
 static Expr atan2_bypi(const Expr &a, const Expr &b) {
   std::optional<double> va = eval_expr(a);
   std::optional<double> vb = eval_expr(b);
   if (va && vb) {
-    double vva = va.value();
-    double vvb = vb.value();
-    if (std::abs(vva) < EPS && std::abs(vvb) < EPS) return Expr(0.);
-    return atan2(vva, vvb) / PI;
+    return atan2_bypi(va.value(), vb.value());
   } else {
     // Convert symbolic zero to 0. This is a workaround for
     // https://github.com/symengine/symengine/issues/1875 .
@@ -40,19 +49,30 @@ static Expr atan2_bypi(const Expr &a, const Expr &b) {
   }
 }
 
+static double acos_bypi(double a) {
+  // avoid undefined values due to rounding
+  if (a >= 1.) return 0.;
+  if (a <= -1.) return 1.;
+  return acos(a) / PI;
+}
+
 static Expr acos_bypi(const Expr &a) {
   std::optional<double> va = eval_expr(a);
   if (va) {
-    double vva = va.value();
-    // avoid undefined values due to rounding
-    if (vva >= 1.) return 0.;
-    if (vva <= -1.) return 1.;
-    return acos(vva) / PI;
+    return acos_bypi(va.value());
   } else {
     return SymEngine::div(SymEngine::acos(a), SymEngine::pi);
   }
 }
 
+static bool is_0(double x) { return std::abs(x) < EPS; }
+
+static bool is_0(const Expr &e) { return approx_0(e); }
+
+static double expanded(double x) { return x; }
+
+static Expr expanded(const Expr &e) { return SymEngine::expand(e); }
+
 // SymEngine::div does not always spot when the numerator is a scalar multiple
 // of the denominator, for example in expressions like (-a + b) / (a - b) where
 // a and b are symbolic. This function picks out the common cases.
@@ -62,17 +82,29 @@ static Expr expr_div(const Expr &num, const Expr &den) {
   return SymEngine::div(num, den);
 }
 
-static std::tuple<Expr, Expr, Expr> xyx_angles_from_coeffs(
-    const Expr &s, const Expr &i, const Expr &j, const Expr &k) {
+// 2 * atan(i / s) / pi, if it can be computed reliably.
+static std::optional<double> two_atan_ratio_bypi(double i, double s) {
+  return 2 * atan(i / s) / PI;
+}
+
+static std::optional<Expr> two_atan_ratio_bypi(const Expr &i, const Expr &s) {
+  Expr u = expr_div(i, s);
+  if (!SymEngine::free_symbols(u).empty()) return std::nullopt;
+  return SymEngine::div(2 * SymEngine::atan(u), SymEngine::pi);
+}
+
+template <typename T>
+static std::tuple<T, T, T> xyx_angles_from_coeffs(
+    const T &s, const T &i, const T &j, const T &k) {
   // Handle exceptional cases first.
-  bool s_zero = approx_0(s);
-  bool s_one = approx_0(s - 1);
-  bool i_zero = approx_0(i);
-  bool i_one = approx_0(i - 1);
-  bool j_zero = approx_0(j);
-  bool j_one = approx_0(j - 1);
-  bool k_zero = approx_0(k);
-  bool k_one = approx_0(k - 1);
+  bool s_zero = is_0(s);
+  bool s_one = is_0(s - 1);
+  bool i_zero = is_0(i);
+  bool i_one = is_0(i - 1);
+  bool j_zero = is_0(j);
+  bool j_one = is_0(j - 1);
+  bool k_zero = is_0(k);
+  bool k_one = is_0(k - 1);
   if (i_zero && j_zero && k_zero) {
     if (s_one)
       return {0, 0, 0};
@@ -124,33 +156,90 @@ static std::tuple<Expr, Expr, Expr> xyx_angles_from_coeffs(
   // 2 * atan2(B, A).
   // Finally, note that u must be well-defined because we have already dealt
   // with all cases where s = 0.
-  if (approx_0(SymEngine::expand(i * j + s * k))) {
-    Expr u = expr_div(i, s);
-    if (SymEngine::free_symbols(u).empty()) {
-      Expr a = SymEngine::atan(u);
-      Expr q = 2 * atan2_bypi(j, s);
-      Expr two_a_by_pi = SymEngine::div(2 * a, SymEngine::pi);
-      return std::tuple<Expr, Expr, Expr>(two_a_by_pi, q, 0);
+  if (is_0(expanded(i * j + s * k))) {
+    std::optional<T> two_a_by_pi = two_atan_ratio_bypi(i, s);
+    if (two_a_by_pi) {
+      T q = 2 * atan2_bypi(j, s);
+      return std::tuple<T, T, T>(*two_a_by_pi, q, 0);
     }
-  } else if (approx_0(SymEngine::expand(i * j - s * k))) {
-    Expr u = expr_div(i, s);
-    if (SymEngine::free_symbols(u).empty()) {
-      Expr a = SymEngine::atan(u);
-      Expr q = 2 * atan2_bypi(j, s);
-      Expr two_a_by_pi = SymEngine::div(2 * a, SymEngine::pi);
-      return std::tuple<Expr, Expr, Expr>(0, q, two_a_by_pi);
+  } else if (is_0(expanded(i * j - s * k))) {
+    std::optional<T> two_a_by_pi = two_atan_ratio_bypi(i, s);
+    if (two_a_by_pi) {
+      T q = 2 * atan2_bypi(j, s);
+      return std::tuple<T, T, T>(0, q, *two_a_by_pi);
     }
   }
 
   // Now the general case.
-  Expr a = atan2_bypi(i, s);
-  Expr b = atan2_bypi(k, j);
-  Expr q = acos_bypi(SymEngine::expand(s * s + i * i - j * j - k * k));
-  return std::tuple<Expr, Expr, Expr>(a - b, q, a + b);
+  T a = atan2_bypi(i, s);
+  T b = atan2_bypi(k, j);
+  T q = acos_bypi(expanded(s * s + i * i - j * j - k * k));
+  return std::tuple<T, T, T>(a - b, q, a + b);
+}
+
+template <typename T>
+static std::tuple<T, T, T> pqp_angles_from_coeffs(
+    OpType p, OpType q, const T &s, const T &i, const T &j, const T &k) {
+  if (p == OpType::Rx && q == OpType::Ry) {
+    return xyx_angles_from_coeffs<T>(s, i, j, k);
+  } else if (p == OpType::Ry && q == OpType::Rx) {
+    return xyx_angles_from_coeffs<T>(s, j, i, -k);
+  } else if (p == OpType::Ry && q == OpType::Rz) {
+    return xyx_angles_from_coeffs<T>(s, j, k, i);
+  } else if (p == OpType::Rz && q == OpType::Ry) {
+    return xyx_angles_from_coeffs<T>(s, k, j, -i);
+  } else if (p == OpType::Rz && q == OpType::Rx) {
+    return xyx_angles_from_coeffs<T>(s, k, i, j);
+  } else if (p == OpType::Rx && q == OpType::Rz) {
+    return xyx_angles_from_coeffs<T>(s, i, k, -j);
+  } else {
+    throw std::logic_error("Axes must be a pair of X, Y, Z.");
+  }
+}
+
+// The quaternion product (s0 + i0 i + j0 j + k0 k) (s1 + i1 i + j1 j + k1 k).
+template <typename T>
+static std::tuple<T, T, T, T> quaternion_product(
+    const T &s0, const T &i0, const T &j0, const T &k0, const T &s1,
+    const T &i1, const T &j1, const T &k1) {
+  return {
+      expanded(s0 * s1 - i0 * i1 - j0 * j1 - k0 * k1),
+      expanded(s0 * i1 + i0 * s1 + j0 * k1 - k0 * j1),
+      expanded(s0 * j1 - i0 * k1 + j0 * s1 + k0 * i1),
+      expanded(s0 * k1 + i0 * j1 - j0 * i1 + k0 * s1)};
+}
+
+// Return (cos(a*pi/2), sin(a*pi/2)), exact if a is within EPS of an integer.
+static std::pair<double, double> cos_sin_halfpi_times(double a) {
+  double n = std::round(a);
+  if (std::abs(a - n) < EPS) {
+    static const double cos_table[4] = {1., 0., -1., 0.};
+    static const double sin_table[4] = {0., 1., 0., -1.};
+    unsigned r = static_cast<unsigned>(fmodn(n, 4));
+    return {cos_table[r], sin_table[r]};
+  }
+  return {cos(a * PI / 2), sin(a * PI / 2)};
 }
 
 Rotation::Rotation(OpType optype, Expr a)
-    : i_(0), j_(0), k_(0), optype_(optype), a_(a) {
+    : i_(0),
+      j_(0),
+      k_(0),
+      optype_(optype),
+      a_(a),
+      numeric_(false),
+      ds_(0.),
+      di_(0.),
+      dj_(0.),
+      dk_(0.),
+      da_(0.) {
+  // Exact integers and rationals stay symbolic, so that composing them
+  // gives exact angles as before.
+  std::optional<double> v = eval_real_double(a);
+  if (v) {
+    init_numeric(optype, *v);
+    return;
+  }
   if (equiv_0(a, 4)) {
     rep_ = Rep::id;
     s_ = 1;
@@ -181,13 +270,68 @@ Rotation::Rotation(OpType optype, Expr a)
   }
 }
 
+Rotation::Rotation(OpType optype, double a) {
+  init_numeric(optype, a);
+}
+
+void Rotation::init_numeric(OpType optype, double a) {
+  numeric_ = true;
+  optype_ = optype;
+  da_ = a;
+  di_ = dj_ = dk_ = 0.;
+  if (approx_eq(a, 0., 4)) {
+    rep_ = Rep::id;
+    ds_ = 1.;
+  } else if (approx_eq(a, 2., 4)) {
+    rep_ = Rep::minus_id;
+    ds_ = -1.;
+  } else {
+    rep_ = Rep::orth_rot;
+    double t;
+    std::tie(ds_, t) = cos_sin_halfpi_times(a);
+    switch (optype) {
+      case OpType::Rx:
+        di_ = t;
+        break;
+      case OpType::Ry:
+        dj_ = t;
+        break;
+      case OpType::Rz:
+        dk_ = t;
+        break;
+      default:
+        throw std::logic_error(
+            "Quaternions can only be constructed "
+            "from Rx, Ry or Rz rotations");
+    }
+  }
+}
+
+void Rotation::make_symbolic() {
+  if (!numeric_) return;
+  numeric_ = false;
+  if (rep_ == Rep::id) {
+    s_ = 1;
+    i_ = j_ = k_ = 0;
+  } else if (rep_ == Rep::minus_id) {
+    s_ = -1;
+    i_ = j_ = k_ = 0;
+  } else {
+    s_ = ds_;
+    i_ = di_;
+    j_ = dj_;
+    k_ = dk_;
+  }
+  a_ = da_;
+}
+
 std::optional<Expr> Rotation::angle(OpType optype) const {
   if (rep_ == Rep::id) {
     return Expr(0);
   } else if (rep_ == Rep::minus_id) {
     return Expr(2);
   } else if (rep_ == Rep::orth_rot && optype_ == optype) {
-    return a_;
+    return numeric_ ? Expr(da_) : a_;
   } else {
     return std::nullopt;
   }
@@ -199,27 +343,19 @@ std::tuple<Expr, Expr, Expr> Rotation::to_pqp(OpType p, OpType q) const {
   } else if (rep_ == Rep::minus_id) {
     return {Expr(2), Expr(0), Expr(0)};
   } else if (rep_ == Rep::orth_rot) {
+    Expr a = numeric_ ? Expr(da_) : a_;
     if (optype_ == p) {
-      return {a_, Expr(0), Expr(0)};
+      return {a, Expr(0), Expr(0)};
     } else if (optype_ == q) {
-      return {Expr(0), a_, Expr(0)};
+      return {Expr(0), a, Expr(0)};
     }
   }
-  if (p == OpType::Rx && q == OpType::Ry) {
-    return xyx_angles_from_coeffs(s_, i_, j_, k_);
-  } else if (p == OpType::Ry && q == OpType::Rx) {
-    return xyx_angles_from_coeffs(s_, j_, i_, -k_);
-  } else if (p == OpType::Ry && q == OpType::Rz) {
-    return xyx_angles_from_coeffs(s_, j_, k_, i_);
-  } else if (p == OpType::Rz && q == OpType::Ry) {
-    return xyx_angles_from_coeffs(s_, k_, j_, -i_);
-  } else if (p == OpType::Rz && q == OpType::Rx) {
-    return xyx_angles_from_coeffs(s_, k_, i_, j_);
-  } else if (p == OpType::Rx && q == OpType::Rz) {
-    return xyx_angles_from_coeffs(s_, i_, k_, -j_);
-  } else {
-    throw std::logic_error("Axes must be a pair of X, Y, Z.");
+  if (numeric_) {
+    auto [p1, q1, p2] =
+        pqp_angles_from_coeffs<double>(p, q, ds_, di_, dj_, dk_);
+    return {Expr(p1), Expr(q1), Expr(p2)};
   }
+  return pqp_angles_from_coeffs<Expr>(p, q, s_, i_, j_, k_);
 }
 
 // Table of compositions
@@ -253,6 +389,100 @@ static const std::map<
 };
 
 void Rotation::apply(const Rotation &other) {
+  if (numeric_ && other.numeric_) {
+    apply_numeric(other);
+  } else if (other.numeric_) {
+    Rotation other_symbolic = other;
+    other_symbolic.make_symbolic();
+    apply_symbolic(other_symbolic);
+  } else {
+    make_symbolic();
+    apply_symbolic(other);
+  }
+}
+
+void Rotation::apply_numeric(const Rotation &other) {
+  if (other.rep_ == Rep::id) return;
+
+  if (rep_ == Rep::id) {
+    *this = other;
+    return;
+  }
+
+  if (rep_ == Rep::minus_id) {
+    if (other.rep_ == Rep::minus_id) {
+      rep_ = Rep::id;
+      ds_ = 1.;
+      di_ = dj_ = dk_ = 0.;
+    } else {
+      rep_ = other.rep_;
+      optype_ = other.optype_;
+      da_ = other.da_ + 2;
+      ds_ = -other.ds_;
+      di_ = -other.di_;
+      dj_ = -other.dj_;
+      dk_ = -other.dk_;
+    }
+    return;
+  }
+
+  if (rep_ == Rep::orth_rot && other.rep_ == Rep::orth_rot) {
+    if (optype_ == other.optype_) {
+      da_ += other.da_;
+      if (approx_eq(da_, 0., 4)) {
+        rep_ = Rep::id;
+      } else if (approx_eq(da_, 0., 2)) {
+        rep_ = Rep::minus_id;
+      }
+    } else if (
+        (approx_eq(da_, 1., 4) || approx_eq(da_, -1., 4)) &&
+        (approx_eq(other.da_, 1., 4) || approx_eq(other.da_, -1., 4))) {
+      // We are in a subgroup of order 8
+      int m0 = approx_eq(da_, 1., 4) ? 1 : -1;
+      int m1 = approx_eq(other.da_, 1., 4) ? 1 : -1;
+      std::tie(optype_, da_) = product.at({optype_, m0, other.optype_, m1});
+    } else
+      rep_ = Rep::quat;
+  } else
+    rep_ = Rep::quat;
+
+  std::tie(ds_, di_, dj_, dk_) = quaternion_product<double>(
+      other.ds_, other.di_, other.dj_, other.dk_, ds_, di_, dj_, dk_);
+
+  if (rep_ == Rep::quat) {
+    // See if we can simplify the representation.
+    bool i_zero = std::abs(di_) < EPS;
+    bool j_zero = std::abs(dj_) < EPS;
+    bool k_zero = std::abs(dk_) < EPS;
+    if (i_zero && j_zero && k_zero) {
+      if (std::abs(ds_ - 1) < EPS) {
+        rep_ = Rep::id;
+        ds_ = 1.;
+      } else {
+        rep_ = Rep::minus_id;
+        ds_ = -1.;
+      }
+      di_ = dj_ = dk_ = 0.;
+    } else if (j_zero && k_zero) {
+      rep_ = Rep::orth_rot;
+      optype_ = OpType::Rx;
+      da_ = 2 * atan2_bypi(di_, ds_);
+      dj_ = dk_ = 0.;
+    } else if (k_zero && i_zero) {
+      rep_ = Rep::orth_rot;
+      optype_ = OpType::Ry;
+      da_ = 2 * atan2_bypi(dj_, ds_);
+      dk_ = di_ = 0.;
+    } else if (i_zero && j_zero) {
+      rep_ = Rep::orth_rot;
+      optype_ = OpType::Rz;
+      da_ = 2 * atan2_bypi(dk_, ds_);
+      di_ = dj_ = 0.;
+    }
+  }
+}
+
+void Rotation::apply_symbolic(const Rotation &other) {
   if (other.rep_ == Rep::id) return;
 
   if (rep_ == Rep::id) {
@@ -307,14 +537,8 @@ void Rotation::apply(const Rotation &other) {
   } else
     rep_ = Rep::quat;
 
-  Expr s1 = other.s_ * s_ - other.i_ * i_ - other.j_ * j_ - other.k_ * k_;
-  Expr i1 = other.s_ * i_ + other.i_ * s_ + other.j_ * k_ - other.k_ * j_;
-  Expr j1 = other.s_ * j_ - other.i_ * k_ + other.j_ * s_ + other.k_ * i_;
-  Expr k1 = other.s_ * k_ + other.i_ * j_ - other.j_ * i_ + other.k_ * s_;
-  s_ = SymEngine::expand(s1);
-  i_ = SymEngine::expand(i1);
-  j_ = SymEngine::expand(j1);
-  k_ = SymEngine::expand(k1);
+  std::tie(s_, i_, j_, k_) = quaternion_product<Expr>(
+      other.s_, other.i_, other.j_, other.k_, s_, i_, j_, k_);
 
   if (rep_ == Rep::quat) {
     // See if we can simplify the representation.
@@ -355,6 +579,12 @@ std::ostream &operator<<(std::ostream &os, const Rotation &q) {
     return os << "I";
   } else if (q.rep_ == Rotation::Rep::minus_id) {
     return os << "-I";
+  } else if (q.numeric_) {
+    if (q.rep_ == Rotation::Rep::orth_rot) {
+      return os << OpDesc(q.optype_).name() << "(" << q.da_ << ")";
+    }
+    return os << q.ds_ << " + " << q.di_ << " i + " << q.dj_ << " j + "
+              << q.dk_ << " k";
   } else if (q.rep_ == Rotation::Rep::orth_rot) {
     return os << OpDesc(q.optype_).name() << "(" << q.a_ << ")";
   } else {
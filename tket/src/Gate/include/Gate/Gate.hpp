@@ -49,6 +49,32 @@ class Gate : public Op {
    * @return a, b, c and a global phase
    */
   std::vector<Expr> get_tk1_angles() const;
+
+  /**
+   * Return the gate decomposition in terms of Rz(a)Rx(b)Rz(c), computed in
+   * floating point without any symbolic manipulation.
+   *
+   * @return a, b, c and a global phase, iff all parameters are numeric
+   */
+  std::optional<std::vector<double>> get_tk1_angles_numeric() const;
+
+  /**
+   * Return the parameter values, iff they are all plain numbers.
+   *
+   * These are evaluated once, on construction, so that numerical consumers
+   * (unitaries, squashing) need not go through SymEngine.
+   */
+  const std::optional<std::vector<double>> &get_numeric_params() const {
+    return numeric_params_;
+  }
+
+  /**
+   * Whether no parameter is a floating-point number.
+   *
+   * True for parameterless gates and for gates whose parameters are exact
+   * integers, rationals or symbolic expressions.
+   */
+  bool has_exact_params() const { return exact_params_; }
   std::vector<Expr> get_params() const override;
   std::vector<Expr> get_params_reduced() const override;
   SymSet free_symbols() const override;
@@ -85,6 +111,10 @@ class Gate : public Op {
  private:
   // vector of symbolic params
   const std::vector<Expr> params_;
+  /** Values of params_, if they are all plain numbers */
+  std::optional<std::vector<double>> numeric_params_;
+  /** Whether no element of params_ is a floating-point number */
+  bool exact_params_;
   unsigned n_qubits_; /**< Number of qubits, when not deducible from type */
 };
 
@@ -42,4 +42,12 @@ Op_ptr get_op_ptr(
     OpType chosen_type, const std::vector<Expr> &params = {},
     unsigned n_qubits = 0);
 
+/**
+ * Release the gates interned by @ref get_op_ptr on the calling thread
+ *
+ * Gates whose parameters are all plain numbers are built once per thread and
+ * shared between later requests. Ops already handed out remain valid.
+ */
+void clear_numeric_gate_cache();
+
 }  // namespace tket
@@ -25,16 +25,38 @@ class Rotation {
  public:
   /** Identity */
   Rotation()
-      : rep_(Rep::id), s_(1), i_(0), j_(0), k_(0), optype_(OpType::noop) {}
+      : rep_(Rep::id),
+        s_(1),
+        i_(0),
+        j_(0),
+        k_(0),
+        optype_(OpType::noop),
+        numeric_(true),
+        ds_(1.),
+        di_(0.),
+        dj_(0.),
+        dk_(0.),
+        da_(0.) {}
 
   /**
    * Represent an X, Y or Z rotation
    *
+   * If the angle is a floating-point number the rotation is handled
+   * numerically; exact integer and rational angles stay exact.
+   *
    * @param optype one of @ref OpType::Rx, @ref OpType::Ry or @ref OpType::Rz
    * @param a angle in half-turns
    */
   Rotation(OpType optype, Expr a);
 
+  /**
+   * Represent an X, Y or Z rotation by a numeric angle
+   *
+   * @param optype one of @ref OpType::Rx, @ref OpType::Ry or @ref OpType::Rz
+   * @param a angle in half-turns
+   */
+  Rotation(OpType optype, double a);
+
   /** Apply a second rotation */
   void apply(const Rotation& other);
 
@@ -89,6 +111,23 @@ class Rotation {
   // If rep_ == Rep::orth_rot, we represent the rotation as an axis and angle:
   OpType optype_;
   Expr a_;
+
+  // As long as every rotation applied has had a numeric angle, the quaternion
+  // and angle are held in the following doubles instead of the expressions
+  // above, which are then unused.
+  bool numeric_;
+  double ds_;
+  double di_;
+  double dj_;
+  double dk_;
+  double da_;
+
+  void init_numeric(OpType optype, double a);
+  void apply_numeric(const Rotation& other);
+  void apply_symbolic(const Rotation& other);
+
+  /** Convert a numeric rotation to the symbolic representation */
+  void make_symbolic();
 };
 
 /**
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "Utils/Expression.hpp"
 
 namespace tket {
@@ -30,6 +32,9 @@ void clear_symbol_table();
  *
  * When an operation is created using \p get_op_ptr, any symbols in its
  * parameters are added to a global registry of symbols.
+ *
+ * The registry is guarded by a mutex, so operations may be created (and
+ * circuits compiled) on several threads at once.
  */
 struct SymTable {
   /** Create a new symbol (not currently registered), and register it */
@@ -42,6 +47,7 @@ struct SymTable {
  private:
   friend void test_Ops::clear_symbol_table();
   static std::unordered_set<std::string> &get_registered_symbols();
+  static std::mutex &get_mutex();
 };
 
 }  // namespace tket
@@ -0,0 +1,70 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CSRGraph.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace tket::graphs {
+
+CSRGraph::CSRGraph() : offsets_(1, 0), neighbours_() {}
+
+CSRGraph::CSRGraph(const std::vector<std::vector<vertex_t>>& upper_neighbours)
+    : offsets_(upper_neighbours.size() + 1, 0), neighbours_() {
+  const std::size_t n_vertices = upper_neighbours.size();
+  if (n_vertices > std::numeric_limits<vertex_t>::max()) {
+    throw std::invalid_argument("CSRGraph: too many vertices");
+  }
+  // First count the degrees: each edge i-j with i < j contributes
+  // to both vertices.
+  std::vector<std::size_t> degrees(n_vertices, 0);
+  for (std::size_t i = 0; i < n_vertices; ++i) {
+    std::size_t previous = i;
+    for (vertex_t j : upper_neighbours[i]) {
+      if (j <= previous || j >= n_vertices) {
+        std::stringstream ss;
+        ss << "CSRGraph: invalid or unsorted neighbour " << j << " of vertex "
+           << i;
+        throw std::invalid_argument(ss.str());
+      }
+      previous = j;
+      ++degrees[j];
+    }
+    degrees[i] += upper_neighbours[i].size();
+  }
+  for (std::size_t v = 0; v < n_vertices; ++v) {
+    offsets_[v + 1] = offsets_[v] + degrees[v];
+  }
+  neighbours_.resize(offsets_[n_vertices]);
+
+  // Every lower neighbour of a vertex precedes every upper one. Visiting
+  // the vertices i in increasing order writes the lower neighbours of each
+  // j in increasing order too, so all the lists end up sorted.
+  std::vector<std::size_t> positions(offsets_.begin(), offsets_.end() - 1);
+  for (std::size_t i = 0; i < n_vertices; ++i) {
+    for (vertex_t j : upper_neighbours[i]) {
+      neighbours_[positions[j]++] = static_cast<vertex_t>(i);
+    }
+  }
+  for (std::size_t i = 0; i < n_vertices; ++i) {
+    std::copy(
+        upper_neighbours[i].cbegin(), upper_neighbours[i].cend(),
+        neighbours_.begin() + positions[i]);
+  }
+}
+
+}  // namespace tket::graphs
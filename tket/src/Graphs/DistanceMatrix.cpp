@@ -0,0 +1,85 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DistanceMatrix.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "Utils/ThreadPool.hpp"
+
+namespace tket::graphs {
+
+// Using several threads is only worthwhile if each one gets
+// at least this many breadth-first searches to do.
+static constexpr std::size_t min_sources_per_thread = 32;
+
+DistanceMatrix::DistanceMatrix()
+    : size_(0), distances_(), diameter_(0), connected_(true) {}
+
+DistanceMatrix::DistanceMatrix(
+    const std::vector<std::vector<std::size_t>>& neighbours,
+    unsigned max_number_of_threads)
+    : size_(neighbours.size()),
+      distances_(neighbours.size() * neighbours.size(), 0),
+      diameter_(0),
+      connected_(true) {
+  if (size_ > std::numeric_limits<distance_t>::max()) {
+    throw std::invalid_argument(
+        "DistanceMatrix: too many vertices for 16-bit distances");
+  }
+  const unsigned number_of_threads = get_number_of_threads(
+      size_ / min_sources_per_thread, max_number_of_threads);
+
+  // Each task is the search from one source, which writes only to the
+  // corresponding row, so no further synchronisation is needed.
+  std::vector<std::vector<std::size_t>> queues(number_of_threads);
+  std::vector<std::vector<bool>> seens(number_of_threads);
+  std::vector<unsigned> diameters(number_of_threads, 0);
+  std::vector<char> all_connected(number_of_threads, 1);
+  parallel_for(
+      size_, number_of_threads,
+      [&](std::size_t source, unsigned thread_index) {
+        std::vector<std::size_t>& queue = queues[thread_index];
+        std::vector<bool>& seen = seens[thread_index];
+        queue.resize(size_);
+        seen.assign(size_, false);
+        distance_t* const dists = distances_.data() + source * size_;
+        seen[source] = true;
+        queue[0] = source;
+        std::size_t head = 0;
+        std::size_t tail = 1;
+        while (head < tail) {
+          const std::size_t v = queue[head++];
+          const distance_t next_distance = dists[v] + 1;
+          for (std::size_t w : neighbours[v]) {
+            if (seen[w]) continue;
+            seen[w] = true;
+            dists[w] = next_distance;
+            queue[tail++] = w;
+          }
+        }
+        if (tail < size_) all_connected[thread_index] = 0;
+        if (tail > 1) {
+          unsigned& diameter = diameters[thread_index];
+          diameter = std::max<unsigned>(diameter, dists[queue[tail - 1]]);
+        }
+      });
+  diameter_ = *std::max_element(diameters.begin(), diameters.end());
+  connected_ = std::all_of(
+      all_connected.begin(), all_connected.end(), [](char c) { return c; });
+}
+
+}  // namespace tket::graphs
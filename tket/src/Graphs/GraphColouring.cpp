@@ -23,6 +23,7 @@
 
 #include "AdjacencyData.hpp"
 #include "BruteForceColouring.hpp"
+#include "CSRGraph.hpp"
 #include "ColouringPriority.hpp"
 #include "GraphRoutines.hpp"
 #include "LargeCliquesResult.hpp"
@@ -183,5 +184,14 @@ GraphColouringResult GraphColouringRoutines::get_colouring(
   }
 }
 
+GraphColouringResult GraphColouringRoutines::get_colouring(
+    const CSRGraph& graph) {
+  vector<vector<std::size_t>> raw_data(graph.get_number_of_vertices());
+  for (std::size_t v = 0; v < raw_data.size(); ++v) {
+    raw_data[v].assign(graph.neighbours_begin(v), graph.neighbours_end(v));
+  }
+  return get_colouring(AdjacencyData(raw_data));
+}
+
 }  // namespace graphs
 }  // namespace tket
@@ -0,0 +1,226 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Greedy colouring routines for graphs in compressed sparse row form.
+
+#include "GraphColouring.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <tkassert/Assert.hpp>
+#include <tuple>
+#include <vector>
+
+#include "CSRGraph.hpp"
+#include "Utils/ThreadPool.hpp"
+
+using std::vector;
+
+namespace tket {
+namespace graphs {
+
+static constexpr std::size_t uncoloured =
+    std::numeric_limits<std::size_t>::max();
+
+GraphColouringResult GraphColouringRoutines::get_greedy_colouring(
+    const CSRGraph& graph, const vector<std::size_t>& order) {
+  const std::size_t n_vertices = graph.get_number_of_vertices();
+  TKET_ASSERT(order.size() == n_vertices);
+  vector<std::size_t> colours(n_vertices, uncoloured);
+
+  // used_by[c] == v means colour c is taken by a neighbour of vertex v,
+  // so the array never needs clearing between vertices.
+  vector<std::size_t> used_by(n_vertices + 1, uncoloured);
+  for (std::size_t v : order) {
+    TKET_ASSERT(v < n_vertices && colours[v] == uncoloured);
+    for (auto it = graph.neighbours_begin(v); it != graph.neighbours_end(v);
+         ++it) {
+      const std::size_t colour = colours[*it];
+      if (colour != uncoloured) used_by[colour] = v;
+    }
+    std::size_t colour = 0;
+    while (used_by[colour] == v) ++colour;
+    colours[v] = colour;
+  }
+  return GraphColouringResult(colours);
+}
+
+GraphColouringResult GraphColouringRoutines::get_dsatur_colouring(
+    const CSRGraph& graph) {
+  const std::size_t n_vertices = graph.get_number_of_vertices();
+  vector<std::size_t> colours(n_vertices, uncoloured);
+
+  // For each uncoloured vertex: element[c] is true if some neighbour
+  // has colour c. Its number of true entries is the saturation.
+  vector<vector<bool>> neighbour_colours(n_vertices);
+  vector<std::size_t> saturation(n_vertices, 0);
+  vector<std::size_t> uncoloured_degree(n_vertices);
+
+  // (saturation, uncoloured degree, N-1-v): the last element is the next
+  // vertex to colour, ties going to the lowest-numbered vertex.
+  typedef std::tuple<std::size_t, std::size_t, std::size_t> Key;
+  const auto get_key = [&](std::size_t v) {
+    return Key(saturation[v], uncoloured_degree[v], n_vertices - 1 - v);
+  };
+  std::set<Key> queue;
+  for (std::size_t v = 0; v < n_vertices; ++v) {
+    uncoloured_degree[v] = graph.get_degree(v);
+    queue.insert(get_key(v));
+  }
+
+  while (!queue.empty()) {
+    const auto last = std::prev(queue.end());
+    const std::size_t v = n_vertices - 1 - std::get<2>(*last);
+    queue.erase(last);
+
+    vector<bool>& used = neighbour_colours[v];
+    const std::size_t colour =
+        std::find(used.cbegin(), used.cend(), false) - used.cbegin();
+    colours[v] = colour;
+    vector<bool>().swap(used);
+
+    for (auto it = graph.neighbours_begin(v); it != graph.neighbours_end(v);
+         ++it) {
+      const std::size_t w = *it;
+      if (colours[w] != uncoloured) continue;
+      queue.erase(get_key(w));
+      --uncoloured_degree[w];
+      vector<bool>& w_used = neighbour_colours[w];
+      if (w_used.size() <= colour) w_used.resize(colour + 1, false);
+      if (!w_used[colour]) {
+        w_used[colour] = true;
+        ++saturation[w];
+      }
+      queue.insert(get_key(w));
+    }
+  }
+  return GraphColouringResult(colours);
+}
+
+// Work is shared out between the threads in chunks of this many items;
+// fewer items than this are processed by the calling thread alone.
+static constexpr std::size_t items_per_chunk = 1024;
+
+// Call f(begin, end, thread_index) on consecutive chunks covering
+// [0, n_items), on up to max_number_of_threads threads.
+template <typename Function>
+static void for_each_chunk(
+    std::size_t n_items, unsigned max_number_of_threads, const Function& f) {
+  const std::size_t n_chunks =
+      (n_items + items_per_chunk - 1) / items_per_chunk;
+  parallel_for(
+      n_chunks, max_number_of_threads,
+      [&](std::size_t chunk, unsigned thread_index) {
+        const std::size_t begin = chunk * items_per_chunk;
+        f(begin, std::min(begin + items_per_chunk, n_items), thread_index);
+      });
+}
+
+// A fixed pseudorandom tie-breaker (the SplitMix64 finaliser).
+static std::uint64_t get_vertex_hash(std::uint64_t v) {
+  v += 0x9e3779b97f4a7c15;
+  v = (v ^ (v >> 30)) * 0xbf58476d1ce4e5b9;
+  v = (v ^ (v >> 27)) * 0x94d049bb133111eb;
+  return v ^ (v >> 31);
+}
+
+GraphColouringResult GraphColouringRoutines::get_jones_plassmann_colouring(
+    const CSRGraph& graph, unsigned max_number_of_threads) {
+  const std::size_t n_vertices = graph.get_number_of_vertices();
+  if (max_number_of_threads == 0) {
+    max_number_of_threads = get_default_number_of_threads();
+  }
+  vector<std::uint64_t> hashes(n_vertices);
+  std::size_t max_degree = 0;
+  for (std::size_t v = 0; v < n_vertices; ++v) {
+    hashes[v] = get_vertex_hash(v);
+    max_degree = std::max(max_degree, graph.get_degree(v));
+  }
+  // Whether v has priority over w: a strict total order.
+  const auto precedes = [&](std::size_t v, std::size_t w) {
+    const std::size_t v_degree = graph.get_degree(v);
+    const std::size_t w_degree = graph.get_degree(w);
+    if (v_degree != w_degree) return v_degree > w_degree;
+    if (hashes[v] != hashes[w]) return hashes[v] > hashes[w];
+    return v < w;
+  };
+
+  // The number of higher-priority neighbours of each vertex
+  // which are still uncoloured.
+  vector<std::atomic<std::size_t>> n_waiting(n_vertices);
+  for_each_chunk(
+      n_vertices, max_number_of_threads,
+      [&](std::size_t begin, std::size_t end, unsigned) {
+        for (std::size_t v = begin; v < end; ++v) {
+          n_waiting[v].store(
+              std::count_if(
+                  graph.neighbours_begin(v), graph.neighbours_end(v),
+                  [&](std::size_t w) { return precedes(w, v); }),
+              std::memory_order_relaxed);
+        }
+      });
+
+  vector<std::size_t> frontier;
+  for (std::size_t v = 0; v < n_vertices; ++v) {
+    if (n_waiting[v].load(std::memory_order_relaxed) == 0) {
+      frontier.push_back(v);
+    }
+  }
+
+  // Each round colours the frontier: the vertices whose higher-priority
+  // neighbours are all coloured. No two of them are adjacent, and
+  // a vertex only reads the colours of its higher-priority neighbours,
+  // so they can all be coloured concurrently.
+  vector<std::size_t> colours(n_vertices, uncoloured);
+  vector<vector<std::size_t>> used_by(
+      max_number_of_threads, vector<std::size_t>(max_degree + 2, uncoloured));
+  vector<vector<std::size_t>> next_frontiers(max_number_of_threads);
+  while (!frontier.empty()) {
+    for_each_chunk(
+        frontier.size(), max_number_of_threads,
+        [&](std::size_t begin, std::size_t end, unsigned thread_index) {
+          vector<std::size_t>& used = used_by[thread_index];
+          vector<std::size_t>& next_frontier = next_frontiers[thread_index];
+          for (std::size_t i = begin; i < end; ++i) {
+            const std::size_t v = frontier[i];
+            for (auto it = graph.neighbours_begin(v);
+                 it != graph.neighbours_end(v); ++it) {
+              if (precedes(*it, v)) used[colours[*it]] = v;
+            }
+            std::size_t colour = 0;
+            while (used[colour] == v) ++colour;
+            colours[v] = colour;
+            for (auto it = graph.neighbours_begin(v);
+                 it != graph.neighbours_end(v); ++it) {
+              if (precedes(v, *it) && n_waiting[*it].fetch_sub(1) == 1) {
+                next_frontier.push_back(*it);
+              }
+            }
+          }
+        });
+    frontier.clear();
+    for (vector<std::size_t>& next_frontier : next_frontiers) {
+      frontier.insert(
+          frontier.end(), next_frontier.cbegin(), next_frontier.cend());
+      next_frontier.clear();
+    }
+  }
+  return GraphColouringResult(colours);
+}
+
+}  // namespace graphs
+}  // namespace tket
@@ -0,0 +1,78 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tket::graphs {
+
+/**
+ * An immutable undirected graph on the vertices 0,1,...,N-1, stored in
+ * compressed sparse row form: the neighbours of every vertex are held,
+ * in increasing order, in one contiguous array.
+ *
+ * This is much more compact than AdjacencyData (no per-vertex sets),
+ * and so is suitable for large, dense graphs such as those arising
+ * from partitioning many thousands of Pauli strings.
+ */
+class CSRGraph {
+ public:
+  /** Vertex indices are 32-bit, to halve the memory of dense graphs. */
+  using vertex_t = std::uint32_t;
+
+  /** A graph with no vertices. */
+  CSRGraph();
+
+  /**
+   * Build the graph from each vertex's higher-numbered neighbours;
+   * the edges j-i with j > i are deduced automatically.
+   * Throws if the data is invalid.
+   *
+   * @param upper_neighbours Element[i] lists, in strictly increasing order,
+   *    the vertices j > i adjacent to vertex i.
+   */
+  explicit CSRGraph(const std::vector<std::vector<vertex_t>>& upper_neighbours);
+
+  /** The number of vertices, N. */
+  std::size_t get_number_of_vertices() const { return offsets_.size() - 1; }
+
+  /** The number of edges (i-j and j-i counting as one edge). */
+  std::size_t get_number_of_edges() const { return neighbours_.size() / 2; }
+
+  /** The number of neighbours of the vertex. */
+  std::size_t get_degree(std::size_t vertex) const {
+    return offsets_[vertex + 1] - offsets_[vertex];
+  }
+
+  /** The first of the neighbours of the vertex, in increasing order. */
+  const vertex_t* neighbours_begin(std::size_t vertex) const {
+    return neighbours_.data() + offsets_[vertex];
+  }
+
+  /** One past the last of the neighbours of the vertex. */
+  const vertex_t* neighbours_end(std::size_t vertex) const {
+    return neighbours_.data() + offsets_[vertex + 1];
+  }
+
+ private:
+  // The neighbours of vertex v are neighbours_[offsets_[v]],...,
+  // neighbours_[offsets_[v+1]-1]; there are N+1 offsets.
+  std::vector<std::size_t> offsets_;
+  std::vector<vertex_t> neighbours_;
+};
+
+}  // namespace tket::graphs
@@ -21,11 +21,13 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <type_traits>
 
 #include "Graphs/AbstractGraph.hpp"
+#include "Graphs/DistanceMatrix.hpp"
 #include "Graphs/TreeSearch.hpp"
 #include "Graphs/Utils.hpp"
 #include "Utils/GraphHeaders.hpp"
@@ -402,24 +404,23 @@ class DirectedGraph : public DirectedGraphBase<T> {
 
   /**
    * Get all distances between nodes.
+   *
+   * Element[i] is the distance from root to the node with index i (see
+   * @ref get_node_index); a value of zero implies that the nodes are
+   * disconnected (unless they are equal).
+   *
+   * If the distances have been precomputed the row is read directly from
+   * the distance matrix; otherwise it is computed and cached per root. In
+   * either case the view stays valid until the graph is next modified.
    */
-  const std::vector<std::size_t>& get_distances(const T& root) const& {
-    // We cache distances. A value of zero in the cache implies that the nodes
-    // are disconnected (unless they are equal).
-    if (distance_cache.find(root) == distance_cache.end()) {
-      distance_cache[root] = Base::get_distances(root);
-    }
-    return distance_cache[root];
-  }
-
-  /**
-   * Get all distances between nodes.
-   */
-  std::vector<std::size_t>&& get_distances(const T& root) const&& {
-    if (distance_cache.find(root) == distance_cache.end()) {
-      distance_cache[root] = Base::get_distances(root);
+  DistanceRow get_distances(const T& root) const {
+    if (distance_matrix) {
+      return DistanceRow(
+          distance_matrix->row(get_node_index(root)), distance_matrix->size());
     }
-    return std::move(distance_cache[root]);
+    const std::vector<std::size_t>* cached = caches.distances(root);
+    if (cached) return DistanceRow(*cached);
+    return DistanceRow(caches.set_distances(root, Base::get_distances(root)));
   }
 
   unsigned get_distance(const T& node1, const T& node2) const override {
@@ -427,13 +428,18 @@ class DirectedGraph : public DirectedGraphBase<T> {
       return 0;
     }
     size_t d;
-    if (distance_cache.find(node1) != distance_cache.end()) {
-      d = distance_cache[node1][this->to_vertices(node2)];
-    } else if (distance_cache.find(node2) != distance_cache.end()) {
-      d = distance_cache[node2][this->to_vertices(node1)];
+    if (distance_matrix) {
+      if (!node_exists(node1) || !node_exists(node2)) {
+        throw NodeDoesNotExistError(
+            "Trying to get the distance between non-existent vertices");
+      }
+      d = (*distance_matrix)(
+          this->to_vertices(node1), this->to_vertices(node2));
     } else {
-      distance_cache[node1] = Base::get_distances(node1);
-      d = distance_cache[node1][this->to_vertices(node2)];
+      std::optional<std::size_t> cached =
+          caches.distance(node1, this->to_vertices(node2));
+      if (!cached) cached = caches.distance(node2, this->to_vertices(node1));
+      d = cached ? *cached : get_distances(node1)[this->to_vertices(node2)];
     }
     if (d == 0) {
       throw NodesNotConnected(node1, node2);
@@ -441,6 +447,56 @@ class DirectedGraph : public DirectedGraphBase<T> {
     return d;
   }
 
+  /**
+   * Compute the distances between all pairs of nodes up front.
+   *
+   * Afterwards @ref get_distance, @ref get_distances, @ref nodes_at_distance,
+   * @ref get_diameter and @ref get_undirected_connectivity only read state,
+   * so the graph may be shared between threads as long as it is not
+   * modified. Any modification discards the precomputed distances.
+   *
+   * @param max_number_of_threads The largest number of threads to use for
+   *    the breadth-first searches; zero means
+   *    get_default_number_of_threads().
+   */
+  void precompute_distances(unsigned max_number_of_threads = 0) {
+    const UndirectedConnGraph& g = get_undirected_connectivity();
+    std::vector<std::vector<std::size_t>> neighbours(boost::num_vertices(g));
+    for (std::size_t v = 0; v < neighbours.size(); ++v) {
+      auto [it, end] = boost::adjacent_vertices(v, g);
+      neighbours[v].assign(it, end);
+    }
+    distance_matrix = std::make_shared<const DistanceMatrix>(
+        neighbours, max_number_of_threads);
+    if (n_nodes() > 0 && distance_matrix->is_connected()) {
+      this->diameter_ = distance_matrix->get_diameter();
+    }
+  }
+
+  /** Whether @ref precompute_distances has been called since the last change */
+  bool distances_precomputed() const { return bool(distance_matrix); }
+
+  /**
+   * The precomputed distances, indexed by @ref get_node_index.
+   *
+   * @pre @ref precompute_distances has been called.
+   */
+  const DistanceMatrix& get_distance_matrix() const {
+    if (!distance_matrix) {
+      throw std::logic_error("Distances have not been precomputed.");
+    }
+    return *distance_matrix;
+  }
+
+  /** The dense index, from 0 to N-1, of a node. */
+  std::size_t get_node_index(const T& node) const {
+    if (!node_exists(node)) {
+      throw NodeDoesNotExistError(
+          "Trying to get the index of a non-existent vertex");
+    }
+    return this->to_vertices(node);
+  }
+
   unsigned get_diameter() override {
     unsigned N = n_nodes();
     if (N == 0) {
@@ -461,7 +517,7 @@ class DirectedGraph : public DirectedGraphBase<T> {
 
   /** Returns all nodes at a given distance from a given 'source' node */
   std::vector<T> nodes_at_distance(const T& root, std::size_t distance) const {
-    auto dists = get_distances(root);
+    const DistanceRow dists = get_distances(root);
     std::vector<T> out;
     for (unsigned i = 0; i < dists.size(); ++i) {
       if (dists[i] == distance) {
@@ -474,18 +530,12 @@ class DirectedGraph : public DirectedGraphBase<T> {
   /** Return an unweighted undirected graph with the same connectivity. */
   const UndirectedConnGraph& get_undirected_connectivity() const& {
     // we cache the undirected graph
-    if (!undir_graph) {
-      undir_graph = Base::get_undirected_connectivity();
-    }
-    return undir_graph.value();
+    return caches.undirected(*this);
   }
 
   /** Return an unweighted undirected graph with the same connectivity. */
   UndirectedConnGraph&& get_undirected_connectivity() const&& {
-    if (!undir_graph) {
-      undir_graph = Base::get_undirected_connectivity();
-    }
-    return std::move(undir_graph.value());
+    return std::move(caches.undirected(*this));
   }
 
   // The following functions invalidate caching.
@@ -528,11 +578,76 @@ class DirectedGraph : public DirectedGraphBase<T> {
 
  private:
   inline void invalidate_cache() {
-    distance_cache.clear();
-    undir_graph = std::nullopt;
+    caches.clear();
+    distance_matrix.reset();
+    this->diameter_ = std::nullopt;
   }
-  mutable std::map<T, std::vector<std::size_t>> distance_cache;
-  mutable std::optional<UndirectedConnGraph> undir_graph;
+
+  /**
+   * Results computed lazily by const methods: the distances from each root
+   * asked about so far, when they have not been precomputed, and the
+   * undirected graph. Access is guarded by a mutex so that const methods
+   * remain safe to call concurrently; copies take a snapshot of the contents.
+   */
+  class LazyCaches {
+   public:
+    LazyCaches() {}
+    LazyCaches(const LazyCaches& other) {
+      std::lock_guard<std::mutex> lock(other.mutex_);
+      distances_ = other.distances_;
+      undirected_ = other.undirected_;
+    }
+    LazyCaches& operator=(const LazyCaches& other) {
+      if (this != &other) {
+        std::scoped_lock lock(mutex_, other.mutex_);
+        distances_ = other.distances_;
+        undirected_ = other.undirected_;
+      }
+      return *this;
+    }
+    // Entries are only erased by clear(), on modification, so the pointer
+    // stays valid for const callers.
+    const std::vector<std::size_t>* distances(const T& root) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = distances_.find(root);
+      if (it == distances_.end()) return nullptr;
+      return &it->second;
+    }
+    std::optional<std::size_t> distance(const T& root, std::size_t index) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = distances_.find(root);
+      if (it == distances_.end()) return std::nullopt;
+      return it->second[index];
+    }
+    // The breadth-first search is done by the caller, outside the lock, so
+    // two threads may race to store the same distances; either copy will do.
+    const std::vector<std::size_t>& set_distances(
+        const T& root, std::vector<std::size_t> dists) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return distances_.try_emplace(root, std::move(dists)).first->second;
+    }
+    // Once computed the undirected graph is not replaced until the next
+    // modification, so the reference stays valid for const callers.
+    UndirectedConnGraph& undirected(const Base& graph) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!undirected_) {
+        undirected_ = graph.get_undirected_connectivity();
+      }
+      return *undirected_;
+    }
+    void clear() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      distances_.clear();
+      undirected_ = std::nullopt;
+    }
+
+   private:
+    mutable std::mutex mutex_;
+    std::map<T, std::vector<std::size_t>> distances_;
+    std::optional<UndirectedConnGraph> undirected_;
+  };
+  mutable LazyCaches caches;
+  std::shared_ptr<const DistanceMatrix> distance_matrix;
 };
 
 }  // namespace tket::graphs
@@ -0,0 +1,135 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tket::graphs {
+
+/**
+ * All-pairs shortest path lengths of an unweighted, undirected graph,
+ * stored as a flat row-major matrix of 16-bit distances.
+ *
+ * Vertices are identified by dense indices 0,1,...,N-1. As for the
+ * distances returned by DirectedGraph::get_distances, a value of zero
+ * between distinct vertices means that they are disconnected.
+ *
+ * The matrix is computed eagerly by one breadth-first search per vertex,
+ * spread over several threads, and is immutable afterwards, so it may be
+ * read concurrently from any number of threads.
+ */
+class DistanceMatrix {
+ public:
+  using distance_t = std::uint16_t;
+
+  /** An empty matrix, for a graph with no vertices. */
+  DistanceMatrix();
+
+  /**
+   * Compute all distances.
+   *
+   * @param neighbours Element[v] lists the neighbours of vertex v; the
+   *    adjacency must be symmetric.
+   * @param max_number_of_threads The largest number of threads to use;
+   *    zero means get_default_number_of_threads().
+   */
+  explicit DistanceMatrix(
+      const std::vector<std::vector<std::size_t>>& neighbours,
+      unsigned max_number_of_threads = 0);
+
+  /** Number of vertices N. */
+  std::size_t size() const { return size_; }
+
+  /** Distance between vertices i and j (zero if disconnected). */
+  distance_t operator()(std::size_t i, std::size_t j) const {
+    return distances_[i * size_ + j];
+  }
+
+  /** Pointer to the N distances from vertex i. */
+  const distance_t* row(std::size_t i) const {
+    return distances_.data() + i * size_;
+  }
+
+  /** Largest distance between two connected vertices. */
+  unsigned get_diameter() const { return diameter_; }
+
+  /** Whether every pair of vertices is connected. */
+  bool is_connected() const { return connected_; }
+
+ private:
+  std::size_t size_;
+  std::vector<distance_t> distances_;
+  unsigned diameter_;
+  bool connected_;
+};
+
+/**
+ * Read-only view of the distances from one vertex to every vertex.
+ *
+ * It refers either to a row of a @ref DistanceMatrix or to a vector of
+ * distances found by a single breadth-first search, and is only valid as
+ * long as the storage it refers to.
+ */
+class DistanceRow {
+ public:
+  /** View of N distances stored in a @ref DistanceMatrix. */
+  DistanceRow(const DistanceMatrix::distance_t* row, std::size_t size)
+      : narrow_(row), wide_(nullptr), size_(size) {}
+
+  /** View of the distances held in a vector. */
+  explicit DistanceRow(const std::vector<std::size_t>& row)
+      : narrow_(nullptr), wide_(row.data()), size_(row.size()) {}
+
+  /** Number of vertices N. */
+  std::size_t size() const { return size_; }
+
+  /** Distance to vertex i (zero if disconnected). */
+  std::size_t operator[](std::size_t i) const {
+    return narrow_ ? narrow_[i] : wide_[i];
+  }
+
+  friend bool operator==(const DistanceRow& a, const DistanceRow& b) {
+    return a.visit([&](auto a_begin, auto a_end) {
+      return b.visit([&](auto b_begin, auto b_end) {
+        return std::equal(a_begin, a_end, b_begin, b_end);
+      });
+    });
+  }
+
+  /** Lexicographic comparison. */
+  friend bool operator<(const DistanceRow& a, const DistanceRow& b) {
+    return a.visit([&](auto a_begin, auto a_end) {
+      return b.visit([&](auto b_begin, auto b_end) {
+        return std::lexicographical_compare(a_begin, a_end, b_begin, b_end);
+      });
+    });
+  }
+
+ private:
+  // Call f with the begin and end pointers of whichever storage is in use.
+  template <typename F>
+  bool visit(F&& f) const {
+    return narrow_ ? f(narrow_, narrow_ + size_) : f(wide_, wide_ + size_);
+  }
+
+  const DistanceMatrix::distance_t* narrow_;
+  const std::size_t* wide_;
+  std::size_t size_;
+};
+
+}  // namespace tket::graphs
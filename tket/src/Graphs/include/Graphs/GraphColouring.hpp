@@ -22,6 +22,7 @@ namespace tket {
 namespace graphs {
 
 class AdjacencyData;
+class CSRGraph;
 
 /**
  * The calculated colouring for a graph.
@@ -63,6 +64,49 @@ struct GraphColouringRoutines {
    */
   static GraphColouringResult get_colouring(
       const AdjacencyData& adjacency_data);
+
+  /**
+   * As above, for a graph in compressed form; it is converted
+   * to AdjacencyData internally.
+   * @param graph The graph to be coloured.
+   */
+  static GraphColouringResult get_colouring(const CSRGraph& graph);
+
+  /**
+   * Colour greedily: visit the vertices in the given order, giving each
+   * the smallest colour not already used by one of its neighbours.
+   * Linear time in the size of the graph, but the number of colours
+   * is usually not optimal.
+   * @param graph The graph to be coloured.
+   * @param order A permutation of the vertices, giving the visiting order.
+   */
+  static GraphColouringResult get_greedy_colouring(
+      const CSRGraph& graph, const std::vector<std::size_t>& order);
+
+  /**
+   * Colour greedily by DSATUR: repeatedly colour the vertex whose
+   * neighbours already use the most distinct colours, breaking ties
+   * by the number of uncoloured neighbours. Usually uses fewer colours
+   * than a fixed order, and is optimal for bipartite graphs.
+   * O(E log V) time.
+   * @param graph The graph to be coloured.
+   */
+  static GraphColouringResult get_dsatur_colouring(const CSRGraph& graph);
+
+  /**
+   * Colour greedily in parallel by the Jones-Plassmann algorithm.
+   * Vertices are prioritised by degree (ties broken by a fixed
+   * pseudorandom hash), and each is given the smallest colour unused by
+   * its higher-priority neighbours as soon as they are all coloured;
+   * the vertices ready at any one time are independent, and are coloured
+   * concurrently. The result is the largest-first greedy colouring for
+   * that priority order, independent of the number of threads.
+   * @param graph The graph to be coloured.
+   * @param max_number_of_threads The largest number of threads to use;
+   *    zero means get_default_number_of_threads().
+   */
+  static GraphColouringResult get_jones_plassmann_colouring(
+      const CSRGraph& graph, unsigned max_number_of_threads = 0);
 };
 
 }  // namespace graphs
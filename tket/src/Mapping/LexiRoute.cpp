@@ -70,12 +70,12 @@ bool LexiRoute::assign_at_distance(
   }
   if (valid_nodes.size() > 1) {
     auto it = valid_nodes.begin();
-    lexicographical_distances_t winning_distances =
+    graphs::DistanceRow winning_distances =
         this->architecture_->get_distances(*it);
     Node preserved_node = *it;
     ++it;
     for (; it != valid_nodes.end(); ++it) {
-      lexicographical_distances_t comparison_distances =
+      graphs::DistanceRow comparison_distances =
           this->architecture_->get_distances(*it);
       if (comparison_distances < winning_distances) {
         preserved_node = *it;
@@ -125,12 +125,12 @@ bool LexiRoute::update_labelling() {
         std::set<Node> max_degree_nodes =
             this->architecture_->max_degree_nodes();
         auto it = max_degree_nodes.begin();
-        lexicographical_distances_t winning_distances =
+        graphs::DistanceRow winning_distances =
             this->architecture_->get_distances(*it);
         Node preserved_node = Node(*it);
         ++it;
         for (; it != max_degree_nodes.end(); ++it) {
-          lexicographical_distances_t comparison_distances =
+          graphs::DistanceRow comparison_distances =
               this->architecture_->get_distances(*it);
           if (comparison_distances < winning_distances) {
             preserved_node = Node(*it);
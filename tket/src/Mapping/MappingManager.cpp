@@ -15,6 +15,7 @@
 #include "Mapping/MappingManager.hpp"
 
 #include "Architecture/BestTsaWithArch.hpp"
+#include "Utils/ThreadPool.hpp"
 
 namespace tket {
 
@@ -159,4 +160,27 @@ bool MappingManager::route_circuit_with_maps(
 
   return circuit_modified;
 }
-}  // namespace tket
\ No newline at end of file
+
+std::vector<bool> MappingManager::route_circuits(
+    std::vector<Circuit>& circuits,
+    const std::vector<RoutingMethodPtr>& routing_methods,
+    bool label_isolated_qubits, unsigned max_number_of_threads) const {
+  // After this, routing only reads the architecture, so it can be shared.
+  if (!this->architecture_->distances_precomputed()) {
+    this->architecture_->precompute_distances(max_number_of_threads);
+  }
+  // Circuits share Exprs, which can only be copied on several threads at
+  // once with a thread-safe SymEngine.
+  if (!exprs_thread_safe()) max_number_of_threads = 1;
+  // Circuits are taken from a shared counter, so that threads which happen
+  // to get small circuits go on to take more of them. Results go to
+  // per-circuit slots, so threads never write to the same element.
+  std::vector<char> modified(circuits.size(), 0);
+  parallel_for(
+      circuits.size(), max_number_of_threads, [&](std::size_t i, unsigned) {
+        modified[i] = this->route_circuit(
+            circuits[i], routing_methods, label_isolated_qubits);
+      });
+  return {modified.begin(), modified.end()};
+}
+}  // namespace tket
@@ -38,7 +38,9 @@ class LexiRoute {
  public:
   /**
    * Class Constructor
-   * @param _architecture Architecture object added operations must respect
+   * @param _architecture Architecture object added operations must respect;
+   * if Architecture::precompute_distances has been called, distances are
+   * read from its distance matrix and it may be shared between threads
    * @param _mapping_frontier Contains Circuit object to be modified
    */
   LexiRoute(
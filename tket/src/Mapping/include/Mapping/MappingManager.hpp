@@ -75,6 +75,39 @@ class MappingManager {
       std::shared_ptr<unit_bimaps_t> maps,
       bool label_isolated_qubits = true) const;
 
+  /**
+   * route_circuits
+   * Each referenced Circuit is modified exactly as by route_circuit, with
+   * the circuits shared out dynamically between several threads. Each
+   * thread routes one whole circuit at a time, with its own MappingFrontier
+   * and routing method scratch state; only this->architecture_ and the
+   * RoutingMethod objects are shared.
+   *
+   * If this->architecture_ has not precomputed its distances, they are
+   * precomputed before any thread starts, after which the Architecture is
+   * only read. It must not be used elsewhere during the call.
+   *
+   * If routing some circuit throws, the remaining circuits are still
+   * routed, and the exception from the first such circuit is rethrown.
+   *
+   * Unless SymEngine was built thread-safe (see exprs_thread_safe), the
+   * circuits are routed one at a time.
+   *
+   * @param circuits Circuits to be routed
+   * @param routing_methods Ranked RoutingMethod objects to use for routing
+   * segments.
+   * @param label_isolated_qubits will not label qubits without gates or only
+   * single qubit gates on them if this is set false
+   * @param max_number_of_threads Largest number of threads to use; zero
+   * means get_default_number_of_threads()
+   * @return For each circuit, true if it was modified
+   */
+  std::vector<bool> route_circuits(
+      std::vector<Circuit>& circuits,
+      const std::vector<RoutingMethodPtr>& routing_methods,
+      bool label_isolated_qubits = true,
+      unsigned max_number_of_threads = 0) const;
+
  private:
   ArchitecturePtr architecture_;
 };
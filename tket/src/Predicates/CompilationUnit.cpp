@@ -45,9 +45,19 @@ TypePredicatePair CompilationUnit::make_type_pair(const PredicatePtr& ptr) {
 }
 
 bool CompilationUnit::calc_predicate(const Predicate& pred) const {
-  return pred.verify(circ_);
+  std::optional<bool> result = pred.verify_summary(get_summary());
+  return result ? *result : pred.verify(circ_);
 }
 
+const CircuitSummary& CompilationUnit::get_summary() const {
+  if (!summary_ || &summary_->get_circ() != &circ_) {
+    summary_ = std::make_shared<const CircuitSummary>(circ_);
+  }
+  return *summary_;
+}
+
+void CompilationUnit::circuit_changed() const { summary_.reset(); }
+
 bool CompilationUnit::check_all_predicates() const {
   for (const TypePredicatePair& ref_pred : target_preds) {
     if (!calc_predicate(*ref_pred.second)) return false;
@@ -98,7 +98,7 @@ void BasePass::update_cache(
     }
   }
   for (const TypePredicatePair& pp : postcons_.specific_postcons_) {
-    if (safe_mode == SafetyMode::Audit && !pp.second->verify(c_unit.circ_))
+    if (safe_mode == SafetyMode::Audit && !c_unit.calc_predicate(*pp.second))
       throw UnsatisfiedPredicate(pp.second->to_string());
     std::pair<PredicatePtr, bool> cache_pair{pp.second, true};
     c_unit.cache_[pp.first] = cache_pair;
@@ -183,6 +183,33 @@ PassConditions BasePass::match_passes(
   return {new_precons, new_postcons};
 }
 
+void BasePass::invoke_callback(
+    const PassCallback& callback, const CompilationUnit& c_unit) const {
+  typedef void (*callback_fn_t)(const CompilationUnit&, const nlohmann::json&);
+  const callback_fn_t* fn = callback.target<callback_fn_t>();
+  if (fn != nullptr && *fn == trivial_callback) return;
+  callback(c_unit, this->get_config());
+}
+
+// Number of live ApplyScopes on this thread
+static thread_local unsigned current_apply_depth = 0;
+
+unsigned BasePass::apply_depth() { return current_apply_depth; }
+
+BasePass::ApplyScope::ApplyScope(
+    const BasePass& pass, const CompilationUnit& c_unit,
+    const PassCallback& before_apply) {
+  ++current_apply_depth;
+  try {
+    pass.invoke_callback(before_apply, c_unit);
+  } catch (...) {
+    --current_apply_depth;
+    throw;
+  }
+}
+
+BasePass::ApplyScope::~ApplyScope() { --current_apply_depth; }
+
 PassConditions BasePass::match_passes(const PassPtr& lhs, const PassPtr& rhs) {
   return match_passes(lhs->get_conditions(), rhs->get_conditions());
 }
@@ -190,7 +217,7 @@ PassConditions BasePass::match_passes(const PassPtr& lhs, const PassPtr& rhs) {
 bool StandardPass::apply(
     CompilationUnit& c_unit, SafetyMode safe_mode,
     const PassCallback& before_apply, const PassCallback& after_apply) const {
-  before_apply(c_unit, this->get_config());
+  const ApplyScope scope(*this, c_unit, before_apply);
   std::optional<PredicatePtr> unsatisfied_precon =
       unsatisfied_precondition(c_unit, safe_mode);
   if (unsatisfied_precon)
@@ -199,8 +226,9 @@ bool StandardPass::apply(
             ->to_string());  // just raise warning in super-unsafe mode
   // Allow trans_ to update the initial and final map
   bool changed = trans_.apply_fn(c_unit.circ_, c_unit.maps);
+  c_unit.circuit_changed();
   update_cache(c_unit, safe_mode);
-  after_apply(c_unit, this->get_config());
+  invoke_callback(after_apply, c_unit);
   return changed;
 }
 
@@ -281,14 +309,14 @@ RepeatWithMetricPass::RepeatWithMetricPass(
 bool RepeatWithMetricPass::apply(
     CompilationUnit& c_unit, SafetyMode safe_mode,
     const PassCallback& before_apply, const PassCallback& after_apply) const {
-  before_apply(c_unit, this->get_config());
+  const ApplyScope scope(*this, c_unit, before_apply);
   bool success = false;
   unsigned currentVal = metric_(c_unit.get_circ_ref());
   CompilationUnit* c_unit_current = &c_unit;
   CompilationUnit c_unit_new = c_unit;
-  pass_->apply(
-      c_unit_new, safe_mode);  // I can't make it apply the pass to a copy
-                               // without copying the whole CompilationUnit
+  // I can't make it apply the pass to a copy
+  // without copying the whole CompilationUnit
+  pass_->apply(c_unit_new, safe_mode, before_apply, after_apply);
   unsigned newVal = metric_(c_unit_new.get_circ_ref());
   while (newVal < currentVal) {
     c_unit_current = &c_unit_new;
@@ -298,7 +326,7 @@ bool RepeatWithMetricPass::apply(
     newVal = metric_(c_unit_new.get_circ_ref());
   }
   if (&c_unit != c_unit_current) c_unit = *c_unit_current;
-  after_apply(c_unit, this->get_config());
+  invoke_callback(after_apply, c_unit);
   return success;
 }
 
@@ -326,13 +354,13 @@ RepeatUntilSatisfiedPass::RepeatUntilSatisfiedPass(
 bool RepeatUntilSatisfiedPass::apply(
     CompilationUnit& c_unit, SafetyMode safe_mode,
     const PassCallback& before_apply, const PassCallback& after_apply) const {
-  before_apply(c_unit, this->get_config());
+  const ApplyScope scope(*this, c_unit, before_apply);
   bool success = false;
-  while (!pred_->verify(c_unit.get_circ_ref())) {
+  while (!c_unit.calc_predicate(*pred_)) {
     pass_->apply(c_unit, safe_mode, before_apply, after_apply);
     success = true;
   }
-  after_apply(c_unit, this->get_config());
+  invoke_callback(after_apply, c_unit);
   return success;
 }
 
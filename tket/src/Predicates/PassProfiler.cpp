@@ -0,0 +1,182 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "PassProfiler.hpp"
+
+#include <ctime>
+#include <map>
+
+#include <tkassert/Assert.hpp>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace tket {
+
+namespace {
+
+double thread_cpu_time_us() {
+#if defined(_WIN32)
+  return 1e6 * static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#else
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return 1e6 * static_cast<double>(ts.tv_sec) +
+         1e-3 * static_cast<double>(ts.tv_nsec);
+#endif
+}
+
+// Peak resident set size of the process so far, in kB (0 if unavailable).
+long peak_rss_kb() {
+#if defined(_WIN32)
+  return 0;
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+  return usage.ru_maxrss / 1024;  // reported in bytes
+#else
+  return usage.ru_maxrss;
+#endif
+#endif
+}
+
+std::string pass_name(const nlohmann::json& config) {
+  const std::string pass_class = config.at("pass_class").get<std::string>();
+  if (pass_class == "StandardPass") {
+    return config.at("StandardPass").at("name").get<std::string>();
+  }
+  return pass_class;
+}
+
+}  // namespace
+
+PassProfiler::PassProfiler() : epoch_set_(false) {}
+
+PassCallback PassProfiler::before_apply() {
+  return [this](const CompilationUnit& c_unit, const nlohmann::json& config) {
+    start(c_unit, config);
+  };
+}
+
+PassCallback PassProfiler::after_apply() {
+  return [this](const CompilationUnit& c_unit, const nlohmann::json&) {
+    finish(c_unit);
+  };
+}
+
+void PassProfiler::clear() {
+  open_.clear();
+  records_.clear();
+  epoch_set_ = false;
+}
+
+void PassProfiler::start(
+    const CompilationUnit& c_unit, const nlohmann::json& config) {
+  const clock_t::time_point now = clock_t::now();
+  if (!epoch_set_) {
+    epoch_ = now;
+    epoch_set_ = true;
+  }
+  // Applications abandoned by an exception never reached finish
+  const unsigned depth = BasePass::apply_depth();
+  if (depth > 0 && open_.size() >= depth) {
+    open_.erase(open_.begin() + (depth - 1), open_.end());
+  }
+  if (!open_.empty()) ++open_.back().record.iterations;
+  OpenRecord open;
+  open.record.name = pass_name(config);
+  open.record.depth = open_.size();
+  open.record.start_us =
+      std::chrono::duration<double, std::micro>(now - epoch_).count();
+  open.record.wall_us = 0.;
+  open.record.cpu_us = 0.;
+  open.record.gates_before = c_unit.get_circ_ref().n_gates();
+  open.record.gates_after = 0;
+  open.record.peak_rss_growth_kb = 0;
+  open.record.iterations = 0;
+  open.wall_start = now;
+  open.cpu_start_us = thread_cpu_time_us();
+  open.peak_rss_start_kb = peak_rss_kb();
+  open_.push_back(std::move(open));
+}
+
+void PassProfiler::finish(const CompilationUnit& c_unit) {
+  const clock_t::time_point now = clock_t::now();
+  const double cpu_now_us = thread_cpu_time_us();
+  TKET_ASSERT(!open_.empty());
+  OpenRecord& open = open_.back();
+  Record& record = open.record;
+  record.wall_us =
+      std::chrono::duration<double, std::micro>(now - open.wall_start)
+          .count();
+  record.cpu_us = cpu_now_us - open.cpu_start_us;
+  record.gates_after = c_unit.get_circ_ref().n_gates();
+  record.peak_rss_growth_kb = peak_rss_kb() - open.peak_rss_start_kb;
+  records_.push_back(std::move(record));
+  open_.pop_back();
+}
+
+nlohmann::json PassProfiler::to_chrome_trace() const {
+  nlohmann::json events = nlohmann::json::array();
+  for (const Record& record : records_) {
+    nlohmann::json event;
+    event["name"] = record.name;
+    event["cat"] = "pass";
+    event["ph"] = "X";
+    event["ts"] = record.start_us;
+    event["dur"] = record.wall_us;
+    event["pid"] = 0;
+    event["tid"] = 0;
+    event["args"]["cpu_us"] = record.cpu_us;
+    event["args"]["gates_before"] = record.gates_before;
+    event["args"]["gates_after"] = record.gates_after;
+    event["args"]["peak_rss_growth_kb"] = record.peak_rss_growth_kb;
+    event["args"]["iterations"] = record.iterations;
+    events.push_back(std::move(event));
+  }
+  nlohmann::json j;
+  j["traceEvents"] = std::move(events);
+  j["displayTimeUnit"] = "ms";
+  return j;
+}
+
+nlohmann::json PassProfiler::to_json() const {
+  struct Totals {
+    unsigned calls = 0;
+    double wall_us = 0.;
+    double cpu_us = 0.;
+    long gate_change = 0;
+  };
+  std::map<std::string, Totals> totals;
+  for (const Record& record : records_) {
+    Totals& t = totals[record.name];
+    ++t.calls;
+    t.wall_us += record.wall_us;
+    t.cpu_us += record.cpu_us;
+    t.gate_change += static_cast<long>(record.gates_after) -
+                     static_cast<long>(record.gates_before);
+  }
+  nlohmann::json j = nlohmann::json::object();
+  for (const auto& [name, t] : totals) {
+    j[name]["calls"] = t.calls;
+    j[name]["wall_us"] = t.wall_us;
+    j[name]["cpu_us"] = t.cpu_us;
+    j[name]["gate_change"] = t.gate_change;
+  }
+  return j;
+}
+
+}  // namespace tket
@@ -95,6 +95,14 @@ bool GateSetPredicate::verify(const Circuit& circ) const {
   return true;
 }
 
+std::optional<bool> GateSetPredicate::verify_summary(
+    const CircuitSummary& summary) const {
+  for (OpType type : summary.get_gate_types()) {
+    if (!find_in_set(type, allowed_types_)) return false;
+  }
+  return true;
+}
+
 bool GateSetPredicate::implies(const Predicate& other) const {
   try {
     const GateSetPredicate& other_p =
@@ -151,6 +159,15 @@ bool NoClassicalControlPredicate::verify(const Circuit& circ) const {
   return true;
 }
 
+std::optional<bool> NoClassicalControlPredicate::verify_summary(
+    const CircuitSummary& summary) const {
+  if (summary.contains(OpType::CircBox) ||
+      summary.contains(OpType::CustomGate)) {
+    return std::nullopt;
+  }
+  return !summary.contains(OpType::Conditional);
+}
+
 bool NoClassicalControlPredicate::implies(const Predicate& other) const {
   return auto_implication(*this, other);
 }
@@ -219,6 +236,12 @@ bool NoFastFeedforwardPredicate::verify(const Circuit& circ) const {
   return true;
 }
 
+std::optional<bool> NoFastFeedforwardPredicate::verify_summary(
+    const CircuitSummary& summary) const {
+  if (summary.get_circ().n_bits() == 0) return true;
+  return !summary.get_command_data().fast_feedforward;
+}
+
 bool NoFastFeedforwardPredicate::implies(const Predicate& other) const {
   return auto_implication(*this, other);
 }
@@ -275,6 +298,11 @@ bool MaxTwoQubitGatesPredicate::verify(const Circuit& circ) const {
   return true;
 }
 
+std::optional<bool> MaxTwoQubitGatesPredicate::verify_summary(
+    const CircuitSummary& summary) const {
+  return summary.get_max_gate_qubits() <= 2;
+}
+
 bool MaxTwoQubitGatesPredicate::implies(const Predicate& other) const {
   return auto_implication(*this, other);
 }
@@ -330,6 +358,47 @@ bool ConnectivityPredicate::verify(const Circuit& circ) const {
   return respects_connectivity_constraints(circ, arch_, false, true);
 }
 
+// Decide respects_connectivity_constraints from the summary, unless there
+// are CircBoxes, whose contents would have to be examined.
+static std::optional<bool> respects_connectivity_constraints(
+    const CircuitSummary& summary, const Architecture& arch, bool directed,
+    bool bridge_allowed) {
+  const CircuitSummary::CommandData& data = summary.get_command_data();
+  if (data.circ_boxes) return std::nullopt;
+  for (const Qubit& qb : summary.get_circ().all_qubits()) {
+    if (!arch.node_exists(Node(qb))) return false;
+  }
+  if (data.other_arity_ops) return false;
+  for (const auto& [q0, q1] : data.interactions) {
+    if (arch.get_distance(Node(q0), Node(q1)) != 1) return false;
+  }
+  if (directed) {
+    for (const auto& [q0, q1] : data.cx_interactions) {
+      if (!arch.edge_exists(Node(q0), Node(q1))) return false;
+    }
+  }
+  if (!data.bridges.empty()) {
+    if (!bridge_allowed) return false;
+    if (directed) {
+      throw std::logic_error(
+          "BRIDGE ops are disallowed on a directed "
+          "architecture. They must be decomposed.");
+    }
+    for (const auto& [q0, q1, q2] : data.bridges) {
+      if (arch.get_distance(Node(q0), Node(q1)) != 1 ||
+          arch.get_distance(Node(q1), Node(q2)) != 1) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+std::optional<bool> ConnectivityPredicate::verify_summary(
+    const CircuitSummary& summary) const {
+  return respects_connectivity_constraints(summary, arch_, false, true);
+}
+
 bool ConnectivityPredicate::implies(const Predicate& other) const {
   try {
     const ConnectivityPredicate& other_c =
@@ -390,6 +459,11 @@ bool DirectednessPredicate::verify(const Circuit& circ) const {
   return respects_connectivity_constraints(circ, arch_, true, false);
 }
 
+std::optional<bool> DirectednessPredicate::verify_summary(
+    const CircuitSummary& summary) const {
+  return respects_connectivity_constraints(summary, arch_, true, false);
+}
+
 bool DirectednessPredicate::implies(const Predicate& other) const {
   try {
     const DirectednessPredicate& other_c =
@@ -448,6 +522,11 @@ bool CliffordCircuitPredicate::verify(const Circuit& circ) const {
   return true;
 }
 
+std::optional<bool> CliffordCircuitPredicate::verify_summary(
+    const CircuitSummary& summary) const {
+  return summary.is_clifford();
+}
+
 bool CliffordCircuitPredicate::implies(const Predicate& other) const {
   return auto_implication(*this, other);
 }
@@ -535,6 +614,15 @@ bool NoBarriersPredicate::verify(const Circuit& circ) const {
   return true;
 }
 
+std::optional<bool> NoBarriersPredicate::verify_summary(
+    const CircuitSummary& summary) const {
+  if (summary.contains(OpType::CircBox) ||
+      summary.contains(OpType::CustomGate)) {
+    return std::nullopt;
+  }
+  return !summary.contains(OpType::Barrier);
+}
+
 bool NoBarriersPredicate::implies(const Predicate& other) const {
   return auto_implication(*this, other);
 }
@@ -600,6 +688,75 @@ static bool mid_measure_helper(const Command& com, unit_set_t& measured_units) {
   }
 }
 
+CircuitSummary::CircuitSummary(const Circuit& circ)
+    : circ_(circ), max_gate_qubits_(0) {
+  BGL_FORALL_VERTICES(v, circ.dag, DAG) {
+    Op_ptr op = circ.get_Op_ptr_from_Vertex(v);
+    OpType type = op->get_type();
+    ++op_type_counts_[type];
+    if (type != OpType::Barrier) {
+      max_gate_qubits_ = std::max(
+          max_gate_qubits_, circ.n_in_edges_of_type(v, EdgeType::Quantum));
+    }
+    if (op->get_desc().is_meta()) continue;
+    if (type == OpType::Conditional) {
+      type = static_cast<const Conditional&>(*op).get_op()->get_type();
+    }
+    gate_types_.insert(type);
+  }
+}
+
+bool CircuitSummary::is_clifford() const {
+  if (clifford_) return *clifford_;
+  clifford_ = true;
+  BGL_FORALL_VERTICES(v, circ_.dag, DAG) {
+    if (!circ_.get_Op_ptr_from_Vertex(v)->is_clifford()) {
+      clifford_ = false;
+      break;
+    }
+  }
+  return *clifford_;
+}
+
+const CircuitSummary::CommandData& CircuitSummary::get_command_data() const {
+  if (command_data_) return *command_data_;
+  CommandData data;
+  unit_set_t measured_units;
+  bit_vector_t all_bits = circ_.all_bits();
+  unit_set_t unset_bits = {all_bits.begin(), all_bits.end()};
+  for (const Command& com : circ_) {
+    if (!data.mid_measure && !mid_measure_helper(com, measured_units)) {
+      data.mid_measure = true;
+    }
+    if (!data.fast_feedforward && !fast_feed_forward_helper(com, unset_bits)) {
+      data.fast_feedforward = true;
+    }
+    Op_ptr op = com.get_op_ptr();
+    if (op->get_type() == OpType::Barrier) continue;
+    if (op->get_type() == OpType::Conditional) {
+      op = static_cast<const Conditional&>(*op).get_op();
+    }
+    if (op->get_type() == OpType::CircBox) {
+      data.circ_boxes = true;
+      continue;
+    }
+    const qubit_vector_t qbs = com.get_qubits();
+    if (qbs.size() == 1) continue;
+    if (qbs.size() == 2) {
+      data.interactions.insert({qbs[0], qbs[1]});
+      if (op->get_type() == OpType::CX || op->get_type() == OpType::ECR) {
+        data.cx_interactions.insert({qbs[0], qbs[1]});
+      }
+    } else if (qbs.size() == 3 && op->get_type() == OpType::BRIDGE) {
+      data.bridges.insert({qbs[0], qbs[1], qbs[2]});
+    } else {
+      data.other_arity_ops = true;
+    }
+  }
+  command_data_ = std::move(data);
+  return *command_data_;
+}
+
 bool NoMidMeasurePredicate::verify(const Circuit& circ) const {
   if (circ.n_bits() == 0) return true;
   unit_set_t measured_units;
@@ -609,6 +766,12 @@ bool NoMidMeasurePredicate::verify(const Circuit& circ) const {
   return true;
 }
 
+std::optional<bool> NoMidMeasurePredicate::verify_summary(
+    const CircuitSummary& summary) const {
+  if (summary.get_circ().n_bits() == 0) return true;
+  return !summary.get_command_data().mid_measure;
+}
+
 bool NoMidMeasurePredicate::implies(const Predicate& other) const {
   return auto_implication(*this, other);
 }
@@ -646,6 +809,12 @@ bool GlobalPhasedXPredicate::verify(const Circuit& circ) const {
   return true;
 }
 
+std::optional<bool> GlobalPhasedXPredicate::verify_summary(
+    const CircuitSummary& summary) const {
+  if (!summary.contains(OpType::NPhasedX)) return true;
+  return std::nullopt;
+}
+
 bool GlobalPhasedXPredicate::implies(const Predicate& other) const {
   return auto_implication(*this, other);
 }
@@ -677,6 +846,12 @@ bool NormalisedTK2Predicate::verify(const Circuit& circ) const {
   return true;
 }
 
+std::optional<bool> NormalisedTK2Predicate::verify_summary(
+    const CircuitSummary& summary) const {
+  if (summary.get_gate_types().count(OpType::TK2) == 0) return true;
+  return std::nullopt;
+}
+
 bool NormalisedTK2Predicate::implies(const Predicate& other) const {
   return auto_implication(*this, other);
 }
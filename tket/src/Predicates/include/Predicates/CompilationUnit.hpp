@@ -37,6 +37,7 @@ class CompilationUnit {
   CompilationUnit(const Circuit& circ, const PredicatePtrMap& preds);
   CompilationUnit(const Circuit& circ, const std::vector<PredicatePtr>& preds);
 
+  // Decides the predicate from the circuit summary where possible
   bool calc_predicate(const Predicate& pred) const;
   bool check_all_predicates()
       const;  // returns false if any of the preds are unsatisfied
@@ -44,6 +45,9 @@ class CompilationUnit {
   /* getters to inspect the data members */
   const Circuit& get_circ_ref() const { return circ_; }
   const PredicateCache& get_cache_ref() const { return cache_; }
+  // Built when first needed, and shared by all predicates until the
+  // circuit is next changed
+  const CircuitSummary& get_summary() const;
   const unit_bimap_t& get_initial_map_ref() const { return maps->initial; }
   const unit_bimap_t& get_final_map_ref() const { return maps->final; }
   std::string to_string() const;
@@ -56,6 +60,7 @@ class CompilationUnit {
 
  private:
   void empty_cache() const;
+  void circuit_changed() const;  // discards the summary
   void initialize_cache() const;
   void initialize_maps();
   Circuit circ_;  // modified continuously
@@ -63,6 +68,9 @@ class CompilationUnit {
       target_preds;  // these are the predicates you WANT your circuit to
                      // satisfy by the end of your Compiler Passes
   mutable PredicateCache cache_;  // updated continuously
+  // Summary of circ_; a summary copied from another CompilationUnit
+  // refers to that unit's circuit, and is replaced when next needed
+  mutable std::shared_ptr<const CircuitSummary> summary_;
 
   // Maps from original logical qubits to corresponding current qubits
   std::shared_ptr<unit_bimaps_t> maps;
@@ -132,6 +132,13 @@ class BasePass {
   static Guarantee get_guarantee(
       const std::type_index& ti, const PassConditions& conditions);
 
+  /**
+   * Number of pass applications in progress on the calling thread,
+   * including the one whose callback is running. Applications abandoned by
+   * an exception are not counted.
+   */
+  static unsigned apply_depth();
+
   virtual ~BasePass(){};
 
  protected:
@@ -154,6 +161,29 @@ class BasePass {
       const CompilationUnit& c_unit, SafetyMode safe_mode) const;
 
   void update_cache(const CompilationUnit& c_unit, SafetyMode safe_mode) const;
+
+  /**
+   * Call the callback with the pass configuration. Building the
+   * configuration of a compound pass serialises all of its sub-passes,
+   * so it is skipped when the callback is trivial_callback.
+   */
+  void invoke_callback(
+      const PassCallback& callback, const CompilationUnit& c_unit) const;
+
+  /**
+   * Counts one application towards apply_depth() for its lifetime, and
+   * calls the before_apply callback once it has been counted.
+   */
+  class ApplyScope {
+   public:
+    ApplyScope(
+        const BasePass& pass, const CompilationUnit& c_unit,
+        const PassCallback& before_apply);
+    ~ApplyScope();
+    ApplyScope(const ApplyScope&) = delete;
+    ApplyScope& operator=(const ApplyScope&) = delete;
+  };
+
   static PassConditions match_passes(const PassPtr& lhs, const PassPtr& rhs);
   static PassConditions match_passes(
       const PassConditions& lhs, const PassConditions& rhs);
@@ -197,11 +227,11 @@ class SequencePass : public BasePass {
       CompilationUnit& c_unit, SafetyMode safe_mode = SafetyMode::Default,
       const PassCallback& before_apply = trivial_callback,
       const PassCallback& after_apply = trivial_callback) const override {
-    before_apply(c_unit, this->get_config());
+    const ApplyScope scope(*this, c_unit, before_apply);
     bool success = false;
     for (const PassPtr& b : seq_)
       success |= b->apply(c_unit, safe_mode, before_apply, after_apply);
-    after_apply(c_unit, this->get_config());
+    invoke_callback(after_apply, c_unit);
     return success;
   }
   std::string to_string() const override;
@@ -222,11 +252,11 @@ class RepeatPass : public BasePass {
       CompilationUnit& c_unit, SafetyMode safe_mode = SafetyMode::Default,
       const PassCallback& before_apply = trivial_callback,
       const PassCallback& after_apply = trivial_callback) const override {
-    before_apply(c_unit, this->get_config());
+    const ApplyScope scope(*this, c_unit, before_apply);
     bool success = false;
     while (pass_->apply(c_unit, safe_mode, before_apply, after_apply))
       success = true;
-    after_apply(c_unit, this->get_config());
+    invoke_callback(after_apply, c_unit);
     return success;
   }
   std::string to_string() const override;
@@ -0,0 +1,113 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "CompilerPass.hpp"
+#include "Utils/Json.hpp"
+
+namespace tket {
+
+/**
+ * Records timing and resource usage for each pass application.
+ *
+ * The profiler is attached to a pass through the callbacks of
+ * BasePass::apply:
+ *
+ *     PassProfiler profiler;
+ *     pass->apply(cu, SafetyMode::Default, profiler.before_apply(),
+ *         profiler.after_apply());
+ *     nlohmann::json trace = profiler.to_chrome_trace();
+ *
+ * Every application of every (sub-)pass produces one record, in the order
+ * in which the applications finish. The trace can be loaded into
+ * chrome://tracing or Perfetto, where nested passes appear as nested
+ * slices. The profiler must outlive the callbacks it hands out.
+ *
+ * A pass which throws does not call its after_apply callback, so it and
+ * the passes enclosing it produce no records; the next application
+ * discards them and starts at the right depth.
+ */
+class PassProfiler {
+ public:
+  struct Record {
+    /** Name of a StandardPass, or the class of a compound pass */
+    std::string name;
+    /** Nesting depth; 0 for the pass that was applied directly */
+    unsigned depth;
+    /** Start time in microseconds, relative to the first record */
+    double start_us;
+    /** Elapsed wall-clock time in microseconds */
+    double wall_us;
+    /** CPU time of the calling thread in microseconds */
+    double cpu_us;
+    /** Number of gates before the pass was applied */
+    unsigned gates_before;
+    /** Number of gates after the pass was applied */
+    unsigned gates_after;
+    /** Growth of the peak resident set size of the process, in kB */
+    long peak_rss_growth_kb;
+    /** Number of sub-pass applications made directly by this pass */
+    unsigned iterations;
+  };
+
+  PassProfiler();
+
+  /** Callback to pass as the before_apply argument of BasePass::apply */
+  PassCallback before_apply();
+  /** Callback to pass as the after_apply argument of BasePass::apply */
+  PassCallback after_apply();
+
+  /** Completed records, in order of completion */
+  const std::vector<Record>& get_records() const { return records_; }
+
+  /** Forget all records */
+  void clear();
+
+  /**
+   * Records in the Chrome trace event format: an object whose
+   * "traceEvents" entry lists one complete ("X") event per record.
+   */
+  nlohmann::json to_chrome_trace() const;
+
+  /**
+   * Totals per pass name: number of calls, wall and CPU time, and the
+   * net change in gate count.
+   */
+  nlohmann::json to_json() const;
+
+ private:
+  typedef std::chrono::steady_clock clock_t;
+
+  struct OpenRecord {
+    Record record;
+    clock_t::time_point wall_start;
+    double cpu_start_us;
+    long peak_rss_start_kb;
+  };
+
+  void start(const CompilationUnit& c_unit, const nlohmann::json& config);
+  void finish(const CompilationUnit& c_unit);
+
+  clock_t::time_point epoch_;
+  bool epoch_set_;
+  std::vector<OpenRecord> open_;
+  std::vector<Record> records_;
+};
+
+}  // namespace tket
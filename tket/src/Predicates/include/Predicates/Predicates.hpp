@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #pragma once
+#include <optional>
+#include <set>
 #include <string>
+#include <tuple>
 #include <typeindex>
 
 #include "Architecture/Architecture.hpp"
@@ -47,6 +50,72 @@ class PredicateNotSerializable : public std::logic_error {
 
 const std::string& predicate_name(std::type_index idx);
 
+/**
+ * A summary of a circuit, from which most predicates can be decided
+ * without scanning the circuit again (see Predicate::verify_summary).
+ * One summary serves every predicate checked on the same circuit.
+ *
+ * The per-vertex data (op type histogram, gate sizes) is gathered by one
+ * pass over the vertices on construction. Clifford-ness, which is costly to
+ * decide for some ops, and the data which depends on the command sequence
+ * (qubit interactions, measurement order) are only computed the first time
+ * they are needed.
+ *
+ * The summary refers to the circuit, which must be neither modified nor
+ * destroyed while the summary is in use.
+ */
+class CircuitSummary {
+ public:
+  explicit CircuitSummary(const Circuit& circ);
+
+  const Circuit& get_circ() const { return circ_; }
+
+  /** Whether some vertex has this (top-level) op type. */
+  bool contains(OpType type) const { return op_type_counts_.count(type) != 0; }
+
+  /** The number of vertices with each (top-level) op type. */
+  const std::map<OpType, unsigned>& get_op_type_counts() const {
+    return op_type_counts_;
+  }
+
+  /** The types of all non-meta ops, looking inside conditionals. */
+  const OpTypeSet& get_gate_types() const { return gate_types_; }
+
+  /** Whether every op is Clifford. */
+  bool is_clifford() const;
+
+  /** The largest number of qubits of any op other than a barrier. */
+  unsigned get_max_gate_qubits() const { return max_gate_qubits_; }
+
+  /** The data gathered from the command sequence. */
+  struct CommandData {
+    /** Qubit pairs acted on by two-qubit ops, in argument order. */
+    std::set<std::pair<Qubit, Qubit>> interactions;
+    /** The qubit pairs acted on by CX and ECR gates. */
+    std::set<std::pair<Qubit, Qubit>> cx_interactions;
+    /** Qubit triples acted on by BRIDGE gates. */
+    std::set<std::tuple<Qubit, Qubit, Qubit>> bridges;
+    /** Some op other than a barrier acts on none, or on more than two
+     * qubits, and is not a BRIDGE. */
+    bool other_arity_ops = false;
+    /** Some (possibly conditional) op is a CircBox. */
+    bool circ_boxes = false;
+    /** Some op acts on a qubit or bit after it has been measured. */
+    bool mid_measure = false;
+    /** Some conditional reads a bit previously written by a measurement. */
+    bool fast_feedforward = false;
+  };
+  const CommandData& get_command_data() const;
+
+ private:
+  const Circuit& circ_;
+  std::map<OpType, unsigned> op_type_counts_;
+  OpTypeSet gate_types_;
+  mutable std::optional<bool> clifford_;
+  unsigned max_gate_qubits_;
+  mutable std::optional<CommandData> command_data_;
+};
+
 /////////////////////
 // PREDICATE CLASSES//
 /////////////////////
@@ -56,6 +125,15 @@ class Predicate {
  public:
   virtual bool verify(const Circuit& circ) const = 0;
 
+  /**
+   * Decide the predicate from a summary of the circuit, if possible.
+   * Must agree with verify(summary.get_circ()) whenever it returns a value.
+   * @return std::nullopt if the summary does not suffice
+   */
+  virtual std::optional<bool> verify_summary(const CircuitSummary&) const {
+    return std::nullopt;
+  }
+
   // implication currently only works between predicates of the same subclass
   virtual bool implies(const Predicate& other) const = 0;
   virtual PredicatePtr meet(const Predicate& other) const = 0;
@@ -69,6 +147,8 @@ class GateSetPredicate : public Predicate {
   explicit GateSetPredicate(const OpTypeSet& allowed_types)
       : allowed_types_(allowed_types) {}
   bool verify(const Circuit& circ) const override;
+  std::optional<bool> verify_summary(
+      const CircuitSummary& summary) const override;
   bool implies(const Predicate& other) const override;
   PredicatePtr meet(const Predicate& other) const override;
 
@@ -85,6 +165,8 @@ class GateSetPredicate : public Predicate {
 class NoClassicalControlPredicate : public Predicate {
  public:
   bool verify(const Circuit& circ) const override;
+  std::optional<bool> verify_summary(
+      const CircuitSummary& summary) const override;
   bool implies(const Predicate& other) const override;
   PredicatePtr meet(const Predicate& other) const override;
   std::string to_string() const override;
@@ -95,6 +177,8 @@ class NoFastFeedforwardPredicate : public Predicate {
   // and then read in later in the Circuit
  public:
   bool verify(const Circuit& circ) const override;
+  std::optional<bool> verify_summary(
+      const CircuitSummary& summary) const override;
   bool implies(const Predicate& other) const override;
   PredicatePtr meet(const Predicate& other) const override;
   std::string to_string() const override;
@@ -127,6 +211,8 @@ class MaxTwoQubitGatesPredicate : public Predicate {
   // Barriers are ignored
  public:
   bool verify(const Circuit& circ) const override;
+  std::optional<bool> verify_summary(
+      const CircuitSummary& summary) const override;
   bool implies(const Predicate& other) const override;
   PredicatePtr meet(const Predicate& other) const override;
   std::string to_string() const override;
@@ -151,6 +237,8 @@ class ConnectivityPredicate : public Predicate {
  public:
   explicit ConnectivityPredicate(const Architecture& arch) : arch_(arch) {}
   bool verify(const Circuit& circ) const override;
+  std::optional<bool> verify_summary(
+      const CircuitSummary& summary) const override;
   bool implies(const Predicate& other) const override;
   PredicatePtr meet(const Predicate& other) const override;
   std::string to_string() const override;
@@ -164,6 +252,8 @@ class DirectednessPredicate : public Predicate {
  public:
   explicit DirectednessPredicate(const Architecture& arch) : arch_(arch) {}
   bool verify(const Circuit& circ) const override;
+  std::optional<bool> verify_summary(
+      const CircuitSummary& summary) const override;
   bool implies(const Predicate& other) const override;
   PredicatePtr meet(const Predicate& other) const override;
   std::string to_string() const override;
@@ -176,6 +266,8 @@ class DirectednessPredicate : public Predicate {
 class CliffordCircuitPredicate : public Predicate {
  public:
   bool verify(const Circuit& circ) const override;
+  std::optional<bool> verify_summary(
+      const CircuitSummary& summary) const override;
   bool implies(const Predicate& other) const override;
   PredicatePtr meet(const Predicate& other) const override;
   std::string to_string() const override;
@@ -221,6 +313,8 @@ class MaxNQubitsPredicate : public Predicate {
 class NoBarriersPredicate : public Predicate {
  public:
   bool verify(const Circuit& circ) const override;
+  std::optional<bool> verify_summary(
+      const CircuitSummary& summary) const override;
   bool implies(const Predicate& other) const override;
   PredicatePtr meet(const Predicate& other) const override;
   std::string to_string() const override;
@@ -232,6 +326,8 @@ class NoBarriersPredicate : public Predicate {
 class NoMidMeasurePredicate : public Predicate {
  public:
   bool verify(const Circuit& circ) const override;
+  std::optional<bool> verify_summary(
+      const CircuitSummary& summary) const override;
   bool implies(const Predicate& other) const override;
   PredicatePtr meet(const Predicate& other) const override;
   std::string to_string() const override;
@@ -256,6 +352,8 @@ class NoSymbolsPredicate : public Predicate {
 class GlobalPhasedXPredicate : public Predicate {
  public:
   bool verify(const Circuit& circ) const override;
+  std::optional<bool> verify_summary(
+      const CircuitSummary& summary) const override;
   bool implies(const Predicate& other) const override;
   PredicatePtr meet(const Predicate& other) const override;
   std::string to_string() const override;
@@ -276,6 +374,8 @@ class GlobalPhasedXPredicate : public Predicate {
 class NormalisedTK2Predicate : public Predicate {
  public:
   bool verify(const Circuit& circ) const override;
+  std::optional<bool> verify_summary(
+      const CircuitSummary& summary) const override;
   bool implies(const Predicate& other) const override;
   PredicatePtr meet(const Predicate& other) const override;
   std::string to_string() const override;
@@ -20,6 +20,8 @@
 #include "DecomposeCircuit.hpp"
 #include "Gate/GateUnitaryMatrixError.hpp"
 #include "GateNodesBuffer.hpp"
+#include "ShotSampler.hpp"
+#include "StabiliserSampler.hpp"
 #include "Utils/Expression.hpp"
 
 namespace tket {
@@ -56,6 +58,24 @@ static void apply_unitary_may_throw(
   matr = apply_qubit_permutation(matr, circ.implicit_qubit_permutation());
 }
 
+// Convert a GateUnitaryMatrixError into the exception type expected by
+// callers, adding information about the circuit being simulated.
+[[noreturn]] static void rethrow_with_circuit_info(
+    const Circuit& circ, const GateUnitaryMatrixError& e,
+    const std::string& target_description) {
+  std::stringstream ss;
+  ss << "Error trying to simulate circuit " << circ << " with "
+     << circ.n_qubits() << " qubits, " << circ.get_commands().size()
+     << " commands; " << target_description << ": " << e.what();
+  if (e.cause == GateUnitaryMatrixError::Cause::GATE_NOT_IMPLEMENTED) {
+    throw CircuitInvalidity(ss.str());
+  } else if (e.cause == GateUnitaryMatrixError::Cause::SYMBOLIC_PARAMETERS) {
+    throw SymbolsNotSupported(ss.str());
+  } else {
+    throw e;
+  }
+}
+
 void apply_unitary(
     const Circuit& circ, Eigen::MatrixXcd& matr, double abs_epsilon,
     unsigned max_number_of_qubits) {
@@ -64,28 +84,62 @@ void apply_unitary(
   } catch (const GateUnitaryMatrixError& e) {
     const auto full_matr_size = get_matrix_size(circ.n_qubits());
     std::stringstream ss;
-    ss << "Error trying to simulate circuit " << circ << " with "
-       << circ.n_qubits() << " qubits, " << circ.get_commands().size()
-       << " commands; U is size " << full_matr_size << "x" << full_matr_size
+    ss << "U is size " << full_matr_size << "x" << full_matr_size
        << ", premultiplying M with " << matr.rows() << " rows, " << matr.cols()
-       << " cols: " << e.what();
-    if (e.cause == GateUnitaryMatrixError::Cause::GATE_NOT_IMPLEMENTED) {
-      throw CircuitInvalidity(ss.str());
-    } else if (e.cause == GateUnitaryMatrixError::Cause::SYMBOLIC_PARAMETERS) {
-      throw SymbolsNotSupported(ss.str());
-    } else {
-      throw e;
-    }
+       << " cols";
+    rethrow_with_circuit_info(circ, e, ss.str());
   }
 }
 
-Eigen::VectorXcd get_statevector(
+static StateVector get_statevector_may_throw(
     const Circuit& circ, double abs_epsilon, unsigned max_number_of_qubits) {
-  Eigen::MatrixXcd result =
-      Eigen::MatrixXcd::Zero(get_matrix_size(circ.n_qubits()), 1);
-  result(0, 0) = 1.0;
-  apply_unitary(circ, result, abs_epsilon, max_number_of_qubits);
-  return result;
+  // Check before allocating anything of size 2^n.
+  if (circ.n_qubits() > max_number_of_qubits) {
+    throw GateUnitaryMatrixError(
+        "Circuit to simulate has too many qubits",
+        GateUnitaryMatrixError::Cause::TOO_MANY_QUBITS);
+  }
+  StateVector statevector =
+      StateVector::Zero(get_matrix_size(circ.n_qubits()));
+  statevector(0) = 1.0;
+  internal::GateNodesBuffer buffer(statevector, abs_epsilon);
+  internal::decompose_circuit(circ, buffer, abs_epsilon);
+  return apply_qubit_permutation(
+      statevector, circ.implicit_qubit_permutation());
+}
+
+StateVector get_statevector(
+    const Circuit& circ, double abs_epsilon, unsigned max_number_of_qubits) {
+  try {
+    return get_statevector_may_throw(circ, abs_epsilon, max_number_of_qubits);
+  } catch (const GateUnitaryMatrixError& e) {
+    std::stringstream ss;
+    ss << "computing statevector of size 2^" << circ.n_qubits();
+    rethrow_with_circuit_info(circ, e, ss.str());
+  }
+}
+
+ShotTable sample_shots(
+    const Circuit& circ, unsigned n_shots, std::uint64_t seed,
+    double abs_epsilon, unsigned max_number_of_qubits) {
+  try {
+    if (circ.n_qubits() > max_number_of_qubits) {
+      throw GateUnitaryMatrixError(
+          "Circuit to simulate has too many qubits",
+          GateUnitaryMatrixError::Cause::TOO_MANY_QUBITS);
+    }
+    return internal::sample_shots(circ, n_shots, seed, abs_epsilon);
+  } catch (const GateUnitaryMatrixError& e) {
+    std::stringstream ss;
+    ss << "sampling " << n_shots << " shots with statevector of size 2^"
+       << circ.n_qubits();
+    rethrow_with_circuit_info(circ, e, ss.str());
+  }
+}
+
+ShotTable sample_stabiliser_shots(
+    const Circuit& circ, unsigned n_shots, std::uint64_t seed) {
+  return internal::sample_stabiliser_shots(circ, n_shots, seed);
 }
 
 }  // namespace tket_sim
@@ -0,0 +1,457 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "GateKernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <tkassert/Assert.hpp>
+
+#include "CircuitSimulator.hpp"
+#include "Utils/ThreadPool.hpp"
+
+// The vectorised kernels need GCC/Clang function target attributes;
+// with any other compiler or architecture, only the scalar kernels are used.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define TKET_SIM_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace tket {
+namespace tket_sim {
+
+namespace {
+// Zero means "use the tket default".
+std::atomic<unsigned> max_number_of_threads_setting(0);
+}  // namespace
+
+void set_max_number_of_threads(unsigned max_number_of_threads) {
+  max_number_of_threads_setting = max_number_of_threads;
+}
+
+unsigned get_max_number_of_threads() {
+  const unsigned setting = max_number_of_threads_setting;
+  if (setting != 0) {
+    return setting;
+  }
+  return get_default_number_of_threads();
+}
+
+SimdLevel get_supported_simd_level() {
+#ifdef TKET_SIM_X86_KERNELS
+  static const SimdLevel level = []() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      return SimdLevel::AVX2;
+    }
+    return SimdLevel::SCALAR;
+  }();
+  return level;
+#else
+  return SimdLevel::SCALAR;
+#endif
+}
+
+namespace {
+// Negative means "use the best supported level".
+std::atomic<int> simd_level_setting(-1);
+}  // namespace
+
+void set_simd_level(SimdLevel simd_level) {
+  if (static_cast<int>(simd_level) >
+      static_cast<int>(get_supported_simd_level())) {
+    throw std::invalid_argument(
+        "set_simd_level: instruction set not supported by this CPU");
+  }
+  simd_level_setting = static_cast<int>(simd_level);
+}
+
+SimdLevel get_simd_level() {
+  const int setting = simd_level_setting;
+  if (setting < 0) {
+    return get_supported_simd_level();
+  }
+  return static_cast<SimdLevel>(setting);
+}
+
+namespace internal {
+
+typedef std::complex<double> Complex;
+
+namespace {
+
+// Spawning threads is only worthwhile if each one gets
+// at least this many amplitudes to update.
+constexpr SimUInt min_amplitudes_per_thread = SimUInt(1) << 15;
+
+// The vectorised dense kernels keep a whole block in registers
+// (or at least on the stack), so are only used for small enough gates.
+constexpr SimUInt max_simd_dense_size = SimUInt(1) << 5;
+
+unsigned get_number_of_threads(SimUInt number_of_amplitudes) {
+  const SimUInt max_useful =
+      std::max<SimUInt>(1, number_of_amplitudes / min_amplitudes_per_thread);
+  return std::min<SimUInt>(get_max_number_of_threads(), max_useful);
+}
+
+// Split [0, count) into at most number_of_threads contiguous subranges,
+// each starting at a multiple of "alignment", and call
+// func(begin, end) for each one concurrently, on the shared thread pool.
+template <class Func>
+void for_each_subrange(
+    SimUInt count, SimUInt alignment, unsigned number_of_threads,
+    const Func& func) {
+  if (number_of_threads <= 1 || count <= alignment) {
+    func(0, count);
+    return;
+  }
+  SimUInt chunk = (count + number_of_threads - 1) / number_of_threads;
+  chunk = ((chunk + alignment - 1) / alignment) * alignment;
+  const SimUInt number_of_chunks = (count + chunk - 1) / chunk;
+  parallel_for(
+      number_of_chunks, number_of_threads,
+      [&func, count, chunk](std::size_t index, unsigned) {
+        const SimUInt begin = index * chunk;
+        func(begin, std::min(count, begin + chunk));
+      });
+}
+
+// std::complex multiplication must handle infinities and NaN carefully,
+// which makes it much slower than the plain formula; but amplitudes
+// are always finite.
+inline Complex multiply(const Complex& z, const Complex& w) {
+  return Complex(
+      z.real() * w.real() - z.imag() * w.imag(),
+      z.real() * w.imag() + z.imag() * w.real());
+}
+
+// Block p of a 1-qubit gate starts at the index obtained by inserting
+// a zero bit into p at the position of the gate qubit.
+inline SimUInt get_1q_block_start(SimUInt block, SimUInt stride) {
+  return ((block & ~(stride - 1)) << 1) | (block & (stride - 1));
+}
+
+void apply_1q_scalar(
+    const Complex* u, SimUInt stride, Complex* amplitudes, SimUInt begin,
+    SimUInt end) {
+  for (SimUInt block = begin; block < end; ++block) {
+    const SimUInt ii = get_1q_block_start(block, stride);
+    const Complex a0 = amplitudes[ii];
+    const Complex a1 = amplitudes[ii + stride];
+    amplitudes[ii] = multiply(u[0], a0) + multiply(u[1], a1);
+    amplitudes[ii + stride] = multiply(u[2], a0) + multiply(u[3], a1);
+  }
+}
+
+void apply_dense_scalar(
+    const Complex* u, const std::vector<SimUInt>& offsets,
+    const ExpansionData& expansion_data, Complex* amplitudes, SimUInt begin,
+    SimUInt end) {
+  const SimUInt dim = offsets.size();
+  std::vector<Complex> input(dim);
+  for (SimUInt block = begin; block < end; ++block) {
+    const SimUInt base = get_expanded_bits(expansion_data, block);
+    for (SimUInt jj = 0; jj < dim; ++jj) {
+      input[jj] = amplitudes[base | offsets[jj]];
+    }
+    for (SimUInt ii = 0; ii < dim; ++ii) {
+      Complex sum = 0.0;
+      for (SimUInt jj = 0; jj < dim; ++jj) {
+        sum += multiply(u[dim * ii + jj], input[jj]);
+      }
+      amplitudes[base | offsets[ii]] = sum;
+    }
+  }
+}
+
+// Sparse unitaries (e.g. CCX, CnX, CSWAP) are applied using the triplets
+// directly, rather than a dense block product.
+void apply_sparse_scalar(
+    const std::vector<TripletCd>& triplets,
+    const std::vector<SimUInt>& offsets, const ExpansionData& expansion_data,
+    Complex* amplitudes, SimUInt begin, SimUInt end) {
+  const SimUInt block_size = offsets.size();
+  std::vector<Complex> input(block_size);
+  std::vector<Complex> output(block_size);
+  for (SimUInt block = begin; block < end; ++block) {
+    const SimUInt base = get_expanded_bits(expansion_data, block);
+    for (SimUInt jj = 0; jj < block_size; ++jj) {
+      input[jj] = amplitudes[base | offsets[jj]];
+    }
+    std::fill(output.begin(), output.end(), Complex(0.0));
+    for (const auto& triplet : triplets) {
+      output[triplet.row()] +=
+          multiply(triplet.value(), input[triplet.col()]);
+    }
+    for (SimUInt ii = 0; ii < block_size; ++ii) {
+      amplitudes[base | offsets[ii]] = output[ii];
+    }
+  }
+}
+
+#ifdef TKET_SIM_X86_KERNELS
+// The vectorised kernels treat std::complex<double> arrays as interleaved
+// (re, im) double arrays, which the standard guarantees is valid.
+// A register holds 2 (AVX2) or 4 (AVX-512) consecutive complex numbers;
+// multiplying them all by a single complex number z = re + i.im is
+//   (re.a - im.b, re.b + im.a) = fmaddsub(re, (a,b), im * (b,a)).
+
+__attribute__((target("avx2,fma"))) inline __m256d mul_avx2(
+    __m256d re, __m256d im, __m256d vals) {
+  const __m256d swapped = _mm256_permute_pd(vals, 0b0101);
+  return _mm256_fmaddsub_pd(re, vals, _mm256_mul_pd(im, swapped));
+}
+
+__attribute__((target("avx2,fma"))) void apply_1q_avx2(
+    const Complex* u, SimUInt stride, Complex* amplitudes, SimUInt begin,
+    SimUInt end) {
+  __m256d re[4];
+  __m256d im[4];
+  for (unsigned ii = 0; ii < 4; ++ii) {
+    re[ii] = _mm256_set1_pd(u[ii].real());
+    im[ii] = _mm256_set1_pd(u[ii].imag());
+  }
+  for (SimUInt block = begin; block < end; block += 2) {
+    const SimUInt ii = get_1q_block_start(block, stride);
+    double* x0 = reinterpret_cast<double*>(amplitudes + ii);
+    double* x1 = reinterpret_cast<double*>(amplitudes + ii + stride);
+    const __m256d a0 = _mm256_loadu_pd(x0);
+    const __m256d a1 = _mm256_loadu_pd(x1);
+    _mm256_storeu_pd(
+        x0, _mm256_add_pd(
+                mul_avx2(re[0], im[0], a0), mul_avx2(re[1], im[1], a1)));
+    _mm256_storeu_pd(
+        x1, _mm256_add_pd(
+                mul_avx2(re[2], im[2], a0), mul_avx2(re[3], im[3], a1)));
+  }
+}
+
+__attribute__((target("avx2,fma"))) void apply_dense_avx2(
+    const Complex* u, const std::vector<SimUInt>& offsets,
+    const ExpansionData& expansion_data, Complex* amplitudes, SimUInt begin,
+    SimUInt end) {
+  const SimUInt dim = offsets.size();
+  __m256d input[max_simd_dense_size];
+  for (SimUInt block = begin; block < end; block += 2) {
+    const SimUInt base = get_expanded_bits(expansion_data, block);
+    for (SimUInt jj = 0; jj < dim; ++jj) {
+      input[jj] = _mm256_loadu_pd(
+          reinterpret_cast<const double*>(amplitudes + (base | offsets[jj])));
+    }
+    for (SimUInt ii = 0; ii < dim; ++ii) {
+      __m256d output = _mm256_setzero_pd();
+      for (SimUInt jj = 0; jj < dim; ++jj) {
+        const Complex& z = u[dim * ii + jj];
+        output = _mm256_add_pd(
+            output, mul_avx2(
+                        _mm256_set1_pd(z.real()), _mm256_set1_pd(z.imag()),
+                        input[jj]));
+      }
+      _mm256_storeu_pd(
+          reinterpret_cast<double*>(amplitudes + (base | offsets[ii])),
+          output);
+    }
+  }
+}
+
+__attribute__((target("avx512f"))) inline __m512d mul_avx512(
+    __m512d re, __m512d im, __m512d vals) {
+  // (The masked form is used only because the unmasked one trips
+  // spurious -Wmaybe-uninitialized warnings in some GCC versions).
+  const __m512d swapped =
+      _mm512_mask_permute_pd(vals, 0xFF, vals, 0b01010101);
+  return _mm512_fmaddsub_pd(re, vals, _mm512_mul_pd(im, swapped));
+}
+
+__attribute__((target("avx512f"))) void apply_1q_avx512(
+    const Complex* u, SimUInt stride, Complex* amplitudes, SimUInt begin,
+    SimUInt end) {
+  __m512d re[4];
+  __m512d im[4];
+  for (unsigned ii = 0; ii < 4; ++ii) {
+    re[ii] = _mm512_set1_pd(u[ii].real());
+    im[ii] = _mm512_set1_pd(u[ii].imag());
+  }
+  for (SimUInt block = begin; block < end; block += 4) {
+    const SimUInt ii = get_1q_block_start(block, stride);
+    double* x0 = reinterpret_cast<double*>(amplitudes + ii);
+    double* x1 = reinterpret_cast<double*>(amplitudes + ii + stride);
+    const __m512d a0 = _mm512_loadu_pd(x0);
+    const __m512d a1 = _mm512_loadu_pd(x1);
+    _mm512_storeu_pd(
+        x0, _mm512_add_pd(
+                mul_avx512(re[0], im[0], a0), mul_avx512(re[1], im[1], a1)));
+    _mm512_storeu_pd(
+        x1, _mm512_add_pd(
+                mul_avx512(re[2], im[2], a0), mul_avx512(re[3], im[3], a1)));
+  }
+}
+
+__attribute__((target("avx512f"))) void apply_dense_avx512(
+    const Complex* u, const std::vector<SimUInt>& offsets,
+    const ExpansionData& expansion_data, Complex* amplitudes, SimUInt begin,
+    SimUInt end) {
+  const SimUInt dim = offsets.size();
+  __m512d input[max_simd_dense_size];
+  for (SimUInt block = begin; block < end; block += 4) {
+    const SimUInt base = get_expanded_bits(expansion_data, block);
+    for (SimUInt jj = 0; jj < dim; ++jj) {
+      input[jj] = _mm512_loadu_pd(
+          reinterpret_cast<const double*>(amplitudes + (base | offsets[jj])));
+    }
+    for (SimUInt ii = 0; ii < dim; ++ii) {
+      __m512d output = _mm512_setzero_pd();
+      for (SimUInt jj = 0; jj < dim; ++jj) {
+        const Complex& z = u[dim * ii + jj];
+        output = _mm512_add_pd(
+            output, mul_avx512(
+                        _mm512_set1_pd(z.real()), _mm512_set1_pd(z.imag()),
+                        input[jj]));
+      }
+      _mm512_storeu_pd(
+          reinterpret_cast<double*>(amplitudes + (base | offsets[ii])),
+          output);
+    }
+  }
+}
+#endif
+
+SimUInt get_simd_width(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::AVX512:
+      return 4;
+    case SimdLevel::AVX2:
+      return 2;
+    default:
+      return 1;
+  }
+}
+}  // namespace
+
+GateKernel::GateKernel(
+    const std::vector<TripletCd>& triplets,
+    const std::vector<SimUInt>& translated_bits, SimUInt translated_bits_mask,
+    unsigned full_number_of_qubits)
+    : number_of_gate_qubits_(get_number_of_qubits(translated_bits.size())),
+      column_size_(get_matrix_size(full_number_of_qubits)),
+      number_of_blocks_(column_size_ / translated_bits.size()),
+      simd_level_(get_simd_level()),
+      stride_(translated_bits_mask),
+      offsets_(translated_bits),
+      expansion_data_(get_expansion_data(
+          translated_bits_mask,
+          full_number_of_qubits - number_of_gate_qubits_)),
+      simd_width_(1) {
+  TKET_ASSERT(number_of_gate_qubits_ > 0);
+  const SimUInt dim = translated_bits.size();
+  if (number_of_gate_qubits_ > 2 && 4 * triplets.size() < dim * dim) {
+    // At most a quarter of the entries are nonzero.
+    kernel_type_ = KernelType::SPARSE;
+    triplets_ = triplets;
+    return;
+  }
+  kernel_type_ = number_of_gate_qubits_ == 1 ? KernelType::ONE_QUBIT
+                                             : KernelType::DENSE;
+  dense_entries_.assign(dim * dim, Complex(0.0));
+  for (const auto& triplet : triplets) {
+    dense_entries_[dim * triplet.row() + triplet.col()] += triplet.value();
+  }
+  // Consecutive blocks have consecutive base indices exactly when
+  // the lowest bits of the index are not gate qubit bits.
+  const SimUInt width = get_simd_width(simd_level_);
+  if (width > 1 && dim <= max_simd_dense_size &&
+      (translated_bits_mask & (width - 1)) == 0 &&
+      number_of_blocks_ >= width) {
+    simd_width_ = width;
+  }
+}
+
+void GateKernel::apply_to_blocks(
+    Complex* amplitudes, SimUInt begin, SimUInt end) const {
+  switch (kernel_type_) {
+    case KernelType::ONE_QUBIT:
+#ifdef TKET_SIM_X86_KERNELS
+      if (simd_width_ == 4) {
+        apply_1q_avx512(dense_entries_.data(), stride_, amplitudes, begin, end);
+        return;
+      }
+      if (simd_width_ == 2) {
+        apply_1q_avx2(dense_entries_.data(), stride_, amplitudes, begin, end);
+        return;
+      }
+#endif
+      apply_1q_scalar(dense_entries_.data(), stride_, amplitudes, begin, end);
+      return;
+    case KernelType::DENSE:
+#ifdef TKET_SIM_X86_KERNELS
+      if (simd_width_ == 4) {
+        apply_dense_avx512(
+            dense_entries_.data(), offsets_, expansion_data_, amplitudes, begin,
+            end);
+        return;
+      }
+      if (simd_width_ == 2) {
+        apply_dense_avx2(
+            dense_entries_.data(), offsets_, expansion_data_, amplitudes, begin,
+            end);
+        return;
+      }
+#endif
+      apply_dense_scalar(
+          dense_entries_.data(), offsets_, expansion_data_, amplitudes, begin,
+          end);
+      return;
+    case KernelType::SPARSE:
+      apply_sparse_scalar(
+          triplets_, offsets_, expansion_data_, amplitudes, begin, end);
+      return;
+  }
+}
+
+void GateKernel::apply(Complex* data, SimUInt number_of_columns) const {
+  const unsigned number_of_threads =
+      get_number_of_threads(column_size_ * number_of_columns);
+
+  if (number_of_columns >= number_of_threads) {
+    // Plenty of columns (e.g., a full unitary): each thread takes
+    // whole columns, to avoid any sharing of cache lines.
+    for_each_subrange(
+        number_of_columns, 1, number_of_threads,
+        [&](SimUInt begin, SimUInt end) {
+          for (SimUInt col = begin; col < end; ++col) {
+            apply_to_blocks(data + col * column_size_, 0, number_of_blocks_);
+          }
+        });
+    return;
+  }
+  // Few columns (e.g., a statevector): split the blocks of each column.
+  for (SimUInt col = 0; col < number_of_columns; ++col) {
+    Complex* amplitudes = data + col * column_size_;
+    for_each_subrange(
+        number_of_blocks_, simd_width_,
+        get_number_of_threads(column_size_),
+        [&](SimUInt begin, SimUInt end) {
+          apply_to_blocks(amplitudes, begin, end);
+        });
+  }
+}
+
+}  // namespace internal
+}  // namespace tket_sim
+}  // namespace tket
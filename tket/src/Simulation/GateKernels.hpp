@@ -0,0 +1,90 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <complex>
+
+#include "BitOperations.hpp"
+#include "CircuitSimulator.hpp"
+#include "Utils/MatrixAnalysis.hpp"
+
+namespace tket {
+namespace tket_sim {
+namespace internal {
+
+/** A small unitary acting on k of the n qubits, preprocessed so that it
+ *  can be applied in place to columns of 2^n amplitudes (ILO-BE convention),
+ *  without ever lifting it to a (2^n)*(2^n) matrix.
+ *
+ *  The 2^n amplitudes of a column split into 2^(n-k) disjoint "blocks"
+ *  of 2^k amplitudes, which differ only in the bits belonging to the gate
+ *  qubits; each block is transformed by the small unitary independently,
+ *  so blocks (and columns) can be processed in parallel.
+ */
+class GateKernel {
+ public:
+  /** @param triplets The entries of the unitary acting on qubits [0,1,...,k-1].
+   *  @param translated_bits Element[x] gives the bits within the length n
+   *      binary string corresponding to the length k binary string x.
+   *  @param translated_bits_mask The OR of all the translated bits.
+   *  @param full_number_of_qubits The value n.
+   */
+  GateKernel(
+      const std::vector<TripletCd>& triplets,
+      const std::vector<SimUInt>& translated_bits,
+      SimUInt translated_bits_mask, unsigned full_number_of_qubits);
+
+  /** Premultiply each column of the (column-major) data by the lifted
+   *  unitary, in place. Several threads are used if the problem is large
+   *  enough, up to the limit set by set_max_number_of_threads.
+   *  @param data The first amplitude of the first column.
+   *  @param number_of_columns The number of consecutive columns,
+   *      each of size 2^n, to be updated.
+   */
+  void apply(std::complex<double>* data, SimUInt number_of_columns) const;
+
+ private:
+  const unsigned number_of_gate_qubits_;
+  const SimUInt column_size_;
+  const SimUInt number_of_blocks_;
+  const SimdLevel simd_level_;
+
+  enum class KernelType { ONE_QUBIT, DENSE, SPARSE };
+  KernelType kernel_type_;
+
+  // Used only by the 1-qubit kernel: the distance between
+  // the two amplitudes of a block.
+  SimUInt stride_;
+
+  // Used by the multi-qubit kernels.
+  std::vector<SimUInt> offsets_;
+  ExpansionData expansion_data_;
+
+  // Unitaries are stored densely, row-major, unless they are larger
+  // and sparse (e.g. CCX), in which case they are kept as triplets.
+  std::vector<std::complex<double>> dense_entries_;
+  std::vector<TripletCd> triplets_;
+
+  // Vectorised kernels process this many consecutive blocks at once,
+  // which is only possible if the blocks have consecutive base indices.
+  SimUInt simd_width_;
+
+  void apply_to_blocks(
+      std::complex<double>* amplitudes, SimUInt begin, SimUInt end) const;
+};
+
+}  // namespace internal
+}  // namespace tket_sim
+}  // namespace tket
@@ -17,6 +17,7 @@
 #include <tkassert/Assert.hpp>
 
 #include "BitOperations.hpp"
+#include "GateKernels.hpp"
 
 /*
 The following is intended to be helpful, but there are no guarantees
@@ -121,18 +122,16 @@ This, then, is the algorithm:
     The x values are all distinct from each other (and so, too, are the y),
     so we get 2^{n-k} distinct positions (y,x) where we place the value u_{i,j}.
 
-SPARSITY: U is (2^k)*(2^k). Let 0 < s <= 1 be the sparsity of U,
-i.e. U has s.4^k nonzero entries. The final matrix M then has
-2^{n-k}.s.4^k = s.2^{n+k} nonzero entries, so dividing by 4^n,
-the sparsity of M is s.2^{k-n}. Thus, even if U is dense, in most applications
-M becomes very sparse as n increases since k <= 2 for almost all gates.
-(In the few gates where k > 2, usually U is sparse, so that s << 1.
-e.g., CCX has an 8x8 matrix U, with 8 nonzero entries, so s=1/8).
+IN PLACE: we never actually need M itself. For each fixed choice of the
+free bits (those NOT in positions [q0, q1, ...]), the 2^k entries of a column
+with those free bits form a "block", and M acts on each block exactly as U
+does. So, premultiplying by M is done by gathering each of the 2^(n-k) blocks,
+multiplying by U, and scattering the results back. The blocks are disjoint,
+so this can be done in place, and in parallel; see GateKernels.hpp.
 
-This sparsity is essential. On an ordinary 2020 laptop,
-for n=8, with 560 gates, the full unitary M is found in <1 second.
-A single statevector for n=16, with 1120 gates, is found in ~3 seconds.
-This is without any really fancy, clever optimisation.
+The total work is 2^(n-k).4^k = 2^(n+k) multiplications per column for a dense
+U, the same as a sparse product with M, but with no 2^n-sized allocations and
+with memory access patterns which vectorise well.
 
 */
 
@@ -206,73 +205,27 @@ void LiftedBitsResult::set(
 }
 }  // namespace
 
-static void set_lifted_triplets(
-    const std::vector<TripletCd>& triplets, LiftedBitsResult& lifted_bits,
-    std::vector<TripletCd>& lifted_triplets, ExpansionData& expansion_data,
-    const std::vector<unsigned>& qubits, unsigned full_number_of_qubits) {
-  // translated_bits[j] gives the bits within the length n binary string,
-  // which correspond to the length k binary representation of j,
-  // but permuted and moved around so as to fit in the "slots" for qubits
-  // [q0, q1, q2,...].
-  // Since U is unitary of size 2^k, no column or row can be all zeros,
-  // so every index j will be needed at least once.
-  // Hence, it is not a waste of time to compute all,
-  // even if U is very sparse.
-  lifted_bits.set(qubits, full_number_of_qubits);
-  lifted_triplets.clear();
-
-  expansion_data = get_expansion_data(
-      lifted_bits.translated_bits_mask, full_number_of_qubits);
-
-  const SimUInt free_bits_limit =
-      get_matrix_size(full_number_of_qubits - qubits.size());
-  TKET_ASSERT(free_bits_limit != 0 || !"Too many bits");
-
-  for (SimUInt free_bits = 0; free_bits < free_bits_limit; ++free_bits) {
-    const SimUInt expanded_free_bits =
-        get_expanded_bits(expansion_data, free_bits);
-
-    // Now go down the U matrix entries and copy them to the appropriate
-    // positions.
-    for (const auto& triplet : triplets) {
-      lifted_triplets.emplace_back(
-          lifted_bits.translated_bits.at(triplet.row()) | expanded_free_bits,
-          lifted_bits.translated_bits.at(triplet.col()) | expanded_free_bits,
-          triplet.value());
-    }
-  }
-}
-
-namespace {
-// Contains data potentially of size roughly 2^n or larger,
-// to avoid expensive memeory reallocation.
-struct LargeWorkData {
+static void apply_in_place(
+    const GateNode& node, std::complex<double>* data,
+    SimUInt number_of_columns, unsigned full_number_of_qubits) {
   LiftedBitsResult lifted_bits;
-  std::vector<TripletCd> lifted_triplets;
-  SparseMatrixXcd sparse_matrix;
-  ExpansionData expansion_data;
-
-  static LargeWorkData& get_work_data();
-};
-
-LargeWorkData& LargeWorkData::get_work_data() {
-  static LargeWorkData data;
-  return data;
+  lifted_bits.set(node.qubit_indices, full_number_of_qubits);
+  const GateKernel kernel(
+      node.triplets, lifted_bits.translated_bits,
+      lifted_bits.translated_bits_mask, full_number_of_qubits);
+  kernel.apply(data, number_of_columns);
 }
-}  // namespace
 
 void GateNode::apply_full_unitary(
     Eigen::MatrixXcd& matr, unsigned full_number_of_qubits) const {
-  auto& work_data = LargeWorkData::get_work_data();
-
-  set_lifted_triplets(
-      triplets, work_data.lifted_bits, work_data.lifted_triplets,
-      work_data.expansion_data, qubit_indices, full_number_of_qubits);
-
-  work_data.sparse_matrix =
-      get_sparse_square_matrix(work_data.lifted_triplets, matr.rows());
+  TKET_ASSERT(matr.rows() == get_matrix_size(full_number_of_qubits));
+  apply_in_place(*this, matr.data(), matr.cols(), full_number_of_qubits);
+}
 
-  matr = work_data.sparse_matrix * matr;
+void GateNode::apply_to_statevector(
+    Eigen::VectorXcd& statevector, unsigned full_number_of_qubits) const {
+  TKET_ASSERT(statevector.size() == get_matrix_size(full_number_of_qubits));
+  apply_in_place(*this, statevector.data(), 1, full_number_of_qubits);
 }
 
 }  // namespace internal
@@ -31,11 +31,18 @@ struct GateNode {
    */
   std::vector<unsigned> qubit_indices;
 
-  /** Lift the triplets to a full unitary matrix U acting on n qubits,
-   *  then premultiply the given matrix by U.
+  /** Premultiply the given matrix by the full unitary matrix U acting on
+   *  n qubits, lifted from the triplets. This is done in place, column by
+   *  column; U itself is never constructed.
    */
   void apply_full_unitary(
       Eigen::MatrixXcd& matr, unsigned full_number_of_qubits) const;
+
+  /** As apply_full_unitary, but for a single statevector; the work is
+   *  split across threads within the vector rather than across columns.
+   */
+  void apply_to_statevector(
+      Eigen::VectorXcd& statevector, unsigned full_number_of_qubits) const;
 };
 
 }  // namespace internal
@@ -14,47 +14,198 @@
 
 #include "GateNodesBuffer.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <tkassert/Assert.hpp>
 
+#include "CircuitSimulator.hpp"
+
 namespace tket {
 namespace tket_sim {
+
+namespace {
+std::atomic<unsigned> max_fused_qubits_setting(3);
+}  // namespace
+
+void set_max_fused_qubits(unsigned max_fused_qubits) {
+  max_fused_qubits_setting = max_fused_qubits;
+}
+
+unsigned get_max_fused_qubits() { return max_fused_qubits_setting; }
+
 namespace internal {
 
 struct GateNodesBuffer::Impl {
-  Eigen::MatrixXcd& matrix;
+  // Exactly one of these is non-null.
+  Eigen::MatrixXcd* matrix_ptr;
+  Eigen::VectorXcd* statevector_ptr;
   const double abs_epsilon;
   const unsigned number_of_qubits;
+  const unsigned max_fused_qubits;
   double global_phase;
 
+  // Gates pushed but not yet applied, multiplied together into a single
+  // dense unitary acting on the given qubits (in that order, using ILO-BE
+  // convention).
+  struct FusedGate {
+    std::vector<unsigned> qubits;
+    Eigen::MatrixXcd unitary;
+  };
+
+  // The qubit sets are pairwise disjoint, so the fused gates all commute
+  // with each other, and can be applied in any order.
+  std::vector<FusedGate> fused_gates;
+
+  // Reused to avoid reallocation.
+  GateNode work_node;
+
   Impl(Eigen::MatrixXcd& matr, double abs_eps)
-      : matrix(matr),
+      : matrix_ptr(&matr),
+        statevector_ptr(nullptr),
         abs_epsilon(abs_eps),
         number_of_qubits(get_number_of_qubits(matr.rows())),
+        max_fused_qubits(get_max_fused_qubits()),
         global_phase(0.0) {
     if (matr.cols() == 0) {
       throw std::invalid_argument("Matrix has zero cols");
     }
   }
 
+  Impl(Eigen::VectorXcd& statevector, double abs_eps)
+      : matrix_ptr(nullptr),
+        statevector_ptr(&statevector),
+        abs_epsilon(abs_eps),
+        number_of_qubits(get_number_of_qubits(statevector.size())),
+        max_fused_qubits(get_max_fused_qubits()),
+        global_phase(0.0) {}
+
   void push(const GateNode&);
 
   void add_global_phase(double ph) { global_phase += ph; }
 
   void flush();
+
+  // Premultiply the full matrix or statevector by the lifted node unitary.
+  void apply(const GateNode&);
+
+  // As above, but for a fused gate.
+  void apply(const FusedGate&);
+
+  // Premultiply the fused gate unitary by the node unitary;
+  // the node must act only on qubits of the fused gate.
+  void fuse(const GateNode&, FusedGate&);
 };
 
+void GateNodesBuffer::Impl::apply(const GateNode& node) {
+  if (statevector_ptr != nullptr) {
+    node.apply_to_statevector(*statevector_ptr, number_of_qubits);
+    return;
+  }
+  node.apply_full_unitary(*matrix_ptr, number_of_qubits);
+}
+
+void GateNodesBuffer::Impl::apply(const FusedGate& fused_gate) {
+  work_node.qubit_indices = fused_gate.qubits;
+  work_node.triplets = get_triplets(fused_gate.unitary, abs_epsilon);
+  apply(work_node);
+}
+
+void GateNodesBuffer::Impl::fuse(const GateNode& node, FusedGate& fused_gate) {
+  work_node.triplets = node.triplets;
+  work_node.qubit_indices.resize(node.qubit_indices.size());
+  for (unsigned ii = 0; ii < node.qubit_indices.size(); ++ii) {
+    const auto citer = std::find(
+        fused_gate.qubits.cbegin(), fused_gate.qubits.cend(),
+        node.qubit_indices[ii]);
+    TKET_ASSERT(citer != fused_gate.qubits.cend());
+    work_node.qubit_indices[ii] = citer - fused_gate.qubits.cbegin();
+  }
+  work_node.apply_full_unitary(fused_gate.unitary, fused_gate.qubits.size());
+}
+
+static bool contains(const std::vector<unsigned>& qubits, unsigned qubit) {
+  return std::find(qubits.cbegin(), qubits.cend(), qubit) != qubits.cend();
+}
+
 void GateNodesBuffer::Impl::push(const GateNode& node) {
-  // Later, we might add fancy optimisation here:
-  // storing the gate for later use, looking for other compatible gates
-  // acting on the same qubits to merge with this, etc. etc.
-  node.apply_full_unitary(matrix, number_of_qubits);
+  // Each pass over the full matrix costs O(2^n) per column, whereas
+  // multiplying small unitaries together is independent of n.
+  // So, merge the node with all the fused gates sharing a qubit with it,
+  // as long as the union of their qubits stays small enough;
+  // otherwise, apply those fused gates and start a new one.
+  // Fused gates on other qubits commute with everything involved,
+  // so can be left alone.
+  std::vector<FusedGate> overlapping;
+  std::vector<FusedGate> disjoint;
+  for (auto& fused_gate : fused_gates) {
+    const bool overlaps = std::any_of(
+        fused_gate.qubits.cbegin(), fused_gate.qubits.cend(),
+        [&node](unsigned qubit) {
+          return contains(node.qubit_indices, qubit);
+        });
+    if (overlaps) {
+      overlapping.emplace_back(std::move(fused_gate));
+    } else {
+      disjoint.emplace_back(std::move(fused_gate));
+    }
+  }
+  fused_gates = std::move(disjoint);
+
+  FusedGate merged{{}, Eigen::MatrixXcd::Identity(1, 1)};
+  for (const auto& fused_gate : overlapping) {
+    merged.qubits.insert(
+        merged.qubits.end(), fused_gate.qubits.cbegin(),
+        fused_gate.qubits.cend());
+  }
+  unsigned merged_size = merged.qubits.size();
+  for (unsigned qubit : node.qubit_indices) {
+    if (!contains(merged.qubits, qubit)) {
+      ++merged_size;
+    }
+  }
+  if (merged_size > max_fused_qubits) {
+    for (const auto& fused_gate : overlapping) {
+      apply(fused_gate);
+    }
+    if (node.qubit_indices.size() > max_fused_qubits) {
+      apply(node);
+      return;
+    }
+    overlapping.clear();
+    merged.qubits.clear();
+  }
+  // The fused gates act on disjoint qubits, so combine by tensor product.
+  // Any remaining node qubits are appended, i.e. they become the least
+  // significant bits, so are also included by a tensor product.
+  for (const auto& fused_gate : overlapping) {
+    merged.unitary =
+        Eigen::kroneckerProduct(merged.unitary, fused_gate.unitary).eval();
+  }
+  for (unsigned qubit : node.qubit_indices) {
+    if (!contains(merged.qubits, qubit)) {
+      merged.qubits.push_back(qubit);
+      merged.unitary = Eigen::kroneckerProduct(
+                           merged.unitary, Eigen::MatrixXcd::Identity(2, 2))
+                           .eval();
+    }
+  }
+  fuse(node, merged);
+  fused_gates.emplace_back(std::move(merged));
 }
 
 void GateNodesBuffer::Impl::flush() {
+  for (const auto& fused_gate : fused_gates) {
+    apply(fused_gate);
+  }
+  fused_gates.clear();
   if (global_phase != 0.0) {
     const auto factor = std::polar(1.0, PI * global_phase);
-    matrix *= factor;
+    if (statevector_ptr != nullptr) {
+      *statevector_ptr *= factor;
+    } else {
+      *matrix_ptr *= factor;
+    }
     global_phase = 0.0;
   }
 }
@@ -62,6 +213,10 @@ void GateNodesBuffer::Impl::flush() {
 GateNodesBuffer::GateNodesBuffer(Eigen::MatrixXcd& matrix, double abs_epsilon)
     : pimpl(std::make_unique<Impl>(matrix, abs_epsilon)) {}
 
+GateNodesBuffer::GateNodesBuffer(
+    Eigen::VectorXcd& statevector, double abs_epsilon)
+    : pimpl(std::make_unique<Impl>(statevector, abs_epsilon)) {}
+
 GateNodesBuffer::~GateNodesBuffer() {}
 
 void GateNodesBuffer::push(const GateNode& node) { pimpl->push(node); }
@@ -49,6 +49,11 @@ namespace internal {
  *  Of course, this would all be simulating the exact same gates, just in a
  *  computationally more efficient way; allowing the gates themselves to be
  *  changed could give yet more speedup possibilities.
+ *
+ *  Currently, consecutive gates are merged greedily: the small unitaries
+ *  are multiplied together into one dense unitary, for as long as the union
+ *  of their qubits has size at most get_max_fused_qubits(). Only then is the
+ *  combined unitary lifted and applied, in a single pass over the matrix.
  */
 class GateNodesBuffer {
  public:
@@ -65,6 +70,19 @@ class GateNodesBuffer {
    */
   GateNodesBuffer(Eigen::MatrixXcd& matrix, double abs_epsilon);
 
+  /** The nodes will be applied directly to the statevector, in place;
+   *  no (2^n)*(2^n) matrix is ever constructed.
+   *  The statevector must remain valid throughout the lifetime
+   *  of this object, and the caller should not alter it
+   *  in any other way.
+   *
+   *  @param statevector The statevector, in ILO-BE convention, which will be
+   *      premultiplied by the unitary of the gates added in sequence.
+   *  @param abs_epsilon Used to convert almost-zero entries to zero entries:
+   *      any z with std::abs(z) <= abs_epsilon is treated as zero.
+   */
+  GateNodesBuffer(Eigen::VectorXcd& statevector, double abs_epsilon);
+
   ~GateNodesBuffer();
 
   /** Process and store the next node, possibly with optimisation,
@@ -108,7 +108,8 @@ struct PauliExpBoxUnitaryCalculator {
 };
 
 PauliExpBoxUnitaryCalculator& PauliExpBoxUnitaryCalculator::get() {
-  static PauliExpBoxUnitaryCalculator calculator;
+  // The calculator holds working storage, so each thread needs its own.
+  static thread_local PauliExpBoxUnitaryCalculator calculator;
   return calculator;
 }
 
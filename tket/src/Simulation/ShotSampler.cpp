@@ -0,0 +1,230 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ShotSampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <tkassert/Assert.hpp>
+#include <tkrng/RNG.hpp>
+
+#include "BitOperations.hpp"
+#include "Circuit/Circuit.hpp"
+#include "CircuitSimulator.hpp"
+#include "DecomposeCircuit.hpp"
+#include "GateNodesBuffer.hpp"
+#include "ShotSteps.hpp"
+
+namespace tket {
+namespace tket_sim {
+namespace internal {
+
+namespace {
+
+// A uniform random double in [0,1), using the top 53 bits.
+double get_uniform(RNG& rng) { return (rng() >> 11) * 0x1.0p-53; }
+
+class ShotSampler {
+ public:
+  ShotSampler(
+      const Circuit& circ, ShotTable& table, std::uint64_t seed,
+      double abs_epsilon)
+      : steps_(get_steps(circ)),
+        number_of_qubits_(circ.n_qubits()),
+        table_(table),
+        abs_epsilon_(abs_epsilon) {
+    rng_.set_seed(seed);
+    // only_final_measures_[i] is true if steps i, i+1, ... are all
+    // unconditional measurements.
+    only_final_measures_.assign(steps_.size() + 1, true);
+    for (unsigned ii = steps_.size(); ii > 0; --ii) {
+      const Step& step = steps_[ii - 1];
+      only_final_measures_[ii - 1] = only_final_measures_[ii] &&
+                                     step.type == Step::Type::MEASURE &&
+                                     step.condition_bits.empty();
+    }
+  }
+
+  /** Process all the steps from the given one onwards, for all the shots
+   *  in the group, which currently share the statevector and bit values.
+   *  The statevector and bits are overwritten.
+   */
+  void run(
+      unsigned step_index, StateVector& statevector, std::vector<bool>& bits,
+      std::vector<unsigned>& shots) {
+    for (; step_index < steps_.size(); ++step_index) {
+      const Step& step = steps_[step_index];
+      if (!condition_holds(step, bits)) {
+        continue;
+      }
+      switch (step.type) {
+        case Step::Type::UNITARY: {
+          GateNodesBuffer buffer(statevector, abs_epsilon_);
+          decompose_circuit(*step.unitary, buffer, abs_epsilon_);
+          break;
+        }
+        case Step::Type::CLASSICAL:
+          apply_classical(step, bits);
+          break;
+        case Step::Type::MEASURE:
+          if (only_final_measures_[step_index]) {
+            sample_final_measures(step_index, statevector, bits, shots);
+            return;
+          }
+          [[fallthrough]];
+        case Step::Type::RESET:
+          measure(step_index, statevector, bits, shots);
+          break;
+      }
+    }
+    for (unsigned shot : shots) {
+      write_bits(shot, bits);
+    }
+  }
+
+ private:
+  const std::vector<Step> steps_;
+  const unsigned number_of_qubits_;
+  std::vector<bool> only_final_measures_;
+  ShotTable& table_;
+  const double abs_epsilon_;
+  RNG rng_;
+
+  SimUInt get_mask(unsigned qubit) const {
+    // ILO-BE convention: qubit 0 is the most significant bit.
+    return SimUInt(1) << (number_of_qubits_ - 1 - qubit);
+  }
+
+  void write_bits(unsigned shot, const std::vector<bool>& bits) {
+    for (unsigned ii = 0; ii < bits.size(); ++ii) {
+      table_.set_bit(shot, ii, bits[ii]);
+    }
+  }
+
+  // Project onto the given outcome, renormalise, and (for a reset)
+  // then flip the qubit back to 0.
+  void collapse(
+      StateVector& statevector, SimUInt mask, bool outcome, double probability,
+      bool reset) const {
+    const double factor = 1.0 / std::sqrt(probability);
+    for (SimUInt ii = 0; ii < SimUInt(statevector.size()); ++ii) {
+      if (((ii & mask) != 0) == outcome) {
+        statevector(ii) *= factor;
+      } else {
+        statevector(ii) = 0.0;
+      }
+    }
+    if (reset && outcome) {
+      for (SimUInt ii = 0; ii < SimUInt(statevector.size()); ++ii) {
+        if ((ii & mask) != 0) {
+          statevector(ii ^ mask) = statevector(ii);
+          statevector(ii) = 0.0;
+        }
+      }
+    }
+  }
+
+  // A mid-circuit measurement or reset: sample an outcome for each shot,
+  // and split the group if necessary.
+  void measure(
+      unsigned step_index, StateVector& statevector, std::vector<bool>& bits,
+      std::vector<unsigned>& shots) {
+    const Step& step = steps_[step_index];
+    const SimUInt mask = get_mask(step.qubit);
+    double probabilities[2] = {0.0, 0.0};
+    for (SimUInt ii = 0; ii < SimUInt(statevector.size()); ++ii) {
+      probabilities[(ii & mask) != 0 ? 1 : 0] += std::norm(statevector(ii));
+    }
+    const double p1 =
+        probabilities[1] / (probabilities[0] + probabilities[1]);
+
+    std::vector<unsigned> shots_with_outcome[2];
+    for (unsigned shot : shots) {
+      shots_with_outcome[get_uniform(rng_) < p1 ? 1 : 0].push_back(shot);
+    }
+    const bool reset = step.type == Step::Type::RESET;
+    const unsigned larger =
+        shots_with_outcome[1].size() > shots_with_outcome[0].size() ? 1 : 0;
+    const unsigned smaller = 1 - larger;
+    if (!shots_with_outcome[smaller].empty()) {
+      StateVector statevector_copy = statevector;
+      std::vector<bool> bits_copy = bits;
+      collapse(
+          statevector_copy, mask, smaller, probabilities[smaller], reset);
+      if (step.bit) {
+        bits_copy[step.bit.value()] = smaller;
+      }
+      run(step_index + 1, statevector_copy, bits_copy,
+          shots_with_outcome[smaller]);
+    }
+    collapse(statevector, mask, larger, probabilities[larger], reset);
+    if (step.bit) {
+      bits[step.bit.value()] = larger;
+    }
+    shots = std::move(shots_with_outcome[larger]);
+  }
+
+  // All remaining steps are measurements, which do not change the
+  // distribution of the outcomes; so sample every shot directly
+  // from the final probabilities.
+  void sample_final_measures(
+      unsigned step_index, const StateVector& statevector,
+      std::vector<bool>& bits, const std::vector<unsigned>& shots) {
+    std::vector<double> cumulative(statevector.size());
+    double total = 0.0;
+    for (SimUInt ii = 0; ii < SimUInt(statevector.size()); ++ii) {
+      total += std::norm(statevector(ii));
+      cumulative[ii] = total;
+    }
+    for (unsigned shot : shots) {
+      const double value = get_uniform(rng_) * total;
+      const SimUInt index = std::min<SimUInt>(
+          std::upper_bound(cumulative.cbegin(), cumulative.cend(), value) -
+              cumulative.cbegin(),
+          cumulative.size() - 1);
+      for (unsigned ii = step_index; ii < steps_.size(); ++ii) {
+        const Step& step = steps_[ii];
+        if (step.bit) {
+          bits[step.bit.value()] = (index & get_mask(step.qubit)) != 0;
+        }
+      }
+      write_bits(shot, bits);
+    }
+  }
+};
+
+}  // namespace
+
+ShotTable sample_shots(
+    const Circuit& circ, unsigned number_of_shots, std::uint64_t seed,
+    double abs_epsilon) {
+  ShotTable table(number_of_shots, circ.n_bits());
+  if (number_of_shots == 0) {
+    return table;
+  }
+  ShotSampler sampler(circ, table, seed, abs_epsilon);
+  StateVector statevector =
+      StateVector::Zero(get_matrix_size(circ.n_qubits()));
+  statevector(0) = 1.0;
+  std::vector<bool> bits(circ.n_bits(), false);
+  std::vector<unsigned> shots(number_of_shots);
+  std::iota(shots.begin(), shots.end(), 0);
+  sampler.run(0, statevector, bits, shots);
+  return table;
+}
+
+}  // namespace internal
+}  // namespace tket_sim
+}  // namespace tket
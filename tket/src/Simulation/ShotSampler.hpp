@@ -0,0 +1,54 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "ShotTable.hpp"
+
+namespace tket {
+class Circuit;
+namespace tket_sim {
+namespace internal {
+
+/** Sample measurement outcomes of a circuit which may contain
+ *  OpType::Measure, OpType::Reset, OpType::Collapse, classical operations
+ *  and conditional operations.
+ *
+ *  Rather than simulating each shot separately, the shots are processed
+ *  together as a group sharing a single statevector, which is only split
+ *  when a mid-circuit measurement (or reset) gives different outcomes
+ *  for different shots in the group; every gate is applied once per group,
+ *  not once per shot. The smaller group is always handled by a recursive
+ *  call with a copy of the statevector, and the larger one continues
+ *  in place, so that at most log2(number_of_shots)+1 statevectors
+ *  are ever stored. Once only final measurements remain,
+ *  each shot is sampled directly from the cumulative probabilities.
+ *
+ *  @param circ The circuit to sample.
+ *  @param number_of_shots The number of shots.
+ *  @param seed Seed for the random number generator; the results are
+ *      fully determined by the circuit and the seed.
+ *  @param abs_epsilon Used to convert almost-zero entries of
+ *      gate unitaries to zero entries.
+ *  @return The table of classical bit values of each shot.
+ */
+ShotTable sample_shots(
+    const Circuit& circ, unsigned number_of_shots, std::uint64_t seed,
+    double abs_epsilon);
+
+}  // namespace internal
+}  // namespace tket_sim
+}  // namespace tket
@@ -0,0 +1,158 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ShotSteps.hpp"
+
+#include <map>
+#include <sstream>
+#include <tkassert/Assert.hpp>
+
+#include "Circuit/Circuit.hpp"
+#include "Circuit/Conditional.hpp"
+#include "Ops/ClassicalOps.hpp"
+
+namespace tket {
+namespace tket_sim {
+namespace internal {
+
+namespace {
+
+class StepsBuilder {
+ public:
+  explicit StepsBuilder(const Circuit& circ)
+      : qubits_(circ.all_qubits()) {
+    for (unsigned ii = 0; ii < qubits_.size(); ++ii) {
+      qubits_map_[qubits_[ii]] = ii;
+    }
+    const bit_vector_t bits = circ.all_bits();
+    for (unsigned ii = 0; ii < bits.size(); ++ii) {
+      bits_map_[bits[ii]] = ii;
+    }
+    for (const Command& command : circ) {
+      add(command.get_op_ptr(), command.get_args(), {}, {});
+    }
+  }
+
+  std::vector<Step> steps;
+
+ private:
+  const qubit_vector_t qubits_;
+  std::map<Qubit, unsigned> qubits_map_;
+  std::map<Bit, unsigned> bits_map_;
+
+  void add(
+      const Op_ptr& op, const unit_vector_t& args,
+      std::vector<unsigned> condition_bits,
+      std::vector<bool> condition_values) {
+    const OpType type = op->get_type();
+    Step step;
+    switch (type) {
+      case OpType::noop:
+      case OpType::Barrier:
+        return;
+      case OpType::Conditional: {
+        const Conditional& cond = static_cast<const Conditional&>(*op);
+        const unsigned width = cond.get_width();
+        for (unsigned ii = 0; ii < width; ++ii) {
+          condition_bits.push_back(bits_map_.at(Bit(args[ii])));
+          condition_values.push_back(((cond.get_value() >> ii) & 1) != 0);
+        }
+        add(cond.get_op(),
+            unit_vector_t(args.cbegin() + width, args.cend()), condition_bits,
+            condition_values);
+        return;
+      }
+      case OpType::Measure:
+        step.type = Step::Type::MEASURE;
+        step.qubit = qubits_map_.at(Qubit(args[0]));
+        step.bit = bits_map_.at(Bit(args[1]));
+        break;
+      case OpType::Collapse:
+        step.type = Step::Type::MEASURE;
+        step.qubit = qubits_map_.at(Qubit(args[0]));
+        break;
+      case OpType::Reset:
+        step.type = Step::Type::RESET;
+        step.qubit = qubits_map_.at(Qubit(args[0]));
+        break;
+      default: {
+        step.classical_op =
+            std::dynamic_pointer_cast<const ClassicalEvalOp>(op);
+        if (step.classical_op) {
+          step.type = Step::Type::CLASSICAL;
+          for (const UnitID& arg : args) {
+            step.bits.push_back(bits_map_.at(Bit(arg)));
+          }
+          break;
+        }
+        qubit_vector_t qubit_args;
+        for (const UnitID& arg : args) {
+          if (arg.type() != UnitType::Qubit) {
+            std::stringstream ss;
+            ss << "Cannot sample op " << op->get_name()
+               << ", which acts on classical bits";
+            throw CircuitInvalidity(ss.str());
+          }
+          qubit_args.emplace_back(arg);
+        }
+        if (condition_bits.empty() && !steps.empty() &&
+            steps.back().type == Step::Type::UNITARY &&
+            steps.back().condition_bits.empty()) {
+          steps.back().unitary->add_op(op, qubit_args);
+          return;
+        }
+        step.type = Step::Type::UNITARY;
+        step.unitary = std::make_shared<Circuit>(qubits_, bit_vector_t{});
+        step.unitary->add_op(op, qubit_args);
+        break;
+      }
+    }
+    step.condition_bits = std::move(condition_bits);
+    step.condition_values = std::move(condition_values);
+    steps.push_back(std::move(step));
+  }
+};
+
+}  // namespace
+
+std::vector<Step> get_steps(const Circuit& circ) {
+  return StepsBuilder(circ).steps;
+}
+
+bool condition_holds(const Step& step, const std::vector<bool>& bits) {
+  for (unsigned ii = 0; ii < step.condition_bits.size(); ++ii) {
+    if (bits[step.condition_bits[ii]] != step.condition_values[ii]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void apply_classical(const Step& step, std::vector<bool>& bits) {
+  const ClassicalEvalOp& op = *step.classical_op;
+  const unsigned number_of_inputs = op.get_n_i() + op.get_n_io();
+  std::vector<bool> input(number_of_inputs);
+  for (unsigned ii = 0; ii < number_of_inputs; ++ii) {
+    input[ii] = bits[step.bits[ii]];
+  }
+  const std::vector<bool> output = op.eval(input);
+  TKET_ASSERT(op.get_n_i() + output.size() == step.bits.size());
+  for (unsigned ii = 0; ii < output.size(); ++ii) {
+    bits[step.bits[op.get_n_i() + ii]] = output[ii];
+  }
+}
+
+}  // namespace internal
+}  // namespace tket_sim
+}  // namespace tket
@@ -0,0 +1,68 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace tket {
+class Circuit;
+class ClassicalEvalOp;
+namespace tket_sim {
+namespace internal {
+
+/** A single operation of a circuit to be sampled,
+ *  with all units converted to indices.
+ */
+struct Step {
+  enum class Type { UNITARY, MEASURE, RESET, CLASSICAL };
+  Type type;
+
+  // The step is skipped unless each of these bits has the given value.
+  // (Nested conditionals simply give longer lists).
+  std::vector<unsigned> condition_bits;
+  std::vector<bool> condition_values;
+
+  // For UNITARY: consecutive unconditional unitary operations
+  // are collected together into a single circuit on all the qubits.
+  std::shared_ptr<Circuit> unitary;
+
+  // For MEASURE and RESET.
+  unsigned qubit = 0;
+  // For MEASURE; empty for OpType::Collapse.
+  std::optional<unsigned> bit;
+
+  // For CLASSICAL.
+  std::shared_ptr<const ClassicalEvalOp> classical_op;
+  std::vector<unsigned> bits;
+};
+
+/** Break up a circuit which may contain OpType::Measure, OpType::Reset,
+ *  OpType::Collapse, classical operations and conditional operations
+ *  into steps, in order. Qubits and bits are indexed
+ *  as in Circuit::all_qubits() and Circuit::all_bits().
+ */
+std::vector<Step> get_steps(const Circuit& circ);
+
+/** Whether the step's condition (if any) holds for the given bit values. */
+bool condition_holds(const Step& step, const std::vector<bool>& bits);
+
+/** Apply a CLASSICAL step to the bit values. */
+void apply_classical(const Step& step, std::vector<bool>& bits);
+
+}  // namespace internal
+}  // namespace tket_sim
+}  // namespace tket
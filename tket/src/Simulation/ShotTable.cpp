@@ -0,0 +1,77 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ShotTable.hpp"
+
+#include <tkassert/Assert.hpp>
+
+namespace tket {
+namespace tket_sim {
+
+ShotTable::ShotTable(unsigned number_of_shots, unsigned number_of_bits)
+    : number_of_shots_(number_of_shots),
+      number_of_bits_(number_of_bits),
+      words_per_shot_((number_of_bits + 63) / 64),
+      data_(std::size_t(number_of_shots) * words_per_shot_, 0) {}
+
+unsigned ShotTable::get_number_of_shots() const { return number_of_shots_; }
+
+unsigned ShotTable::get_number_of_bits() const { return number_of_bits_; }
+
+unsigned ShotTable::get_words_per_shot() const { return words_per_shot_; }
+
+bool ShotTable::get_bit(unsigned shot, unsigned bit) const {
+  TKET_ASSERT(shot < number_of_shots_);
+  TKET_ASSERT(bit < number_of_bits_);
+  const std::uint64_t word =
+      data_[std::size_t(shot) * words_per_shot_ + bit / 64];
+  return ((word >> (bit % 64)) & 1) != 0;
+}
+
+void ShotTable::set_bit(unsigned shot, unsigned bit, bool value) {
+  TKET_ASSERT(shot < number_of_shots_);
+  TKET_ASSERT(bit < number_of_bits_);
+  std::uint64_t& word = data_[std::size_t(shot) * words_per_shot_ + bit / 64];
+  const std::uint64_t mask = std::uint64_t(1) << (bit % 64);
+  if (value) {
+    word |= mask;
+  } else {
+    word &= ~mask;
+  }
+}
+
+std::vector<bool> ShotTable::get_shot(unsigned shot) const {
+  std::vector<bool> result(number_of_bits_);
+  for (unsigned bit = 0; bit < number_of_bits_; ++bit) {
+    result[bit] = get_bit(shot, bit);
+  }
+  return result;
+}
+
+const std::uint64_t* ShotTable::get_shot_words(unsigned shot) const {
+  TKET_ASSERT(shot < number_of_shots_);
+  return data_.data() + std::size_t(shot) * words_per_shot_;
+}
+
+const std::vector<std::uint64_t>& ShotTable::get_data() const {
+  return data_;
+}
+
+bool ShotTable::operator==(const ShotTable& other) const {
+  return number_of_shots_ == other.number_of_shots_ &&
+         number_of_bits_ == other.number_of_bits_ && data_ == other.data_;
+}
+
+}  // namespace tket_sim
+}  // namespace tket
@@ -0,0 +1,164 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "StabiliserSampler.hpp"
+
+#include <numeric>
+#include <tkrng/RNG.hpp>
+
+#include "Circuit/Circuit.hpp"
+#include "Clifford/UnitaryTableau.hpp"
+#include "ShotSteps.hpp"
+
+namespace tket {
+namespace tket_sim {
+namespace internal {
+
+namespace {
+
+// A gate of a UNITARY step, ready to apply to the tableau.
+struct CliffordGate {
+  OpType type;
+  qubit_vector_t qubits;
+};
+
+class StabiliserSampler {
+ public:
+  StabiliserSampler(const Circuit& circ, ShotTable& table, std::uint64_t seed)
+      : steps_(get_steps(circ)), qubits_(circ.all_qubits()), table_(table) {
+    rng_.set_seed(seed);
+    // Unpack each UNITARY step once, rather than once per group of shots.
+    gates_.resize(steps_.size());
+    for (unsigned ii = 0; ii < steps_.size(); ++ii) {
+      if (steps_[ii].type != Step::Type::UNITARY) continue;
+      for (const Command& command : *steps_[ii].unitary) {
+        gates_[ii].push_back(
+            {command.get_op_ptr()->get_type(), command.get_qubits()});
+      }
+    }
+  }
+
+  /** Process all the steps from the given one onwards, for all the shots
+   *  in the group, which currently share the tableau and bit values.
+   *  The tableau and bits are overwritten.
+   */
+  void run(
+      unsigned step_index, UnitaryTableau& tableau, std::vector<bool>& bits,
+      std::vector<unsigned>& shots) {
+    for (; step_index < steps_.size(); ++step_index) {
+      const Step& step = steps_[step_index];
+      if (!condition_holds(step, bits)) {
+        continue;
+      }
+      switch (step.type) {
+        case Step::Type::UNITARY:
+          for (const CliffordGate& gate : gates_[step_index]) {
+            tableau.apply_gate_at_end(gate.type, gate.qubits);
+          }
+          break;
+        case Step::Type::CLASSICAL:
+          apply_classical(step, bits);
+          break;
+        case Step::Type::MEASURE:
+        case Step::Type::RESET:
+          measure(step_index, tableau, bits, shots);
+          break;
+      }
+    }
+    for (unsigned shot : shots) {
+      for (unsigned ii = 0; ii < bits.size(); ++ii) {
+        table_.set_bit(shot, ii, bits[ii]);
+      }
+    }
+  }
+
+ private:
+  const std::vector<Step> steps_;
+  const qubit_vector_t qubits_;
+  std::vector<std::vector<CliffordGate>> gates_;
+  ShotTable& table_;
+  RNG rng_;
+
+  static void collapse(
+      UnitaryTableau& tableau, const Qubit& qubit, bool outcome, bool reset) {
+    if (reset) {
+      tableau.reset_at_end(qubit, outcome);
+    } else {
+      tableau.measure_at_end(qubit, outcome);
+    }
+  }
+
+  // Sample an outcome for each shot, and split the group if necessary.
+  void measure(
+      unsigned step_index, UnitaryTableau& tableau, std::vector<bool>& bits,
+      std::vector<unsigned>& shots) {
+    const Step& step = steps_[step_index];
+    const Qubit& qubit = qubits_[step.qubit];
+    const bool reset = step.type == Step::Type::RESET;
+    if (!tableau.measurement_is_random(qubit)) {
+      const bool outcome = tableau.measure_at_end(qubit, false);
+      if (reset && outcome) {
+        tableau.apply_gate_at_end(OpType::X, {qubit});
+      }
+      if (step.bit) {
+        bits[step.bit.value()] = outcome;
+      }
+      return;
+    }
+
+    std::vector<unsigned> shots_with_outcome[2];
+    for (unsigned shot : shots) {
+      shots_with_outcome[rng_() & 1].push_back(shot);
+    }
+    const unsigned larger =
+        shots_with_outcome[1].size() > shots_with_outcome[0].size() ? 1 : 0;
+    const unsigned smaller = 1 - larger;
+    if (!shots_with_outcome[smaller].empty()) {
+      UnitaryTableau tableau_copy = tableau;
+      std::vector<bool> bits_copy = bits;
+      collapse(tableau_copy, qubit, smaller, reset);
+      if (step.bit) {
+        bits_copy[step.bit.value()] = smaller;
+      }
+      run(step_index + 1, tableau_copy, bits_copy,
+          shots_with_outcome[smaller]);
+    }
+    collapse(tableau, qubit, larger, reset);
+    if (step.bit) {
+      bits[step.bit.value()] = larger;
+    }
+    shots = std::move(shots_with_outcome[larger]);
+  }
+};
+
+}  // namespace
+
+ShotTable sample_stabiliser_shots(
+    const Circuit& circ, unsigned number_of_shots, std::uint64_t seed) {
+  ShotTable table(number_of_shots, circ.n_bits());
+  if (number_of_shots == 0) {
+    return table;
+  }
+  StabiliserSampler sampler(circ, table, seed);
+  UnitaryTableau tableau(circ.all_qubits());
+  std::vector<bool> bits(circ.n_bits(), false);
+  std::vector<unsigned> shots(number_of_shots);
+  std::iota(shots.begin(), shots.end(), 0);
+  sampler.run(0, tableau, bits, shots);
+  return table;
+}
+
+}  // namespace internal
+}  // namespace tket_sim
+}  // namespace tket
@@ -0,0 +1,50 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "ShotTable.hpp"
+
+namespace tket {
+class Circuit;
+namespace tket_sim {
+namespace internal {
+
+/** Sample measurement outcomes of a Clifford circuit, which may contain
+ *  OpType::Measure, OpType::Reset, OpType::Collapse, classical operations
+ *  and conditional gates, by evolving a stabiliser tableau
+ *  (a UnitaryTableau describing the state C|0>^n) rather than a statevector.
+ *  Memory use is O(n^2) and each gate takes time O(n) for n qubits,
+ *  so circuits with thousands of qubits can be sampled.
+ *
+ *  As for the statevector sampler, shots are processed together as a group
+ *  sharing a single tableau, which is only split when a measurement (or
+ *  reset) with a random outcome gives different outcomes for different shots
+ *  in the group. Measurements with determined outcomes never split a group.
+ *
+ *  @param circ The circuit to sample. Its gates must be among those
+ *      accepted by UnitaryTableau::apply_gate_at_end.
+ *  @param number_of_shots The number of shots.
+ *  @param seed Seed for the random number generator; the results are
+ *      fully determined by the circuit and the seed.
+ *  @return The table of classical bit values of each shot.
+ */
+ShotTable sample_stabiliser_shots(
+    const Circuit& circ, unsigned number_of_shots, std::uint64_t seed);
+
+}  // namespace internal
+}  // namespace tket_sim
+}  // namespace tket
@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include "ShotTable.hpp"
 #include "Utils/MatrixAnalysis.hpp"
 
 namespace tket {
@@ -26,6 +29,9 @@ namespace tket_sim {
  *  |00...0>, using ILO-BE convention.
  *  (Note: if any OpType::Measure or OpType::Barrier occur,
  *  they are simply ignored - the same as a noop).
+ *  The gates are applied in place to the statevector one by one,
+ *  so no (2^n)*(2^n) matrix is ever constructed; memory use is O(2^n),
+ *  and max_number_of_qubits may safely be raised well above the default.
  *  @param circ The circuit to simulate.
  *  @param abs_epsilon Used to decide if an entry of a sparse matrix is
  *              too small, i.e. if std::abs(z) <= abs_epsilon then we treat
@@ -70,5 +76,91 @@ void apply_unitary(
     const Circuit& circ, Eigen::MatrixXcd& matr, double abs_epsilon = EPS,
     unsigned max_number_of_qubits = 11);
 
+/** Sample the classical bit values obtained by running the circuit
+ *  (with all bits initially zero) many times.
+ *  Unlike the other functions, OpType::Measure is not ignored: the circuit
+ *  may also contain OpType::Reset, OpType::Collapse, classical operations
+ *  and conditional operations.
+ *  The statevector is shared between shots for as long as possible,
+ *  and only copied when a mid-circuit measurement gives different outcomes
+ *  in different shots; in particular the gates before the first measurement
+ *  are simulated only once. No (2^n)*(2^n) matrix is ever constructed.
+ *  @param circ The circuit to sample.
+ *  @param n_shots The number of shots.
+ *  @param seed Seed for the random number generator; the results
+ *              are fully determined by the circuit and the seed.
+ *  @param abs_epsilon Used to decide if an entry of a gate unitary is
+ *              too small, i.e. if std::abs(z) <= abs_epsilon then we treat
+ *              z as zero exactly.
+ *  @param max_number_of_qubits Throw an exception if this limit is exceeded.
+ *  @return The bit values of each shot, in the order of Circuit::all_bits().
+ */
+ShotTable sample_shots(
+    const Circuit& circ, unsigned n_shots, std::uint64_t seed,
+    double abs_epsilon = EPS, unsigned max_number_of_qubits = 20);
+
+/** Sample the classical bit values obtained by running a Clifford circuit
+ *  (with all bits initially zero) many times, using a stabiliser tableau
+ *  in place of the statevector. The circuit may contain the Clifford gates
+ *  accepted by UnitaryTableau (X, Y, Z, S, Sdg, V, Vdg, H, CX, CY, CZ,
+ *  SWAP, BRIDGE), OpType::Measure, OpType::Reset, OpType::Collapse,
+ *  classical operations and conditional gates. Memory use is O(n^2)
+ *  and each gate takes time O(n) for n qubits, so there is no limit
+ *  on the number of qubits.
+ *  Throws BadOpType if the circuit contains any other gate.
+ *  @param circ The circuit to sample.
+ *  @param n_shots The number of shots.
+ *  @param seed Seed for the random number generator; the results
+ *              are fully determined by the circuit and the seed.
+ *  @return The bit values of each shot, in the order of Circuit::all_bits().
+ */
+ShotTable sample_stabiliser_shots(
+    const Circuit& circ, unsigned n_shots, std::uint64_t seed);
+
+/** Set the maximum number of qubits in a fused gate. Consecutive gates
+ *  are multiplied together as small dense unitaries, for as long as the union
+ *  of their qubits has at most this size, and only then applied to the full
+ *  statevector or unitary; this greatly reduces the number of passes over
+ *  the full data. The results agree with unfused simulation up to roundoff.
+ *  @param max_fused_qubits The limit; 0 disables fusion. The default is 3.
+ */
+void set_max_fused_qubits(unsigned max_fused_qubits);
+
+/** The maximum number of qubits in a fused gate. */
+unsigned get_max_fused_qubits();
+
+/** Set the maximum number of threads which the simulation functions may use.
+ *  Small problems are always simulated on the calling thread;
+ *  larger ones are split across columns (for unitaries)
+ *  or across amplitudes (for statevectors).
+ *  @param max_number_of_threads The limit; 0 (the default) means use
+ *              get_default_number_of_threads(), shared by all of tket.
+ */
+void set_max_number_of_threads(unsigned max_number_of_threads);
+
+/** The maximum number of threads which the simulation functions may use,
+ *  after resolving the default value 0.
+ */
+unsigned get_max_number_of_threads();
+
+/** The vector instruction sets which the simulation kernels can use. */
+enum class SimdLevel { SCALAR, AVX2, AVX512 };
+
+/** The best vector instruction set supported by this CPU,
+ *  detected once at runtime.
+ */
+SimdLevel get_supported_simd_level();
+
+/** Restrict the simulation kernels to the given instruction set,
+ *  e.g. to compare the vectorised kernels with the scalar ones.
+ *  The results agree up to roundoff.
+ *  Throws std::invalid_argument if the CPU does not support the level.
+ *  @param simd_level The level; the default is get_supported_simd_level().
+ */
+void set_simd_level(SimdLevel simd_level);
+
+/** The vector instruction set used by the simulation kernels. */
+SimdLevel get_simd_level();
+
 }  // namespace tket_sim
 }  // namespace tket
@@ -0,0 +1,61 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace tket {
+namespace tket_sim {
+
+/** The classical bit values obtained in each shot of a sampled circuit,
+ *  packed 64 bits to a word. Shot s occupies the consecutive words
+ *  [s*W, (s+1)*W), where W = get_words_per_shot(), and bit b (indexed as in
+ *  Circuit::all_bits()) is bit (b % 64) of word (b / 64) within these.
+ *  Unused high bits of the final word of each shot are always zero.
+ */
+class ShotTable {
+ public:
+  /** All bits in all shots are initially zero. */
+  ShotTable(unsigned number_of_shots, unsigned number_of_bits);
+
+  unsigned get_number_of_shots() const;
+  unsigned get_number_of_bits() const;
+  unsigned get_words_per_shot() const;
+
+  bool get_bit(unsigned shot, unsigned bit) const;
+  void set_bit(unsigned shot, unsigned bit, bool value);
+
+  /** The bit values of a single shot, in the order of Circuit::all_bits(). */
+  std::vector<bool> get_shot(unsigned shot) const;
+
+  /** The packed words of a single shot. */
+  const std::uint64_t* get_shot_words(unsigned shot) const;
+
+  /** The raw packed data, of size get_number_of_shots()*get_words_per_shot().
+   */
+  const std::vector<std::uint64_t>& get_data() const;
+
+  bool operator==(const ShotTable& other) const;
+
+ private:
+  unsigned number_of_shots_;
+  unsigned number_of_bits_;
+  unsigned words_per_shot_;
+  std::vector<std::uint64_t> data_;
+};
+
+}  // namespace tket_sim
+}  // namespace tket
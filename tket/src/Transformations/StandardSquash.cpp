@@ -32,7 +32,11 @@ StandardSquasher::StandardSquasher(
     : singleqs_(singleqs),
       squash_fn_(tk1_replacement),
       combined_(),
-      phase_(0.) {
+      phase_(0.),
+      numeric_phase_(0.),
+      exact_gates_(),
+      floating_(false),
+      symbolic_(false) {
   for (OpType ot : singleqs_) {
     if (!is_single_qubit_type(ot))
       throw BadOpType(
@@ -45,17 +49,60 @@ bool StandardSquasher::accepts(Gate_ptr gp) const {
   return (singleqs_.find(type) != singleqs_.end()) && !is_projective_type(type);
 }
 
+static void apply_tk1_angles(
+    Rotation &r, Expr &phase, const std::vector<Expr> &angs) {
+  r.apply(Rotation(OpType::Rz, angs.at(2)));
+  r.apply(Rotation(OpType::Rx, angs.at(1)));
+  r.apply(Rotation(OpType::Rz, angs.at(0)));
+  phase += angs.at(3);
+}
+
 void StandardSquasher::append(Gate_ptr gp) {
-  std::vector<Expr> angs = gp->get_tk1_angles();
+  if (!gp->get_numeric_params() && !symbolic_) {
+    // The first symbol of the chain: redo its exact gates symbolically, so
+    // that their angles stay exact in the result.
+    symbolic_ = true;
+    if (!floating_) {
+      combined_ = Rotation();
+      numeric_phase_ = 0.;
+      for (const Gate_ptr &exact : exact_gates_) {
+        apply_tk1_angles(combined_, phase_, exact->get_tk1_angles());
+      }
+      exact_gates_.clear();
+    }
+  }
+  if (symbolic_) {
+    apply_tk1_angles(combined_, phase_, gp->get_tk1_angles());
+    return;
+  }
+  if (!floating_) {
+    if (gp->has_exact_params()) {
+      exact_gates_.push_back(gp);
+    } else {
+      floating_ = true;
+      exact_gates_.clear();
+    }
+  }
+  const std::vector<double> angs = *gp->get_tk1_angles_numeric();
   combined_.apply(Rotation(OpType::Rz, angs.at(2)));
   combined_.apply(Rotation(OpType::Rx, angs.at(1)));
   combined_.apply(Rotation(OpType::Rz, angs.at(0)));
-  phase_ += angs.at(3);
+  numeric_phase_ += angs.at(3);
 }
 
 std::pair<Circuit, Gate_ptr> StandardSquasher::flush(
     std::optional<Pauli>) const {
-  auto [a, b, c] = combined_.to_pqp(OpType::Rz, OpType::Rx);
+  Rotation combined = combined_;
+  Expr phase = phase_ + numeric_phase_;
+  if (!symbolic_ && !floating_ && !exact_gates_.empty()) {
+    // Every gate was exact, so give an exact result.
+    combined = Rotation();
+    phase = 0;
+    for (const Gate_ptr &exact : exact_gates_) {
+      apply_tk1_angles(combined, phase, exact->get_tk1_angles());
+    }
+  }
+  auto [a, b, c] = combined.to_pqp(OpType::Rz, OpType::Rx);
   Circuit replacement = squash_fn_(c, b, a);
   BGL_FORALL_VERTICES(rv, replacement.dag, DAG) {
     OpType v_type = replacement.get_OpType_from_Vertex(rv);
@@ -67,15 +114,21 @@ std::pair<Circuit, Gate_ptr> StandardSquasher::flush(
           v_type);
     }
   }
-  replacement.add_phase(phase_);
+  replacement.add_phase(phase);
   return {replacement, nullptr};
 }
 
 void StandardSquasher::clear() {
   combined_ = Rotation();
   phase_ = 0.;
+  numeric_phase_ = 0.;
+  exact_gates_.clear();
+  floating_ = false;
+  symbolic_ = false;
 }
 
+bool StandardSquasher::is_numeric() const { return floating_ && !symbolic_; }
+
 std::unique_ptr<AbstractSquasher> StandardSquasher::clone() const {
   return std::make_unique<StandardSquasher>(*this);
 }
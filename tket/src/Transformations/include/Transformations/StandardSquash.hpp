@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "Gate/GatePtr.hpp"
 #include "Gate/Rotation.hpp"
@@ -49,6 +50,15 @@ class StandardSquasher : public AbstractSquasher {
 
   void clear() override;
 
+  /**
+   * @brief Whether the current squash is computed in floating point.
+   *
+   * This holds once a gate with a floating-point parameter has been appended,
+   * unless a gate with a free symbol has been too. Gates without parameters
+   * or with exact parameters are then squashed in floating point as well.
+   */
+  bool is_numeric() const;
+
   std::unique_ptr<AbstractSquasher> clone() const override;
 
  private:
@@ -56,6 +66,17 @@ class StandardSquasher : public AbstractSquasher {
   const Func squash_fn_;
   Rotation combined_;
   Expr phase_;
+  // Phase contributed by gates with numeric parameters, kept apart from
+  // phase_ so that chains without symbols are squashed without SymEngine.
+  double numeric_phase_;
+  // The gates appended so far, while all of them are exact. If the chain
+  // stays exact, or meets a symbol, they are squashed again symbolically so
+  // that the result is exact.
+  std::vector<Gate_ptr> exact_gates_;
+  // Whether a gate with a floating-point parameter has been appended
+  bool floating_;
+  // Whether a gate with a free symbol has been appended
+  bool symbolic_;
 };
 
 }  // namespace Transforms
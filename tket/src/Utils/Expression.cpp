@@ -18,8 +18,18 @@
 
 #include "Constants.hpp"
 #include "Symbols.hpp"
+#include "symengine/eval_double.h"
+#include "symengine/real_double.h"
+#include "symengine/symengine_config.h"
 #include "symengine/symengine_exception.h"
 
+// Exprs are shared between circuits, and so between threads when circuits
+// are compiled concurrently; their reference counts must be atomic.
+#if defined(TKET_CONCURRENT_COMPILATION) && \
+    !defined(WITH_SYMENGINE_THREAD_SAFE)
+#error "CONCURRENT_COMPILATION needs SymEngine with WITH_SYMENGINE_THREAD_SAFE"
+#endif
+
 namespace tket {
 
 bool approx_0(const Expr& e, double tol) {
@@ -68,6 +78,36 @@ std::optional<double> eval_expr(const Expr& e) {
   }
 }
 
+bool exprs_thread_safe() {
+#ifdef WITH_SYMENGINE_THREAD_SAFE
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::optional<double> eval_real_double(const Expr& e) {
+  const SymEngine::Basic& b = *e.get_basic();
+  if (SymEngine::is_a<SymEngine::RealDouble>(b)) {
+    return SymEngine::down_cast<const SymEngine::RealDouble&>(b).as_double();
+  } else {
+    return std::nullopt;
+  }
+}
+
+std::optional<double> eval_number(const Expr& e) {
+  const SymEngine::Basic& b = *e.get_basic();
+  if (SymEngine::is_a<SymEngine::RealDouble>(b)) {
+    return SymEngine::down_cast<const SymEngine::RealDouble&>(b).as_double();
+  } else if (
+      SymEngine::is_a<SymEngine::Integer>(b) ||
+      SymEngine::is_a<SymEngine::Rational>(b)) {
+    return SymEngine::eval_double(b);
+  } else {
+    return std::nullopt;
+  }
+}
+
 std::optional<Complex> eval_expr_c(const Expr& e) {
   if (!SymEngine::free_symbols(e).empty()) {
     return std::nullopt;
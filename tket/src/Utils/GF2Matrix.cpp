@@ -0,0 +1,368 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "GF2Matrix.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <tkassert/Assert.hpp>
+#include <unordered_map>
+
+namespace tket {
+
+namespace {
+// Largest number of pivots combined in one M4RI lookup table.
+constexpr unsigned max_table_bits = 8;
+
+void xor_words(
+    std::uint64_t *target, const std::uint64_t *source, unsigned n_words) {
+  for (unsigned w = 0; w < n_words; ++w) {
+    target[w] ^= source[w];
+  }
+}
+}  // namespace
+
+GF2Matrix::GF2Matrix(unsigned n_rows, unsigned n_cols)
+    : n_rows_(n_rows),
+      n_cols_(n_cols),
+      n_words_((n_cols + 63) / 64),
+      data_(n_rows_ * n_words_, 0) {}
+
+GF2Matrix::GF2Matrix(const MatrixXb &m) : GF2Matrix(m.rows(), m.cols()) {
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    for (unsigned c = 0; c < n_cols_; ++c) {
+      if (m(r, c)) set(r, c);
+    }
+  }
+}
+
+GF2Matrix GF2Matrix::identity(unsigned n) {
+  GF2Matrix id(n, n);
+  for (unsigned i = 0; i < n; ++i) {
+    id.set(i, i);
+  }
+  return id;
+}
+
+MatrixXb GF2Matrix::get_matrix() const {
+  MatrixXb m(n_rows_, n_cols_);
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    for (unsigned c = 0; c < n_cols_; ++c) {
+      m(r, c) = get(r, c);
+    }
+  }
+  return m;
+}
+
+void GF2Matrix::row_add(unsigned r0, unsigned r1) {
+  xor_words(row(r1), row(r0), n_words_);
+}
+
+void GF2Matrix::col_add(unsigned c0, unsigned c1) {
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    if (get(r, c0)) set(r, c1, !get(r, c1));
+  }
+}
+
+void GF2Matrix::swap_rows(unsigned r0, unsigned r1) {
+  std::swap_ranges(row(r0), row(r0) + n_words_, row(r1));
+}
+
+GF2Matrix GF2Matrix::transpose() const {
+  GF2Matrix t(n_cols_, n_rows_);
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    const std::uint64_t *words = row(r);
+    for (unsigned w = 0; w < n_words_; ++w) {
+      for (std::uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+        t.set(64 * w + std::countr_zero(bits), r);
+      }
+    }
+  }
+  return t;
+}
+
+bool GF2Matrix::is_zero() const {
+  return std::all_of(
+      data_.begin(), data_.end(), [](std::uint64_t w) { return w == 0; });
+}
+
+bool GF2Matrix::is_identity() const {
+  if (n_rows_ != n_cols_) return false;
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    const std::uint64_t *words = row(r);
+    for (unsigned w = 0; w < n_words_; ++w) {
+      const std::uint64_t expected =
+          (w == r / 64) ? std::uint64_t(1) << (r % 64) : 0;
+      if (words[w] != expected) return false;
+    }
+  }
+  return true;
+}
+
+bool GF2Matrix::operator==(const GF2Matrix &other) const {
+  return n_rows_ == other.n_rows_ && n_cols_ == other.n_cols_ &&
+         data_ == other.data_;
+}
+
+std::uint64_t GF2Matrix::get_bits(
+    unsigned r, unsigned first, unsigned count) const {
+  TKET_ASSERT(count > 0 && count <= 64);
+  const std::uint64_t *words = row(r);
+  const unsigned w = first / 64;
+  const unsigned shift = first % 64;
+  std::uint64_t bits = words[w] >> shift;
+  if (shift != 0 && shift + count > 64) {
+    bits |= words[w + 1] << (64 - shift);
+  }
+  if (count < 64) {
+    bits &= (std::uint64_t(1) << count) - 1;
+  }
+  return bits;
+}
+
+/* see https://web.eecs.umich.edu/~imarkov/pubs/jour/qic08-cnot.pdf for a full
+ * explanation of this technique */
+/* K. Patel, I. Markov, J. Hayes. Optimal Synthesis of Linear Reversible
+        Circuits. QIC 2008 */
+std::vector<std::pair<unsigned, unsigned>>
+GF2Matrix::gaussian_elimination_row_ops(unsigned blocksize) {
+  TKET_ASSERT(blocksize > 0 && blocksize <= 64);
+  std::vector<std::pair<unsigned, unsigned>> ops;
+  const unsigned rows = n_rows_;
+  const unsigned cols = n_cols_;
+  std::vector<unsigned> pcols;  // we know which columns have non-zero entries
+                                // (to save actually transposing the matrix)
+  unsigned pivot_row = 0;
+  unsigned ceiling =
+      (cols + blocksize - 1) / blocksize;  // ceil(cols/blocksize)
+
+  // Get to upper echelon form
+  for (unsigned sec = 0; sec < ceiling; ++sec) {
+    // determine column range for this section
+    // if it hits cols don't go any higher
+    unsigned i0 = sec * blocksize;
+    unsigned i1 = std::min(cols, (sec + 1) * blocksize);
+
+    /* first, try to eliminate sub-rows (ie chunks), for greater speed than
+     * naively doing gaussian elim. */
+    std::unordered_map<std::uint64_t, unsigned> chunks;
+    for (unsigned r = pivot_row; r < rows; ++r) {
+      std::uint64_t t = get_bits(r, i0, i1 - i0);
+      if (t == 0) continue;
+      /* if first copy of pattern, save. If duplicate then remove by adding
+       * rows*/
+      auto chunk_it = chunks.find(t);
+      if (chunk_it != chunks.end()) {
+        row_add(chunk_it->second, r);
+        ops.push_back({chunk_it->second, r});
+      } else {
+        chunks.insert({t, r});
+      }
+    }
+    /* do gaussian elim. on remaining entries */
+    for (unsigned col = i0; col < i1; ++col) {
+      // find first 1 element in column after pivot_row
+      unsigned first_1 = pivot_row;
+      while (first_1 < rows && !get(first_1, col)) {
+        ++first_1;
+      }
+      if (first_1 == rows) continue;
+
+      // pull back to pivot
+      if (first_1 != pivot_row) {
+        row_add(first_1, pivot_row);
+        ops.push_back({first_1, pivot_row});
+      }
+
+      // clear all entries below pivot
+      for (unsigned r = std::max(pivot_row + 1, first_1); r < rows; ++r) {
+        if (get(r, col)) {
+          row_add(pivot_row, r);
+          ops.push_back({pivot_row, r});
+        }
+      }
+
+      // record that we pivoted for this column
+      pcols.push_back(col);
+      ++pivot_row;
+    }
+  }
+
+  /* matrix is now in upper triangular form; matrix is reduced to diagonal */
+
+  --pivot_row;
+
+  for (unsigned sec = ceiling; sec-- > 0;) {
+    unsigned i0 = sec * blocksize;
+    unsigned i1 = std::min(cols, (sec + 1) * blocksize);
+
+    std::unordered_map<std::uint64_t, unsigned> chunks;
+    for (unsigned r = pivot_row + 1; r-- > 0;) {
+      std::uint64_t t = get_bits(r, i0, i1 - i0);
+      if (t == 0) continue;
+
+      auto chunk_it = chunks.find(t);
+      if (chunk_it != chunks.end()) {
+        row_add(chunk_it->second, r);
+        ops.push_back({chunk_it->second, r});
+      } else {
+        chunks.insert({t, r});
+      }
+    }
+    while (!pcols.empty() && i0 <= pcols.back() && pcols.back() < i1) {
+      unsigned pcol = pcols.back();
+      pcols.pop_back();
+      for (unsigned r = 0; r < pivot_row; ++r) {
+        if (get(r, pcol)) {
+          row_add(pivot_row, r);
+          ops.push_back({pivot_row, r});
+        }
+      }
+      --pivot_row;
+    }
+  }
+
+  return ops;
+}
+
+/* M4RI: G. Bard. Accelerating Cryptanalysis with the Method of Four
+ * Russians. 2006.
+ * Columns are processed in sections of k. Up to k pivots are found in a
+ * section by ordinary elimination, touching only the pivot rows themselves;
+ * then every other row is cleared on all k pivot columns at once by adding
+ * one of the 2^k combinations of pivot rows, precomputed in a table. */
+std::vector<unsigned> GF2Matrix::row_reduce(
+    std::optional<unsigned> n_pivot_cols) {
+  const unsigned pivot_cols = n_pivot_cols.value_or(n_cols_);
+  TKET_ASSERT(pivot_cols <= n_cols_);
+  std::vector<unsigned> pivots;
+  if (n_rows_ == 0) return pivots;
+
+  // The table is only worth building if it is used by enough rows.
+  unsigned k = 1;
+  while (k < max_table_bits && (2u << k) <= n_rows_) ++k;
+  std::vector<std::uint64_t> table((std::size_t(1) << k) * n_words_);
+
+  for (unsigned c0 = 0; c0 < pivot_cols && pivots.size() < n_rows_;
+       c0 += k) {
+    const unsigned first = pivots.size();
+    const unsigned c1 = std::min(pivot_cols, c0 + k);
+    for (unsigned c = c0; c < c1 && pivots.size() < n_rows_; ++c) {
+      // Find a row whose entry in column c is nonzero once it is reduced by
+      // the pivots found so far in this section.
+      const unsigned n_found = pivots.size() - first;
+      unsigned r = pivots.size();
+      for (; r < n_rows_; ++r) {
+        bool bit = get(r, c);
+        for (unsigned q = 0; q < n_found; ++q) {
+          if (get(r, pivots[first + q])) bit ^= get(first + q, c);
+        }
+        if (bit) break;
+      }
+      if (r == n_rows_) continue;
+      for (unsigned q = 0; q < n_found; ++q) {
+        if (get(r, pivots[first + q])) row_add(first + q, r);
+      }
+      const unsigned p = pivots.size();
+      if (r != p) swap_rows(r, p);
+      // Keep the pivot rows of this section reduced against each other.
+      for (unsigned q = first; q < p; ++q) {
+        if (get(q, c)) row_add(p, q);
+      }
+      pivots.push_back(c);
+    }
+    const unsigned n_found = pivots.size() - first;
+    if (n_found == 0) continue;
+
+    // The pivot rows are zero before column c0, so the table and the row
+    // updates only need the words from there on.
+    const unsigned w0 = c0 / 64;
+    const unsigned width = n_words_ - w0;
+    std::fill(table.begin(), table.begin() + n_words_, 0);
+    for (unsigned i = 1; i < (1u << n_found); ++i) {
+      // Combination i is combination (i without its lowest bit) plus one
+      // pivot row.
+      std::uint64_t *entry = table.data() + i * n_words_;
+      const std::uint64_t *prev = table.data() + (i & (i - 1)) * n_words_;
+      const std::uint64_t *pivot_row = row(first + std::countr_zero(i));
+      for (unsigned w = w0; w < n_words_; ++w) {
+        entry[w] = prev[w] ^ pivot_row[w];
+      }
+    }
+    for (unsigned r = 0; r < n_rows_; ++r) {
+      if (r == first) {
+        r += n_found - 1;
+        continue;
+      }
+      unsigned index = 0;
+      for (unsigned q = 0; q < n_found; ++q) {
+        if (get(r, pivots[first + q])) index |= 1u << q;
+      }
+      if (index != 0) {
+        xor_words(row(r) + w0, table.data() + index * n_words_ + w0, width);
+      }
+    }
+  }
+  return pivots;
+}
+
+unsigned GF2Matrix::rank() const {
+  GF2Matrix m(*this);
+  return m.row_reduce().size();
+}
+
+std::optional<GF2Matrix> GF2Matrix::solve(const GF2Matrix &rhs) const {
+  TKET_ASSERT(rhs.n_rows_ == n_rows_);
+  GF2Matrix augmented(n_rows_, n_cols_ + rhs.n_cols_);
+  for (unsigned r = 0; r < n_rows_; ++r) {
+    std::copy(row(r), row(r) + n_words_, augmented.row(r));
+    for (unsigned c = 0; c < rhs.n_cols_; ++c) {
+      if (rhs.get(r, c)) augmented.set(r, n_cols_ + c);
+    }
+  }
+  const std::vector<unsigned> pivots = augmented.row_reduce(n_cols_);
+  for (unsigned r = pivots.size(); r < n_rows_; ++r) {
+    for (unsigned c = 0; c < rhs.n_cols_; ++c) {
+      if (augmented.get(r, n_cols_ + c)) return std::nullopt;
+    }
+  }
+  GF2Matrix x(n_cols_, rhs.n_cols_);
+  for (unsigned i = 0; i < pivots.size(); ++i) {
+    for (unsigned c = 0; c < rhs.n_cols_; ++c) {
+      if (augmented.get(i, n_cols_ + c)) x.set(pivots[i], c);
+    }
+  }
+  return x;
+}
+
+GF2Matrix GF2Matrix::nullspace() const {
+  GF2Matrix reduced(*this);
+  const std::vector<unsigned> pivots = reduced.row_reduce();
+  std::vector<bool> is_pivot(n_cols_, false);
+  for (unsigned c : pivots) is_pivot[c] = true;
+  GF2Matrix basis(n_cols_ - pivots.size(), n_cols_);
+  unsigned b = 0;
+  for (unsigned c = 0; c < n_cols_; ++c) {
+    if (is_pivot[c]) continue;
+    // Free variable c is set, and each pivot variable cancels its row.
+    basis.set(b, c);
+    for (unsigned i = 0; i < pivots.size(); ++i) {
+      if (reduced.get(i, c)) basis.set(b, pivots[i]);
+    }
+    ++b;
+  }
+  return basis;
+}
+
+}  // namespace tket
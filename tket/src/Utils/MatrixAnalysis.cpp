@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "Utils/EigenConfig.hpp"
+#include "Utils/GF2Matrix.hpp"
 
 namespace tket {
 
@@ -74,134 +75,10 @@ std::vector<std::pair<unsigned, unsigned>> gaussian_elimination_col_ops(
   return gaussian_elimination_row_ops(a.transpose(), blocksize);
 }
 
-struct MatrixXbBlockCompare {
-  bool operator()(
-      const MatrixXb::BlockXpr &lhs, const MatrixXb::BlockXpr &rhs) const {
-    TKET_ASSERT(lhs.rows() == rhs.rows());
-    TKET_ASSERT(lhs.cols() == rhs.cols());
-    for (unsigned r = 0; r < lhs.rows(); ++r) {
-      for (unsigned c = 0; c < lhs.cols(); ++c) {
-        if (lhs(r, c) < rhs(r, c)) return true;
-        if (lhs(r, c) > rhs(r, c)) return false;
-      }
-    }
-    return false;
-  }
-};
-
-/* see https://web.eecs.umich.edu/~imarkov/pubs/jour/qic08-cnot.pdf for a full
- * explanation of this technique */
-/* K. Patel, I. Markov, J. Hayes. Optimal Synthesis of Linear Reversible
-        Circuits. QIC 2008 */
 std::vector<std::pair<unsigned, unsigned>> gaussian_elimination_row_ops(
     const MatrixXb &a, unsigned blocksize) {
-  std::vector<std::pair<unsigned, unsigned>> ops;
-  MatrixXb m = a;
-  unsigned rows = m.rows();
-  unsigned cols = m.cols();
-  std::vector<unsigned> pcols;  // we know which columns have non-zero entries
-                                // (to save actually transposing the matrix)
-  unsigned pivot_row = 0;
-  unsigned ceiling =
-      (cols + blocksize - 1) / blocksize;  // ceil(cols/blocksize)
-
-  // Get to upper echelon form
-  for (unsigned sec = 0; sec < ceiling; ++sec) {
-    // determine column range for this section
-    // if it hits cols don't go any higher
-    unsigned i0 = sec * blocksize;
-    unsigned i1 = std::min(cols, (sec + 1) * blocksize);
-
-    /* first, try to eliminate sub-rows (ie chunks), for greater speed than
-     * naively doing gaussian elim. */
-    std::map<MatrixXb::BlockXpr, unsigned, MatrixXbBlockCompare> chunks;
-    for (unsigned r = pivot_row; r < rows; ++r) {
-      MatrixXb::BlockXpr t = m.block(r, i0, 1, i1 - i0);
-      if (t == MatrixXb::Zero(1, i1 - i0)) continue;
-      /* if first copy of pattern, save. If duplicate then remove by adding
-       * rows*/
-      auto chunk_it = chunks.find(t);
-      if (chunk_it != chunks.end()) {
-        for (unsigned k = 0; k < cols; ++k) {
-          m(r, k) ^= m(chunk_it->second, k);
-        }
-        ops.push_back({chunk_it->second, r});
-      } else {
-        chunks.insert({t, r});
-      }
-    }
-    /* do gaussian elim. on remaining entries */
-    for (unsigned col = i0; col < i1; ++col) {
-      // find first 1 element in column after pivot_row
-      unsigned first_1 = pivot_row;
-      while (first_1 < rows && !m(first_1, col)) {
-        ++first_1;
-      }
-      if (first_1 == rows) continue;
-
-      // pull back to pivot
-      if (first_1 != pivot_row) {
-        for (unsigned k = 0; k < cols; ++k) {
-          m(pivot_row, k) ^= m(first_1, k);
-        }
-        ops.push_back({first_1, pivot_row});
-      }
-
-      // clear all entries below pivot
-      for (unsigned r = std::max(pivot_row + 1, first_1); r < rows; ++r) {
-        if (m(r, col)) {
-          for (unsigned k = 0; k < cols; ++k) {
-            m(r, k) ^= m(pivot_row, k);
-          }
-          ops.push_back({pivot_row, r});
-        }
-      }
-
-      // record that we pivoted for this column
-      pcols.push_back(col);
-      ++pivot_row;
-    }
-  }
-
-  /* matrix is now in upper triangular form; matrix is reduced to diagonal */
-
-  --pivot_row;
-
-  for (unsigned sec = ceiling; sec-- > 0;) {
-    unsigned i0 = sec * blocksize;
-    unsigned i1 = std::min(cols, (sec + 1) * blocksize);
-
-    std::map<MatrixXb::BlockXpr, unsigned, MatrixXbBlockCompare> chunks;
-    for (unsigned r = pivot_row + 1; r-- > 0;) {
-      MatrixXb::BlockXpr t = m.block(r, i0, 1, i1 - i0);
-      if (t == MatrixXb::Zero(1, i1 - i0)) continue;
-
-      auto chunk_it = chunks.find(t);
-      if (chunk_it != chunks.end()) {
-        for (unsigned k = 0; k < cols; ++k) {
-          m(r, k) ^= m(chunk_it->second, k);
-        }
-        ops.push_back({chunk_it->second, r});
-      } else {
-        chunks.insert({t, r});
-      }
-    }
-    while (!pcols.empty() && i0 <= pcols.back() && pcols.back() < i1) {
-      unsigned pcol = pcols.back();
-      pcols.pop_back();
-      for (unsigned r = 0; r < pivot_row; ++r) {
-        if (m(r, pcol)) {
-          for (unsigned k = 0; k < cols; ++k) {
-            m(r, k) ^= m(pivot_row, k);
-          }
-          ops.push_back({pivot_row, r});
-        }
-      }
-      --pivot_row;
-    }
-  }
-
-  return ops;
+  GF2Matrix m(a);
+  return m.gaussian_elimination_row_ops(blocksize);
 }
 
 static Eigen::PermutationMatrix<Eigen::Dynamic> qubit_permutation(
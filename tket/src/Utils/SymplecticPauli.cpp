@@ -0,0 +1,226 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SymplecticPauli.hpp"
+
+#include <bit>
+#include <boost/functional/hash.hpp>
+#include <cmath>
+#include <stdexcept>
+#include <tkassert/Assert.hpp>
+
+#include "Utils/Constants.hpp"
+
+namespace tket {
+
+SymplecticPauliTensor::SymplecticPauliTensor(unsigned n_qubits)
+    : n_qubits_(n_qubits),
+      x_(symplectic::number_of_words(n_qubits), 0),
+      z_(symplectic::number_of_words(n_qubits), 0),
+      phase_(0) {}
+
+SymplecticPauliTensor::SymplecticPauliTensor(
+    const std::vector<Pauli> &paulis, unsigned phase)
+    : SymplecticPauliTensor(paulis.size()) {
+  for (unsigned q = 0; q < paulis.size(); ++q) {
+    set(q, paulis[q]);
+  }
+  set_phase(phase);
+}
+
+Pauli SymplecticPauliTensor::get(unsigned q) const {
+  TKET_ASSERT(q < n_qubits_);
+  const bool x = (x_[q / 64] >> (q % 64)) & 1;
+  const bool z = (z_[q / 64] >> (q % 64)) & 1;
+  if (x) return z ? Pauli::Y : Pauli::X;
+  return z ? Pauli::Z : Pauli::I;
+}
+
+void SymplecticPauliTensor::set(unsigned q, Pauli p) {
+  TKET_ASSERT(q < n_qubits_);
+  const std::uint64_t bit = std::uint64_t(1) << (q % 64);
+  std::uint64_t &x = x_[q / 64];
+  std::uint64_t &z = z_[q / 64];
+  x &= ~bit;
+  z &= ~bit;
+  switch (p) {
+    case Pauli::I:
+      break;
+    case Pauli::X:
+      x |= bit;
+      break;
+    case Pauli::Y:
+      x |= bit;
+      z |= bit;
+      break;
+    case Pauli::Z:
+      z |= bit;
+      break;
+    default:
+      throw UnknownPauli();
+  }
+}
+
+unsigned SymplecticPauliTensor::weight() const {
+  unsigned count = 0;
+  for (unsigned w = 0; w < x_.size(); ++w) {
+    count += std::popcount(x_[w] | z_[w]);
+  }
+  return count;
+}
+
+bool SymplecticPauliTensor::commutes_with(
+    const SymplecticPauliTensor &other) const {
+  TKET_ASSERT(n_qubits_ == other.n_qubits_);
+  return !symplectic::anticommute(
+      x_.data(), z_.data(), other.x_.data(), other.z_.data(), x_.size());
+}
+
+SymplecticPauliTensor SymplecticPauliTensor::operator*(
+    const SymplecticPauliTensor &other) const {
+  SymplecticPauliTensor result(*this);
+  result *= other;
+  return result;
+}
+
+SymplecticPauliTensor &SymplecticPauliTensor::operator*=(
+    const SymplecticPauliTensor &other) {
+  TKET_ASSERT(n_qubits_ == other.n_qubits_);
+  const unsigned power = symplectic::multiply(
+      x_.data(), z_.data(), other.x_.data(), other.z_.data(), x_.data(),
+      z_.data(), x_.size());
+  phase_ = (phase_ + other.phase_ + power) % 4;
+  return *this;
+}
+
+template <typename MaskFn>
+std::vector<unsigned> SymplecticPauliTensor::qubits_where(
+    const SymplecticPauliTensor &other, MaskFn mask_fn) const {
+  TKET_ASSERT(n_qubits_ == other.n_qubits_);
+  std::vector<unsigned> qubits;
+  for (unsigned w = 0; w < x_.size(); ++w) {
+    std::uint64_t mask = mask_fn(x_[w], z_[w], other.x_[w], other.z_[w]);
+    while (mask != 0) {
+      qubits.push_back(64 * w + std::countr_zero(mask));
+      mask &= mask - 1;
+    }
+  }
+  return qubits;
+}
+
+std::vector<unsigned> SymplecticPauliTensor::common_qubits(
+    const SymplecticPauliTensor &other) const {
+  return qubits_where(
+      other, [](std::uint64_t x1, std::uint64_t z1, std::uint64_t x2,
+                std::uint64_t z2) {
+        return (x1 | z1) & ~(x1 ^ x2) & ~(z1 ^ z2);
+      });
+}
+
+std::vector<unsigned> SymplecticPauliTensor::own_qubits(
+    const SymplecticPauliTensor &other) const {
+  return qubits_where(
+      other, [](std::uint64_t x1, std::uint64_t z1, std::uint64_t x2,
+                std::uint64_t z2) { return (x1 | z1) & ~(x2 | z2); });
+}
+
+std::vector<unsigned> SymplecticPauliTensor::conflicting_qubits(
+    const SymplecticPauliTensor &other) const {
+  return qubits_where(
+      other, [](std::uint64_t x1, std::uint64_t z1, std::uint64_t x2,
+                std::uint64_t z2) {
+        return (x1 | z1) & (x2 | z2) & ((x1 ^ x2) | (z1 ^ z2));
+      });
+}
+
+bool SymplecticPauliTensor::operator==(
+    const SymplecticPauliTensor &other) const {
+  return n_qubits_ == other.n_qubits_ && phase_ == other.phase_ &&
+         x_ == other.x_ && z_ == other.z_;
+}
+
+bool SymplecticPauliTensor::operator<(
+    const SymplecticPauliTensor &other) const {
+  if (n_qubits_ != other.n_qubits_) return n_qubits_ < other.n_qubits_;
+  if (x_ != other.x_) return x_ < other.x_;
+  if (z_ != other.z_) return z_ < other.z_;
+  return phase_ < other.phase_;
+}
+
+std::size_t hash_value(const SymplecticPauliTensor &spt) {
+  std::size_t seed = 0;
+  boost::hash_combine(seed, spt.n_qubits_);
+  boost::hash_range(seed, spt.x_.begin(), spt.x_.end());
+  boost::hash_range(seed, spt.z_.begin(), spt.z_.end());
+  boost::hash_combine(seed, spt.phase_);
+  return seed;
+}
+
+SymplecticPauliTensor to_symplectic(
+    const QubitPauliString &qps, const qubit_index_t &index) {
+  SymplecticPauliTensor spt(index.size());
+  for (const std::pair<const Qubit, Pauli> &qp : qps.map) {
+    if (qp.second == Pauli::I) continue;
+    qubit_index_t::const_iterator found = index.find(qp.first);
+    if (found == index.end()) {
+      throw std::invalid_argument(
+          "Qubit " + qp.first.repr() + " is not in the qubit index");
+    }
+    spt.set(found->second, qp.second);
+  }
+  return spt;
+}
+
+SymplecticPauliTensor to_symplectic(
+    const QubitPauliTensor &qpt, const qubit_index_t &index) {
+  SymplecticPauliTensor spt = to_symplectic(qpt.string, index);
+  const Complex powers[4] = {1., i_, -1., -i_};
+  for (unsigned k = 0; k < 4; ++k) {
+    if (std::abs(qpt.coeff - powers[k]) < EPS) {
+      spt.set_phase(k);
+      return spt;
+    }
+  }
+  throw std::invalid_argument(
+      "Only QubitPauliTensors with coefficient a power of i can be converted "
+      "to symplectic form");
+}
+
+QubitPauliString to_qubit_pauli_string(
+    const SymplecticPauliTensor &spt, const qubit_vector_t &qubits) {
+  TKET_ASSERT(qubits.size() == spt.get_n_qubits());
+  QubitPauliString qps;
+  for (unsigned q = 0; q < qubits.size(); ++q) {
+    const Pauli p = spt.get(q);
+    if (p != Pauli::I) qps.map.insert({qubits[q], p});
+  }
+  return qps;
+}
+
+QubitPauliTensor to_qubit_pauli_tensor(
+    const SymplecticPauliTensor &spt, const qubit_vector_t &qubits) {
+  const Complex powers[4] = {1., i_, -1., -i_};
+  return QubitPauliTensor(
+      to_qubit_pauli_string(spt, qubits), powers[spt.get_phase()]);
+}
+
+qubit_index_t make_qubit_index(const qubit_vector_t &qubits) {
+  qubit_index_t index;
+  for (unsigned q = 0; q < qubits.size(); ++q) {
+    index.insert({qubits[q], q});
+  }
+  return index;
+}
+
+}  // namespace tket
@@ -0,0 +1,186 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace tket {
+
+namespace {
+
+// Zero means "use all hardware threads".
+std::atomic<unsigned> default_number_of_threads_setting(0);
+
+// One call of parallel_for.
+struct Job {
+  Job(
+      std::size_t n_tasks_, unsigned number_of_threads_,
+      const std::function<void(std::size_t, unsigned)>& task_)
+      : n_tasks(n_tasks_),
+        number_of_threads(number_of_threads_),
+        task(task_),
+        next_task(0),
+        next_thread_index(1),
+        n_finished(0),
+        first_error_index(n_tasks_) {}
+
+  const std::size_t n_tasks;
+  const unsigned number_of_threads;
+  const std::function<void(std::size_t, unsigned)>& task;
+  std::atomic<std::size_t> next_task;
+
+  // The calling thread has index 0. Guarded by the pool mutex.
+  unsigned next_thread_index;
+
+  // The remaining members are guarded by this mutex.
+  std::mutex mutex;
+  std::condition_variable all_finished;
+  std::size_t n_finished;
+  std::size_t first_error_index;
+  std::exception_ptr first_error;
+
+  bool has_free_thread_slot() const {
+    return next_thread_index < number_of_threads &&
+           next_task.load(std::memory_order_relaxed) < n_tasks;
+  }
+
+  // Run tasks until there are none left to start.
+  void run(unsigned thread_index) {
+    std::size_t n_done = 0;
+    for (std::size_t i = next_task++; i < n_tasks; i = next_task++) {
+      try {
+        task(i, thread_index);
+      } catch (...) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (i < first_error_index) {
+          first_error_index = i;
+          first_error = std::current_exception();
+        }
+      }
+      ++n_done;
+    }
+    if (n_done == 0) return;
+    const std::lock_guard<std::mutex> lock(mutex);
+    n_finished += n_done;
+    if (n_finished == n_tasks) all_finished.notify_all();
+  }
+};
+
+class ThreadPool {
+ public:
+  // The pool is never destroyed: joining threads from static destructors
+  // can deadlock when a shared library is unloaded, and idle workers
+  // are simply stopped by the process exiting.
+  static ThreadPool& get() {
+    static ThreadPool* const pool = new ThreadPool();
+    return *pool;
+  }
+
+  void run(
+      std::size_t n_tasks, unsigned number_of_threads,
+      const std::function<void(std::size_t, unsigned)>& task) {
+    const auto job = std::make_shared<Job>(n_tasks, number_of_threads, task);
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      for (; n_workers_ + 1 < number_of_threads; ++n_workers_) {
+        std::thread([this]() { work(); }).detach();
+      }
+      jobs_.push_back(job);
+    }
+    job_available_.notify_all();
+
+    // The calling thread works too; so even if every worker is busy
+    // (e.g. because this is a nested call), the job is completed.
+    job->run(0);
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.remove(job);
+    }
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->all_finished.wait(
+        lock, [&job]() { return job->n_finished == job->n_tasks; });
+    if (job->first_error) std::rethrow_exception(job->first_error);
+  }
+
+ private:
+  ThreadPool() : n_workers_(0) {}
+
+  void work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      std::shared_ptr<Job> job;
+      job_available_.wait(lock, [&]() {
+        for (const std::shared_ptr<Job>& open_job : jobs_) {
+          if (open_job->has_free_thread_slot()) {
+            job = open_job;
+            return true;
+          }
+        }
+        return false;
+      });
+      const unsigned thread_index = job->next_thread_index++;
+      lock.unlock();
+      job->run(thread_index);
+      job.reset();
+      lock.lock();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable job_available_;
+  std::list<std::shared_ptr<Job>> jobs_;
+  unsigned n_workers_;
+};
+
+}  // namespace
+
+void set_default_number_of_threads(unsigned number_of_threads) {
+  default_number_of_threads_setting = number_of_threads;
+}
+
+unsigned get_default_number_of_threads() {
+  const unsigned setting = default_number_of_threads_setting;
+  if (setting != 0) {
+    return setting;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+unsigned get_number_of_threads(
+    std::size_t n_tasks, unsigned max_number_of_threads) {
+  if (max_number_of_threads == 0) {
+    max_number_of_threads = get_default_number_of_threads();
+  }
+  return std::max<std::size_t>(
+      1, std::min<std::size_t>(max_number_of_threads, n_tasks));
+}
+
+namespace internal {
+
+void run_parallel_tasks(
+    std::size_t n_tasks, unsigned number_of_threads,
+    const std::function<void(std::size_t, unsigned)>& task) {
+  ThreadPool::get().run(n_tasks, number_of_threads, task);
+}
+
+}  // namespace internal
+
+}  // namespace tket
@@ -92,6 +92,37 @@ SymSet expr_free_symbols(const std::vector<Expr>& es);
 
 std::optional<double> eval_expr(const Expr& e);
 
+/**
+ * Whether SymEngine was built with atomic reference counts, so that copies
+ * of the same Expr may be made and destroyed on several threads at once.
+ *
+ * Circuits share Exprs, so they may only be compiled concurrently if this
+ * holds. Configuring tket with CONCURRENT_COMPILATION makes the build fail
+ * unless it does.
+ */
+bool exprs_thread_safe();
+
+/**
+ * Evaluate an expression which is a floating-point number
+ *
+ * Integers and rationals, which are held exactly, are not evaluated.
+ *
+ * @param e expression to evaluate
+ * @return value of expression, iff it is a real double
+ */
+std::optional<double> eval_real_double(const Expr& e);
+
+/**
+ * Evaluate an expression which is a plain number
+ *
+ * Unlike @ref eval_expr this does not traverse the expression, so it is cheap
+ * enough to call on every gate parameter.
+ *
+ * @param e expression to evaluate
+ * @return value of expression, iff it is a real double, integer or rational
+ */
+std::optional<double> eval_number(const Expr& e);
+
 std::optional<Complex> eval_expr_c(const Expr& e);
 
 /**
@@ -0,0 +1,134 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "MatrixAnalysis.hpp"
+
+namespace tket {
+
+/**
+ * Dense matrix over GF(2), with rows packed into 64-bit words.
+ *
+ * Row additions XOR whole words; column operations touch one bit per row,
+ * so algorithms dominated by column operations should work on the
+ * transpose.
+ *
+ * Two eliminations are provided: a Patel-Markov-Hayes one, whose sequence
+ * of row operations is a short CX circuit for a linear reversible map, and
+ * a Method of Four Russians (M4RI) one for computing reduced row echelon
+ * forms quickly when only the result matters.
+ */
+class GF2Matrix {
+ public:
+  /** Construct an n_rows x n_cols zero matrix */
+  explicit GF2Matrix(unsigned n_rows = 0, unsigned n_cols = 0);
+
+  /** Construct from an unpacked matrix */
+  explicit GF2Matrix(const MatrixXb &m);
+
+  static GF2Matrix identity(unsigned n);
+
+  /** Unpacked copy of the matrix */
+  MatrixXb get_matrix() const;
+
+  unsigned get_n_rows() const { return n_rows_; }
+  unsigned get_n_cols() const { return n_cols_; }
+  unsigned get_n_words() const { return n_words_; }
+
+  bool get(unsigned r, unsigned c) const {
+    return (data_[r * n_words_ + c / 64] >> (c % 64)) & 1;
+  }
+  bool operator()(unsigned r, unsigned c) const { return get(r, c); }
+
+  void set(unsigned r, unsigned c, bool value = true) {
+    const std::uint64_t mask = std::uint64_t(1) << (c % 64);
+    std::uint64_t &word = data_[r * n_words_ + c / 64];
+    word = value ? (word | mask) : (word & ~mask);
+  }
+
+  /** The packed entries of row r */
+  std::uint64_t *row(unsigned r) { return data_.data() + r * n_words_; }
+  const std::uint64_t *row(unsigned r) const {
+    return data_.data() + r * n_words_;
+  }
+
+  /** Adds row r0 to row r1 */
+  void row_add(unsigned r0, unsigned r1);
+
+  /** Adds column c0 to column c1 */
+  void col_add(unsigned c0, unsigned c1);
+
+  void swap_rows(unsigned r0, unsigned r1);
+
+  GF2Matrix transpose() const;
+
+  bool is_zero() const;
+  bool is_identity() const;
+
+  bool operator==(const GF2Matrix &other) const;
+  bool operator!=(const GF2Matrix &other) const { return !(*this == other); }
+
+  /**
+   * Reduces the matrix in place to reduced row echelon form, using the
+   * Patel-Markov-Hayes algorithm, and returns the row operations applied.
+   *
+   * Each pair (r0, r1) means row r0 was added to row r1. When the matrix is
+   * invertible these are CXs (control r0, target r1) which, applied to the
+   * linear map in order, reduce it to the identity.
+   *
+   * @param blocksize width of the column sections whose duplicate
+   *    sub-rows are eliminated first (at most 64)
+   */
+  std::vector<std::pair<unsigned, unsigned>> gaussian_elimination_row_ops(
+      unsigned blocksize = 6);
+
+  /**
+   * Reduces the matrix in place to reduced row echelon form using M4RI
+   * blocked elimination, and returns the pivot columns.
+   *
+   * Pivots are only chosen among the first n_pivot_cols columns; the
+   * remaining columns are carried along by the same row operations, as for
+   * an augmented matrix. Pivot i lies in row i, and every row from
+   * pivots.size() onwards is zero on the pivot columns.
+   */
+  std::vector<unsigned> row_reduce(std::optional<unsigned> n_pivot_cols = {});
+
+  unsigned rank() const;
+
+  /**
+   * Finds X with (*this) * X = rhs, setting the free variables to zero,
+   * if a solution exists.
+   */
+  std::optional<GF2Matrix> solve(const GF2Matrix &rhs) const;
+
+  /** A basis of the right nullspace, as the rows of the result */
+  GF2Matrix nullspace() const;
+
+ private:
+  unsigned n_rows_;
+  unsigned n_cols_;
+  unsigned n_words_;
+  std::vector<std::uint64_t> data_;
+
+  /** The bits [first, first + count) of row r, with count <= 64 */
+  std::uint64_t get_bits(unsigned r, unsigned first, unsigned count) const;
+};
+
+}  // namespace tket
@@ -0,0 +1,260 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "Utils/PauliStrings.hpp"
+#include "Utils/UnitID.hpp"
+
+namespace tket {
+
+/** Dense index of qubits, from 0 to n-1, used by SymplecticPauliTensor */
+typedef std::map<Qubit, unsigned> qubit_index_t;
+
+/**
+ * Kernels on Pauli strings in packed symplectic form: the X and Z components
+ * of qubit q are bit (q % 64) of word (q / 64) of arrays x and z, with Y
+ * represented by both bits set. They are shared by every class storing
+ * strings this way.
+ */
+namespace symplectic {
+
+/** Number of 64-bit words holding n bits */
+inline unsigned number_of_words(unsigned n) { return (n + 63) / 64; }
+
+/** Whether the strings (x1, z1) and (x2, z2) anticommute */
+inline bool anticommute(
+    const std::uint64_t *x1, const std::uint64_t *z1, const std::uint64_t *x2,
+    const std::uint64_t *z2, std::size_t n_words) {
+  std::uint64_t anticommuting = 0;
+  for (std::size_t w = 0; w < n_words; ++w) {
+    anticommuting ^= (x1[w] & z2[w]) ^ (z1[w] & x2[w]);
+  }
+  return std::popcount(anticommuting) % 2 == 1;
+}
+
+/**
+ * Whether the strings (x1, z1) and (x2, z2) carry different non-identity
+ * Paulis on at least one qubit
+ */
+inline bool conflict(
+    const std::uint64_t *x1, const std::uint64_t *z1, const std::uint64_t *x2,
+    const std::uint64_t *z2, std::size_t n_words) {
+  for (std::size_t w = 0; w < n_words; ++w) {
+    const std::uint64_t both_nontrivial = (x1[w] | z1[w]) & (x2[w] | z2[w]);
+    const std::uint64_t different = (x1[w] ^ x2[w]) | (z1[w] ^ z2[w]);
+    if ((both_nontrivial & different) != 0) return true;
+  }
+  return false;
+}
+
+/**
+ * Set (xw, zw) to the product (x1, z1) x (x2, z2), ignoring coefficients.
+ *
+ * On each qubit where the terms anticommute, the product of the two Paulis
+ * contributes a factor of i (for XY, YZ and ZX) or -i (for YX, ZY and XZ);
+ * the -i qubits are those where the result's x, z and x1.z2 bits have odd
+ * parity. Each word is read before it is written, so the output may alias
+ * either input.
+ *
+ * @return The power of i contributed by the product, not reduced mod 4
+ */
+inline unsigned multiply(
+    const std::uint64_t *x1, const std::uint64_t *z1, const std::uint64_t *x2,
+    const std::uint64_t *z2, std::uint64_t *xw, std::uint64_t *zw,
+    std::size_t n_words) {
+  unsigned power = 0;
+  for (std::size_t w = 0; w < n_words; ++w) {
+    const std::uint64_t x1z2 = x1[w] & z2[w];
+    const std::uint64_t anticommuting = x1z2 ^ (z1[w] & x2[w]);
+    const std::uint64_t x = x1[w] ^ x2[w];
+    const std::uint64_t z = z1[w] ^ z2[w];
+    const std::uint64_t minus_i = (x ^ z ^ x1z2) & anticommuting;
+    power += std::popcount(anticommuting) + 2 * std::popcount(minus_i);
+    xw[w] = x;
+    zw[w] = z;
+  }
+  return power;
+}
+
+}  // namespace symplectic
+
+/**
+ * A tensor of Pauli terms
+ * \f$ P = i^k \sigma_0 \otimes \sigma_1 \otimes \cdots \otimes \sigma_{n-1} \f$
+ * over a fixed number n of densely indexed qubits, in symplectic form.
+ *
+ * The X and Z components of the terms are packed 64 qubits to a word, with
+ * Y represented by both bits set, so that commutation and multiplication
+ * are word-parallel bit operations. The coefficient is restricted to a
+ * power k of i (so with k = 0 this is also a dense QubitPauliString).
+ *
+ * Use this in place of QubitPauliString and QubitPauliTensor where many
+ * strings over the same qubits are compared or multiplied; convert to and
+ * from them at the boundaries with the functions below.
+ */
+class SymplecticPauliTensor {
+ public:
+  /** Construct the identity on n qubits */
+  explicit SymplecticPauliTensor(unsigned n_qubits = 0);
+
+  /**
+   * Construct from Pauli letters
+   *
+   * @param paulis Element[q] gives the term on qubit q
+   * @param phase The power k of i in the coefficient
+   */
+  explicit SymplecticPauliTensor(
+      const std::vector<Pauli> &paulis, unsigned phase = 0);
+
+  /** Number of qubits n */
+  unsigned get_n_qubits() const { return n_qubits_; }
+
+  /** Term on qubit q */
+  Pauli get(unsigned q) const;
+
+  /** Set the term on qubit q */
+  void set(unsigned q, Pauli p);
+
+  /** The power k of i in the coefficient, from 0 to 3 */
+  unsigned get_phase() const { return phase_; }
+
+  /** Set the power of i in the coefficient (taken mod 4) */
+  void set_phase(unsigned phase) { phase_ = phase % 4; }
+
+  /** Number of qubits with a non-identity term */
+  unsigned weight() const;
+
+  /**
+   * Determine whether two tensors commute, from the parity of the number of
+   * qubits on which their terms anticommute.
+   *
+   * @param other Tensor on the same number of qubits
+   */
+  bool commutes_with(const SymplecticPauliTensor &other) const;
+
+  /**
+   * Calculate the product of two tensors
+   *
+   * @param other Tensor on the same number of qubits
+   *
+   * @return *this x other
+   */
+  SymplecticPauliTensor operator*(const SymplecticPauliTensor &other) const;
+
+  /** Replace *this by *this x other */
+  SymplecticPauliTensor &operator*=(const SymplecticPauliTensor &other);
+
+  /**
+   * Qubits where both terms are the same (non-trivial) Pauli.
+   * Analogous to QubitPauliString::common_qubits.
+   */
+  std::vector<unsigned> common_qubits(
+      const SymplecticPauliTensor &other) const;
+
+  /**
+   * Qubits where only this tensor has a non-trivial term.
+   * Analogous to QubitPauliString::own_qubits.
+   */
+  std::vector<unsigned> own_qubits(const SymplecticPauliTensor &other) const;
+
+  /**
+   * Qubits where both terms are non-trivial and different.
+   * Analogous to QubitPauliString::conflicting_qubits.
+   */
+  std::vector<unsigned> conflicting_qubits(
+      const SymplecticPauliTensor &other) const;
+
+  /** Equality of the number of qubits, all terms and the phase */
+  bool operator==(const SymplecticPauliTensor &other) const;
+
+  bool operator!=(const SymplecticPauliTensor &other) const {
+    return !(*this == other);
+  }
+
+  /**
+   * An arbitrary but consistent total order, for use in ordered containers.
+   * This is not the order of QubitPauliString.
+   */
+  bool operator<(const SymplecticPauliTensor &other) const;
+
+  /** The packed X components, bit (q % 64) of word (q / 64) for qubit q */
+  const std::vector<std::uint64_t> &get_x_words() const { return x_; }
+
+  /** The packed Z components, in the same layout as the X components */
+  const std::vector<std::uint64_t> &get_z_words() const { return z_; }
+
+  friend std::size_t hash_value(const SymplecticPauliTensor &spt);
+
+ private:
+  unsigned n_qubits_;
+  std::vector<std::uint64_t> x_;
+  std::vector<std::uint64_t> z_;
+  unsigned phase_;
+
+  // Qubits whose bit is set in one of the given masks, computed word by word
+  template <typename MaskFn>
+  std::vector<unsigned> qubits_where(
+      const SymplecticPauliTensor &other, MaskFn mask_fn) const;
+};
+
+/**
+ * Convert a QubitPauliString to symplectic form (with phase 0).
+ *
+ * @param qps string to convert
+ * @param index Dense index of every qubit which may appear in the string;
+ *    the result has index.size() qubits
+ */
+SymplecticPauliTensor to_symplectic(
+    const QubitPauliString &qps, const qubit_index_t &index);
+
+/**
+ * Convert a QubitPauliTensor to symplectic form.
+ *
+ * @param qpt tensor to convert, whose coefficient must be a power of i
+ * @param index Dense index of every qubit which may appear in the tensor;
+ *    the result has index.size() qubits
+ */
+SymplecticPauliTensor to_symplectic(
+    const QubitPauliTensor &qpt, const qubit_index_t &index);
+
+/**
+ * Convert back to a QubitPauliString, ignoring the phase and omitting
+ * identity terms.
+ *
+ * @param spt tensor to convert
+ * @param qubits Element[q] gives the qubit with index q
+ */
+QubitPauliString to_qubit_pauli_string(
+    const SymplecticPauliTensor &spt, const qubit_vector_t &qubits);
+
+/**
+ * Convert back to a QubitPauliTensor, omitting identity terms.
+ *
+ * @param spt tensor to convert
+ * @param qubits Element[q] gives the qubit with index q
+ */
+QubitPauliTensor to_qubit_pauli_tensor(
+    const SymplecticPauliTensor &spt, const qubit_vector_t &qubits);
+
+/** Dense index of the given qubits, in the order given */
+qubit_index_t make_qubit_index(const qubit_vector_t &qubits);
+
+}  // namespace tket
@@ -0,0 +1,90 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+
+namespace tket {
+
+/**
+ * Set the number of threads used by the parallel algorithms in tket
+ * when the caller does not ask for a particular number.
+ *
+ * @param number_of_threads The limit; 0 (the default) means use
+ *    std::thread::hardware_concurrency().
+ */
+void set_default_number_of_threads(unsigned number_of_threads);
+
+/** The default number of threads, after resolving the value 0. */
+unsigned get_default_number_of_threads();
+
+/**
+ * The number of threads which parallel_for will use for the given
+ * arguments; thread indices passed to the task function are below this.
+ *
+ * @param n_tasks The number of tasks
+ * @param max_number_of_threads The largest number of threads to use;
+ *    0 means get_default_number_of_threads().
+ */
+unsigned get_number_of_threads(
+    std::size_t n_tasks, unsigned max_number_of_threads);
+
+namespace internal {
+void run_parallel_tasks(
+    std::size_t n_tasks, unsigned number_of_threads,
+    const std::function<void(std::size_t, unsigned)>& task);
+}  // namespace internal
+
+/**
+ * Call f(i, thread_index) for every i in [0, n_tasks), on up to
+ * get_number_of_threads(n_tasks, max_number_of_threads) threads.
+ *
+ * The threads belong to one process-wide pool, created on first use and
+ * kept alive afterwards, so a call costs no thread creation. The calling
+ * thread runs tasks as well, and only waits for tasks which other threads
+ * have already started, so parallel_for may be called from within a task.
+ *
+ * Tasks are taken in increasing order from a shared counter. No two
+ * tasks running at the same time get the same thread_index, so it can
+ * be used to select per-thread scratch space.
+ *
+ * If tasks throw, the remaining tasks are still run, and then the
+ * exception from the lowest-numbered failing task is rethrown.
+ */
+template <typename Function>
+void parallel_for(
+    std::size_t n_tasks, unsigned max_number_of_threads, const Function& f) {
+  const unsigned number_of_threads =
+      get_number_of_threads(n_tasks, max_number_of_threads);
+  if (number_of_threads <= 1) {
+    std::exception_ptr first_error;
+    for (std::size_t i = 0; i < n_tasks; ++i) {
+      try {
+        f(i, 0u);
+      } catch (...) {
+        if (!first_error) first_error = std::current_exception();
+      }
+    }
+    if (first_error) std::rethrow_exception(first_error);
+    return;
+  }
+  internal::run_parallel_tasks(
+      n_tasks, number_of_threads,
+      [&f](std::size_t i, unsigned thread_index) { f(i, thread_index); });
+}
+
+}  // namespace tket
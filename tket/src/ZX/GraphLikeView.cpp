@@ -0,0 +1,139 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "GraphLikeView.hpp"
+
+#include <algorithm>
+
+#include "Utils/GraphHeaders.hpp"
+
+namespace tket {
+
+namespace zx {
+
+GraphLikeView::GraphLikeView(ZXDiagram& diag) : simple_(true) {
+  ZXGraph& graph = *diag.get_graph();
+  // BGL_FORALL_VERTICES would find the member vertices() instead of boost's
+  auto [vi, v_end] = boost::vertices(graph);
+  for (; vi != v_end; ++vi) {
+    const ZXVert v = *vi;
+    index_.emplace(v, verts_.size());
+    verts_.push_back(v);
+    ops_.push_back(diag.get_vertex_ZXGen_ptr(v));
+  }
+  const unsigned n = verts_.size();
+  adjacency_.resize(n);
+  removed_.assign(n, false);
+  op_changed_.assign(n, false);
+  wires_changed_.assign(n, false);
+  BGL_FORALL_EDGES(w, graph, ZXGraph) {
+    const vertex_t s = index_.at(diag.source(w));
+    const vertex_t t = index_.at(diag.target(w));
+    if (s == t || !adjacency_[s].insert(t).second) {
+      simple_ = false;
+      continue;
+    }
+    adjacency_[t].insert(s);
+  }
+}
+
+std::vector<GraphLikeView::vertex_t> GraphLikeView::vertices() const {
+  std::vector<vertex_t> verts;
+  for (vertex_t v = 0; v < verts_.size(); ++v) {
+    if (!removed_[v]) verts.push_back(v);
+  }
+  return verts;
+}
+
+const PhasedGen& GraphLikeView::get_spider(vertex_t v) const {
+  return dynamic_cast<const PhasedGen&>(*ops_[v]);
+}
+
+void GraphLikeView::set_vertex_ZXGen_ptr(vertex_t v, const ZXGen_ptr& op) {
+  ops_[v] = op;
+  op_changed_[v] = true;
+}
+
+bool GraphLikeView::is_pauli_spider(vertex_t v) const {
+  return zx::is_pauli_spider(ops_[v]);
+}
+
+bool GraphLikeView::is_proper_clifford_spider(vertex_t v) const {
+  return zx::is_proper_clifford_spider(ops_[v]);
+}
+
+std::vector<GraphLikeView::vertex_t> GraphLikeView::neighbours(
+    vertex_t v) const {
+  std::vector<vertex_t> ns(adjacency_[v].begin(), adjacency_[v].end());
+  std::sort(ns.begin(), ns.end());
+  return ns;
+}
+
+std::uint64_t GraphLikeView::wire_key(vertex_t u, vertex_t v) {
+  if (u > v) std::swap(u, v);
+  return (static_cast<std::uint64_t>(u) << 32) | v;
+}
+
+void GraphLikeView::toggle_wire(vertex_t u, vertex_t v, QuantumType qtype) {
+  const std::uint64_t key = wire_key(u, v);
+  if (adjacency_[u].erase(v) != 0) {
+    adjacency_[v].erase(u);
+    new_wires_.erase(key);
+  } else {
+    adjacency_[u].insert(v);
+    adjacency_[v].insert(u);
+    new_wires_[key] = qtype;
+  }
+  wires_changed_[u] = true;
+  wires_changed_[v] = true;
+}
+
+void GraphLikeView::remove_vertex(vertex_t v) {
+  for (const vertex_t n : adjacency_[v]) {
+    adjacency_[n].erase(v);
+    new_wires_.erase(wire_key(v, n));
+  }
+  adjacency_[v].clear();
+  removed_[v] = true;
+}
+
+void GraphLikeView::apply_to(ZXDiagram& diag) const {
+  for (vertex_t u = 0; u < verts_.size(); ++u) {
+    if (removed_[u]) continue;
+    if (op_changed_[u]) diag.set_vertex_ZXGen_ptr(verts_[u], ops_[u]);
+    if (!wires_changed_[u]) continue;
+    // A changed wire has both ends marked, so each pair is handled from its
+    // lower end only. Wires to removed vertices go with those vertices.
+    const std::unordered_set<vertex_t>& adj = adjacency_[u];
+    for (const Wire& w : diag.adj_wires(verts_[u])) {
+      const vertex_t n = index_.at(diag.other_end(w, verts_[u]));
+      if (n < u || removed_[n]) continue;
+      if (adj.find(n) == adj.end() || new_wires_.count(wire_key(u, n)) != 0)
+        diag.remove_wire(w);
+    }
+    for (const vertex_t n : neighbours(u)) {
+      if (n < u) continue;
+      auto found = new_wires_.find(wire_key(u, n));
+      if (found != new_wires_.end())
+        diag.add_wire(verts_[u], verts_[n], ZXWireType::H, found->second);
+    }
+  }
+  for (vertex_t v = 0; v < verts_.size(); ++v) {
+    if (removed_[v]) diag.remove_vertex(verts_[v]);
+  }
+}
+
+}  // namespace zx
+
+}  // namespace tket
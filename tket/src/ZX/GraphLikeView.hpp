@@ -0,0 +1,105 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ZX/ZXDiagram.hpp"
+
+namespace tket {
+
+namespace zx {
+
+/**
+ * Compact copy of the connectivity of a graph-like ZXDiagram, used by the
+ * graph-like simplifications.
+ *
+ * Local complementation and pivoting toggle every wire between some sets of
+ * neighbours. On the boost graph, each toggle searches and edits edge lists
+ * of both ends, costing time in their degrees. Here vertices are numbered
+ * consecutively and each keeps a hash set of its neighbours, so toggling a
+ * wire takes constant time and a rewrite runs in time proportional to the
+ * size of the neighbourhoods involved.
+ *
+ * Only simple graphs (no parallel wires or self-loops) are represented. The
+ * net changes are written back to the diagram with `apply_to`; wires which
+ * were not toggled keep their original descriptors.
+ */
+class GraphLikeView {
+ public:
+  typedef unsigned vertex_t;
+
+  /**
+   * Copy the vertices and wires of a graph-like diagram. Vertices are
+   * numbered in the order of iteration through the underlying graph.
+   */
+  explicit GraphLikeView(ZXDiagram& diag);
+
+  // Whether the diagram had no parallel wires or self-loops
+  bool is_simple() const { return simple_; }
+
+  // All vertices not yet removed, in increasing order
+  std::vector<vertex_t> vertices() const;
+
+  const ZXGen_ptr& get_vertex_ZXGen_ptr(vertex_t v) const { return ops_[v]; }
+  const PhasedGen& get_spider(vertex_t v) const;
+  ZXType get_zxtype(vertex_t v) const { return ops_[v]->get_type(); }
+  QuantumType get_qtype(vertex_t v) const { return *ops_[v]->get_qtype(); }
+  void set_vertex_ZXGen_ptr(vertex_t v, const ZXGen_ptr& op);
+
+  bool is_pauli_spider(vertex_t v) const;
+  bool is_proper_clifford_spider(vertex_t v) const;
+
+  // Neighbours in increasing order
+  std::vector<vertex_t> neighbours(vertex_t v) const;
+
+  /**
+   * Remove the wire between `u` and `v` if there is one, otherwise add a
+   * Hadamard wire of the given quantum type.
+   */
+  void toggle_wire(vertex_t u, vertex_t v, QuantumType qtype);
+
+  void remove_vertex(vertex_t v);
+
+  // The view is only built from graph-like diagrams
+  bool is_graphlike_around(const std::vector<vertex_t>&) const { return true; }
+
+  /**
+   * Write the changes back to the diagram the view was built from, which
+   * must not have been modified in the meantime.
+   */
+  void apply_to(ZXDiagram& diag) const;
+
+ private:
+  static std::uint64_t wire_key(vertex_t u, vertex_t v);
+
+  std::vector<ZXVert> verts_;
+  std::unordered_map<ZXVert, vertex_t> index_;
+  std::vector<ZXGen_ptr> ops_;
+  std::vector<std::unordered_set<vertex_t>> adjacency_;
+  // Quantum types of the wires added since construction
+  std::unordered_map<std::uint64_t, QuantumType> new_wires_;
+  std::vector<bool> removed_;
+  std::vector<bool> op_changed_;
+  std::vector<bool> wires_changed_;
+  bool simple_;
+};
+
+}  // namespace zx
+
+}  // namespace tket
@@ -229,19 +229,11 @@ void ZXDiagram::set_wire_type(const Wire& w, ZXWireType type) {
 }
 
 bool ZXDiagram::is_pauli_spider(const ZXVert& v) const {
-  ZXGen_ptr op = get_vertex_ZXGen_ptr(v);
-  if (!is_spider_type(op->get_type())) return false;
-  const PhasedGen& bg = static_cast<const PhasedGen&>(*op);
-  std::optional<unsigned> pi2_mult = equiv_Clifford(bg.get_param());
-  return (pi2_mult && ((*pi2_mult % 2) == 0));
+  return zx::is_pauli_spider(get_vertex_ZXGen_ptr(v));
 }
 
 bool ZXDiagram::is_proper_clifford_spider(const ZXVert& v) const {
-  ZXGen_ptr op = get_vertex_ZXGen_ptr(v);
-  if (!is_spider_type(op->get_type())) return false;
-  const PhasedGen& bg = static_cast<const PhasedGen&>(*op);
-  std::optional<unsigned> pi2_mult = equiv_Clifford(bg.get_param());
-  return (pi2_mult && ((*pi2_mult % 2) == 1));
+  return zx::is_proper_clifford_spider(get_vertex_ZXGen_ptr(v));
 }
 
 static std::string graphviz_vertex_props(ZXGen_ptr op) {
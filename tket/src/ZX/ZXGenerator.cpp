@@ -297,6 +297,23 @@ bool PhasedGen::is_equal(const ZXGen& other) const {
   return this->param_ == other_basic.param_;
 }
 
+// The phase of a spider as a multiple of pi/2, if it is Clifford
+static std::optional<unsigned> spider_pi2_mult(const ZXGen_ptr& op) {
+  if (!is_spider_type(op->get_type())) return std::nullopt;
+  const PhasedGen& bg = static_cast<const PhasedGen&>(*op);
+  return equiv_Clifford(bg.get_param());
+}
+
+bool is_pauli_spider(const ZXGen_ptr& op) {
+  std::optional<unsigned> pi2_mult = spider_pi2_mult(op);
+  return (pi2_mult && ((*pi2_mult % 2) == 0));
+}
+
+bool is_proper_clifford_spider(const ZXGen_ptr& op) {
+  std::optional<unsigned> pi2_mult = spider_pi2_mult(op);
+  return (pi2_mult && ((*pi2_mult % 2) == 1));
+}
+
 /**
  * CliffordGen implementation
  */
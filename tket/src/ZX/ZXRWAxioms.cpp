@@ -43,72 +43,84 @@ bool Rewrite::red_to_green_fun(ZXDiagram& diag) {
 
 Rewrite Rewrite::red_to_green() { return Rewrite(red_to_green_fun); }
 
+/**
+ * Fuses into `v` every spider it can be fused with, following the wires
+ * added by each fusion. Fused spiders are added to `bin` rather than removed,
+ * so that the caller can keep iterating over the vertices.
+ */
+static bool fuse_into(
+    ZXDiagram& diag, const ZXVert& v, std::set<ZXVert>& bin) {
+  ZXType vtype = diag.get_zxtype(v);
+  if (!is_spider_type(vtype)) return false;
+  bool success = false;
+  /**
+   * Go through neighbours and find candidates for merging.
+   * A merge candidate is either of the same colour and connected by
+   * a normal edge or of different colour and connected by a Hadamard
+   * edge
+   **/
+  WireVec adj_vec = diag.adj_wires(v);
+  std::list<Wire> adj_list{adj_vec.begin(), adj_vec.end()};
+  while (!adj_list.empty()) {
+    Wire w = adj_list.front();
+    adj_list.pop_front();
+    ZXWireType wtype = diag.get_wire_type(w);
+    ZXVert u = diag.other_end(w, v);
+    if (bin.contains(u)) continue;
+    ZXType utype = diag.get_zxtype(u);
+    bool same_colour = vtype == utype;
+    if (!is_spider_type(utype) || u == v ||
+        (wtype == ZXWireType::Basic) != same_colour)
+      continue;
+    // The spiders `u` and `v` can be fused together
+    // We merge into `v` and remove `u` so that we can efficiently continue to
+    // search the neighbours
+    const PhasedGen& vspid = diag.get_vertex_ZXGen<PhasedGen>(v);
+    const PhasedGen& uspid = diag.get_vertex_ZXGen<PhasedGen>(u);
+    ZXGen_ptr new_spid = std::make_shared<const PhasedGen>(
+        vtype, vspid.get_param() + uspid.get_param(),
+        (vspid.get_qtype() == QuantumType::Classical ||
+         uspid.get_qtype() == QuantumType::Classical)
+            ? QuantumType::Classical
+            : QuantumType::Quantum);
+    diag.set_vertex_ZXGen_ptr(v, new_spid);
+    for (const Wire& uw : diag.adj_wires(u)) {
+      WireEnd u_end = diag.end_of(uw, u);
+      ZXVert other = diag.other_end(uw, u);
+      WireProperties uwp = diag.get_wire_info(uw);
+      // Wires may need flipping type to match colours
+      if (!same_colour)
+        uwp.type = (uwp.type == ZXWireType::Basic) ? ZXWireType::H
+                                                   : ZXWireType::Basic;
+      /**
+       * Basic edges between `(u, v)` will be ignored (these will be
+       * contracted); H edges will become self loops on `v`
+       **/
+      if (other == v && uwp.type == ZXWireType::Basic) continue;
+      // Self loops on `u` needs to become self loops on `v`
+      if (other == u) other = v;
+      // Connect edge to `v` instead with the same properties.
+      Wire new_w;
+      if (u_end == WireEnd::Source)
+        new_w = diag.add_wire(v, other, uwp);
+      else
+        new_w = diag.add_wire(other, v, uwp);
+      // Iteratively fuse along new wire if possible
+      adj_list.push_back(new_w);
+    }
+    // Remove `u`
+    bin.insert(u);
+    success = true;
+  }
+  return success;
+}
+
 bool Rewrite::spider_fusion_fun(ZXDiagram& diag) {
   bool success = false;
   std::set<ZXVert> bin;
   BGL_FORALL_VERTICES(v, *diag.graph, ZXGraph) {
     if (bin.contains(v)) continue;
-    ZXType vtype = diag.get_zxtype(v);
-    if (!is_spider_type(vtype)) continue;
-    /**
-     * Go through neighbours and find candidates for merging.
-     * A merge candidate is either of the same colour and connected by
-     * a normal edge or of different colour and connected by a Hadamard
-     * edge
-     **/
-    WireVec adj_vec = diag.adj_wires(v);
-    std::list<Wire> adj_list{adj_vec.begin(), adj_vec.end()};
-    while (!adj_list.empty()) {
-      Wire w = adj_list.front();
-      adj_list.pop_front();
-      ZXWireType wtype = diag.get_wire_type(w);
-      ZXVert u = diag.other_end(w, v);
-      if (bin.contains(u)) continue;
-      ZXType utype = diag.get_zxtype(u);
-      bool same_colour = vtype == utype;
-      if (!is_spider_type(utype) || u == v ||
-          (wtype == ZXWireType::Basic) != same_colour)
-        continue;
-      // The spiders `u` and `v` can be fused together
-      // We merge into `v` and remove `u` so that we can efficiently continue to
-      // search the neighbours
-      const PhasedGen& vspid = diag.get_vertex_ZXGen<PhasedGen>(v);
-      const PhasedGen& uspid = diag.get_vertex_ZXGen<PhasedGen>(u);
-      ZXGen_ptr new_spid = std::make_shared<const PhasedGen>(
-          vtype, vspid.get_param() + uspid.get_param(),
-          (vspid.get_qtype() == QuantumType::Classical ||
-           uspid.get_qtype() == QuantumType::Classical)
-              ? QuantumType::Classical
-              : QuantumType::Quantum);
-      diag.set_vertex_ZXGen_ptr(v, new_spid);
-      for (const Wire& uw : diag.adj_wires(u)) {
-        WireEnd u_end = diag.end_of(uw, u);
-        ZXVert other = diag.other_end(uw, u);
-        WireProperties uwp = diag.get_wire_info(uw);
-        // Wires may need flipping type to match colours
-        if (!same_colour)
-          uwp.type = (uwp.type == ZXWireType::Basic) ? ZXWireType::H
-                                                     : ZXWireType::Basic;
-        /**
-         * Basic edges between `(u, v)` will be ignored (these will be
-         * contracted); H edges will become self loops on `v`
-         **/
-        if (other == v && uwp.type == ZXWireType::Basic) continue;
-        // Self loops on `u` needs to become self loops on `v`
-        if (other == u) other = v;
-        // Connect edge to `v` instead with the same properties.
-        Wire new_w;
-        if (u_end == WireEnd::Source)
-          new_w = diag.add_wire(v, other, uwp);
-        else
-          new_w = diag.add_wire(other, v, uwp);
-        // Iteratively fuse along new wire if possible
-        adj_list.push_back(new_w);
-      }
-      // Remove `u`
-      bin.insert(u);
-      success = true;
-    }
+    success = fuse_into(diag, v, bin) || success;
   }
   for (ZXVert u : bin) {
     diag.remove_vertex(u);
@@ -116,7 +128,23 @@ bool Rewrite::spider_fusion_fun(ZXDiagram& diag) {
   return success;
 }
 
-Rewrite Rewrite::spider_fusion() { return Rewrite(spider_fusion_fun); }
+bool Rewrite::spider_fusion_at(
+    ZXDiagram& diag, const ZXVert& v, ZXVertSeqSet& worklist) {
+  std::set<ZXVert> bin;
+  if (!fuse_into(diag, v, bin)) return false;
+  for (ZXVert u : bin) {
+    worklist.erase(u);
+    diag.remove_vertex(u);
+  }
+  // The wires of the fused spiders now end at `v`
+  worklist.insert(v);
+  for (const ZXVert& n : diag.neighbours(v)) worklist.insert(n);
+  return true;
+}
+
+Rewrite Rewrite::spider_fusion() {
+  return Rewrite(spider_fusion_fun, spider_fusion_at);
+}
 
 bool Rewrite::self_loop_removal_fun(ZXDiagram& diag) {
   bool success = false;
@@ -157,46 +185,68 @@ bool Rewrite::self_loop_removal_fun(ZXDiagram& diag) {
 
 Rewrite Rewrite::self_loop_removal() { return Rewrite(self_loop_removal_fun); }
 
+/**
+ * Removes pairs of (effectively) Hadamard wires between `v` and another
+ * spider, adding the other ends of the removed wires to `others` if given.
+ */
+static bool remove_parallel_h(
+    ZXDiagram& diag, const ZXVert& v, ZXVertVec* others = nullptr) {
+  ZXType vtype = diag.get_zxtype(v);
+  if (!is_spider_type(vtype)) return false;
+  bool success = false;
+  QuantumType vqtype = *diag.get_qtype(v);
+  std::map<ZXVert, Wire> h_wires;
+  for (const Wire& w : diag.adj_wires(v)) {
+    ZXWireType wtype = diag.get_wire_type(w);
+    ZXVert u = diag.other_end(w, v);
+    ZXType utype = diag.get_zxtype(u);
+    if (!is_spider_type(utype)) continue;
+    if ((wtype == ZXWireType::H) != (utype == vtype)) continue;
+    // This is (effectively) a Hadamard edge
+    QuantumType uqtype = *diag.get_qtype(u);
+    QuantumType wqtype = diag.get_qtype(w);
+    if (vqtype == QuantumType::Classical &&
+        uqtype == QuantumType::Classical && wqtype == QuantumType::Quantum) {
+      // Doubled wire forms a pair
+      diag.remove_wire(w);
+      if (others) others->push_back(u);
+      success = true;
+      continue;
+    }
+    // Look for another wire to pair it with
+    auto added = h_wires.insert({u, w});
+    if (!added.second) {
+      // Already found the other of the pair, so remove both
+      Wire other_w = added.first->second;
+      h_wires.erase(added.first);
+      diag.remove_wire(w);
+      diag.remove_wire(other_w);
+      if (others) others->push_back(u);
+      success = true;
+    }
+  }
+  return success;
+}
+
 bool Rewrite::parallel_h_removal_fun(ZXDiagram& diag) {
   bool success = false;
   BGL_FORALL_VERTICES(v, *diag.graph, ZXGraph) {
-    ZXType vtype = diag.get_zxtype(v);
-    if (!is_spider_type(vtype)) continue;
-    QuantumType vqtype = *diag.get_qtype(v);
-    std::map<ZXVert, Wire> h_wires;
-    for (const Wire& w : diag.adj_wires(v)) {
-      ZXWireType wtype = diag.get_wire_type(w);
-      ZXVert u = diag.other_end(w, v);
-      ZXType utype = diag.get_zxtype(u);
-      if (!is_spider_type(utype)) continue;
-      if ((wtype == ZXWireType::H) != (utype == vtype)) continue;
-      // This is (effectively) a Hadamard edge
-      QuantumType uqtype = *diag.get_qtype(u);
-      QuantumType wqtype = diag.get_qtype(w);
-      if (vqtype == QuantumType::Classical &&
-          uqtype == QuantumType::Classical && wqtype == QuantumType::Quantum) {
-        // Doubled wire forms a pair
-        diag.remove_wire(w);
-        success = true;
-        continue;
-      }
-      // Look for another wire to pair it with
-      auto added = h_wires.insert({u, w});
-      if (!added.second) {
-        // Already found the other of the pair, so remove both
-        Wire other_w = added.first->second;
-        h_wires.erase(added.first);
-        diag.remove_wire(w);
-        diag.remove_wire(other_w);
-        success = true;
-      }
-    }
+    success = remove_parallel_h(diag, v) || success;
   }
   return success;
 }
 
+bool Rewrite::parallel_h_removal_at(
+    ZXDiagram& diag, const ZXVert& v, ZXVertSeqSet& worklist) {
+  ZXVertVec others;
+  if (!remove_parallel_h(diag, v, &others)) return false;
+  worklist.insert(v);
+  worklist.insert(others.begin(), others.end());
+  return true;
+}
+
 Rewrite Rewrite::parallel_h_removal() {
-  return Rewrite(parallel_h_removal_fun);
+  return Rewrite(parallel_h_removal_fun, parallel_h_removal_at);
 }
 
 }  // namespace zx
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "Utils/GraphHeaders.hpp"
 #include "ZX/Rewrite.hpp"
 
 namespace tket {
@@ -20,6 +21,9 @@ namespace zx {
 
 Rewrite::Rewrite(const RewriteFun &fun) : apply(fun) {}
 
+Rewrite::Rewrite(const RewriteFun &fun, const VertexRewriteFun &fun_at)
+    : apply(fun), apply_at(fun_at) {}
+
 Rewrite Rewrite::sequence(const std::vector<Rewrite> &rvec) {
   return Rewrite([=](ZXDiagram &diag) {
     bool success = false;
@@ -71,6 +75,33 @@ Rewrite Rewrite::repeat_while(const Rewrite &cond, const Rewrite &body) {
   });
 }
 
+Rewrite Rewrite::worklist(const std::vector<Rewrite> &rvec) {
+  std::vector<VertexRewriteFun> rules;
+  for (const Rewrite &rw : rvec) {
+    if (!rw.apply_at)
+      throw ZXError("Rewrite cannot be applied from a worklist");
+    rules.push_back(rw.apply_at);
+  }
+  return Rewrite([=](ZXDiagram &diag) {
+    bool success = false;
+    ZXVertSeqSet worklist;
+    BGL_FORALL_VERTICES(v, *diag.graph, ZXGraph) { worklist.insert(v); }
+    auto &queue = worklist.get<TagSeq>();
+    while (!queue.empty()) {
+      ZXVert v = queue.front();
+      queue.pop_front();
+      // A rewrite that fires queues `v` again if it remains
+      for (const VertexRewriteFun &rule : rules) {
+        if (rule(diag, v, worklist)) {
+          success = true;
+          break;
+        }
+      }
+    }
+    return success;
+  });
+}
+
 }  // namespace zx
 
 }  // namespace tket
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <set>
+
+#include "GraphLikeView.hpp"
 #include "Utils/GraphHeaders.hpp"
 #include "ZX/Rewrite.hpp"
 
@@ -19,180 +22,340 @@ namespace tket {
 
 namespace zx {
 
+namespace {
+
+/**
+ * Runs the graph-like rewrites directly on a ZXDiagram, with the same
+ * interface as GraphLikeView. Used for diagrams with parallel wires or
+ * self-loops, which the view does not represent, and for single matches
+ * driven by `Rewrite::worklist`. A worklist may interleave these matches
+ * with rewrites like `spider_fusion` which edit the diagram directly, and
+ * may run on diagrams which are only graph-like in places, so there is no
+ * view to keep in step; building one per match would cost time in the size
+ * of the whole diagram.
+ */
+class DiagramAdapter {
+ public:
+  typedef ZXVert vertex_t;
+
+  /**
+   * @param diag The diagram to rewrite
+   * @param check_locally Whether to check graph-likeness around each match,
+   *    for diagrams which are not known to be graph-like as a whole
+   */
+  DiagramAdapter(ZXDiagram& diag, bool check_locally)
+      : diag_(diag), check_locally_(check_locally) {}
+
+  ZXVertVec vertices() const {
+    auto [vi, v_end] = boost::vertices(*diag_.get_graph());
+    return {vi, v_end};
+  }
+  const PhasedGen& get_spider(const ZXVert& v) const {
+    return diag_.get_vertex_ZXGen<PhasedGen>(v);
+  }
+  ZXType get_zxtype(const ZXVert& v) const { return diag_.get_zxtype(v); }
+  QuantumType get_qtype(const ZXVert& v) const { return *diag_.get_qtype(v); }
+  void set_vertex_ZXGen_ptr(const ZXVert& v, const ZXGen_ptr& op) {
+    diag_.set_vertex_ZXGen_ptr(v, op);
+  }
+  bool is_pauli_spider(const ZXVert& v) const {
+    return diag_.is_pauli_spider(v);
+  }
+  bool is_proper_clifford_spider(const ZXVert& v) const {
+    return diag_.is_proper_clifford_spider(v);
+  }
+  ZXVertVec neighbours(const ZXVert& v) const { return diag_.neighbours(v); }
+  void toggle_wire(const ZXVert& u, const ZXVert& v, QuantumType qtype) {
+    std::optional<Wire> wire = diag_.wire_between(u, v);
+    if (wire)
+      diag_.remove_wire(*wire);
+    else
+      diag_.add_wire(u, v, ZXWireType::H, qtype);
+  }
+  void remove_vertex(const ZXVert& v) { diag_.remove_vertex(v); }
+
+  /**
+   * Whether the diagram looks graph-like to a rewrite about `centres`: the
+   * centres are ZSpiders joined to their neighbours by single H wires, and
+   * all wires within the neighbourhood, which may be toggled, are H wires.
+   */
+  bool is_graphlike_around(const ZXVertVec& centres) const {
+    if (!check_locally_) return true;
+    std::set<ZXVert> region{centres.begin(), centres.end()};
+    for (const ZXVert& c : centres) {
+      if (diag_.get_zxtype(c) != ZXType::ZSpider) return false;
+      std::set<ZXVert> ns;
+      for (const Wire& w : diag_.adj_wires(c)) {
+        ZXVert n = diag_.other_end(w, c);
+        if (n == c || diag_.get_wire_type(w) != ZXWireType::H ||
+            !ns.insert(n).second)
+          return false;
+        region.insert(n);
+      }
+    }
+    for (const ZXVert& n : region) {
+      for (const Wire& w : diag_.adj_wires(n)) {
+        if (region.contains(diag_.other_end(w, n)) &&
+            diag_.get_wire_type(w) != ZXWireType::H)
+          return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  ZXDiagram& diag_;
+  const bool check_locally_;
+};
+
+}  // namespace
+
 /**
  * Helper method for local complementation and pivoting.
  * Checks that all neighbours of some vertex v are also ZSpiders.
  * If v is Classical, all neighbours must also be Classical.
  */
+template <typename Graph>
 static bool can_complement_neighbourhood(
-    const ZXDiagram& diag, QuantumType vqtype, const ZXVertVec& neighbours) {
-  for (const ZXVert& n : neighbours) {
-    if (diag.get_zxtype(n) != ZXType::ZSpider ||
+    const Graph& graph, QuantumType vqtype,
+    const std::vector<typename Graph::vertex_t>& neighbours) {
+  for (const typename Graph::vertex_t& n : neighbours) {
+    if (graph.get_zxtype(n) != ZXType::ZSpider ||
         (vqtype == QuantumType::Classical &&
-         *diag.get_qtype(n) == QuantumType::Quantum))
+         graph.get_qtype(n) == QuantumType::Quantum))
       return false;
   }
   return true;
 }
 
-bool Rewrite::remove_interior_cliffords_fun(ZXDiagram& diag) {
-  if (!diag.is_graphlike()) return false;
+/**
+ * Performs local complementation about `v` and removes it, if `v` is an
+ * interior proper Clifford spider. Vertices affected are added to the
+ * worklist.
+ */
+template <typename Graph>
+static bool remove_interior_clifford(
+    Graph& graph, const typename Graph::vertex_t& v,
+    sequence_set_t<typename Graph::vertex_t>& worklist) {
+  typedef typename Graph::vertex_t vertex_t;
+  if (!graph.is_proper_clifford_spider(v)) return false;
+  const PhasedGen& spid = graph.get_spider(v);
+  QuantumType vqtype = *spid.get_qtype();
+  std::vector<vertex_t> neighbours = graph.neighbours(v);
+  if (!can_complement_neighbourhood(graph, vqtype, neighbours)) return false;
+  if (!graph.is_graphlike_around({v})) return false;
+  // Found an internal proper clifford spider on which we can perform local
+  // complementation
+  /**
+   * Complement the neighbourhoods' edges and modify the phase information
+   * on the neighbours.
+   **/
+  auto xi = neighbours.begin(), x_end = neighbours.end();
+  for (; xi != x_end; ++xi) {
+    for (auto yi = xi + 1; yi != x_end; ++yi) {
+      // Don't add a doubled edge between classicals to preserve graph-like
+      if (!(vqtype == QuantumType::Quantum &&
+            graph.get_qtype(*xi) == QuantumType::Classical &&
+            graph.get_qtype(*yi) == QuantumType::Classical)) {
+        graph.toggle_wire(*xi, *yi, vqtype);
+      }
+    }
+    // Changing the phase or the neighbourhood could introduce a new match
+    worklist.insert(*xi);
+    const PhasedGen& xi_op = graph.get_spider(*xi);
+    // If `v` is Quantum, Classical neighbours will pick up both the +theta
+    // and -theta phases, cancelling out
+    if (vqtype == QuantumType::Quantum &&
+        *xi_op.get_qtype() == QuantumType::Classical)
+      continue;
+    // Update phase information
+    ZXGen_ptr xi_new_op = std::make_shared<const PhasedGen>(
+        ZXType::ZSpider, xi_op.get_param() - spid.get_param(),
+        *xi_op.get_qtype());
+    graph.set_vertex_ZXGen_ptr(*xi, xi_new_op);
+  }
+  worklist.erase(v);
+  graph.remove_vertex(v);
+  return true;
+}
+
+template <typename Graph>
+static bool remove_interior_cliffords_from(Graph& graph) {
+  typedef typename Graph::vertex_t vertex_t;
   bool success = false;
-  ZXVertSeqSet candidates;
-  BGL_FORALL_VERTICES(v, *diag.graph, ZXGraph) { candidates.insert(v); }
-  auto& view = candidates.get<TagSeq>();
+  std::vector<vertex_t> verts = graph.vertices();
+  sequence_set_t<vertex_t> candidates{verts.begin(), verts.end()};
+  auto& view = candidates.template get<TagSeq>();
   while (!candidates.empty()) {
     auto it = view.begin();
-    ZXVert v = *it;
+    vertex_t v = *it;
     view.erase(it);
-    if (!diag.is_proper_clifford_spider(v)) continue;
-    const PhasedGen& spid = diag.get_vertex_ZXGen<PhasedGen>(v);
-    QuantumType vqtype = *spid.get_qtype();
-    ZXVertVec neighbours = diag.neighbours(v);
-    if (!can_complement_neighbourhood(diag, vqtype, neighbours)) continue;
-    // Found an internal proper clifford spider on which we can perform local
-    // complementation
-    /**
-     * Complement the neighbourhoods' edges and modify the phase information
-     * on the neighbours.
-     **/
-    auto xi = neighbours.begin(), x_end = neighbours.end();
-    for (; xi != x_end; ++xi) {
-      for (auto yi = xi + 1; yi != x_end; ++yi) {
-        // Don't add a doubled edge between classicals to preserve graph-like
-        if (!(vqtype == QuantumType::Quantum &&
-              *diag.get_qtype(*xi) == QuantumType::Classical &&
-              *diag.get_qtype(*yi) == QuantumType::Classical)) {
-          std::optional<Wire> wire = diag.wire_between(*xi, *yi);
-          if (wire)
-            diag.remove_wire(*wire);
-          else
-            diag.add_wire(*xi, *yi, ZXWireType::H, vqtype);
-        }
-      }
-      const PhasedGen& xi_op = diag.get_vertex_ZXGen<PhasedGen>(*xi);
-      // If `v` is Quantum, Classical neighbours will pick up both the +theta
-      // and -theta phases, cancelling out
-      if (vqtype == QuantumType::Quantum &&
-          *xi_op.get_qtype() == QuantumType::Classical)
-        continue;
-      // Update phase information
-      ZXGen_ptr xi_new_op = std::make_shared<const PhasedGen>(
-          ZXType::ZSpider, xi_op.get_param() - spid.get_param(),
-          *xi_op.get_qtype());
-      diag.set_vertex_ZXGen_ptr(*xi, xi_new_op);
-      candidates.insert(
-          *xi);  // Changing the phase could introduce a new proper Clifford
-    }
-    diag.remove_vertex(v);
-    success = true;
+    success = remove_interior_clifford(graph, v, candidates) || success;
   }
   return success;
 }
 
+bool Rewrite::remove_interior_cliffords_fun(ZXDiagram& diag) {
+  if (!diag.is_graphlike()) return false;
+  GraphLikeView graph(diag);
+  if (!graph.is_simple()) {
+    DiagramAdapter adapter(diag, false);
+    return remove_interior_cliffords_from(adapter);
+  }
+  if (!remove_interior_cliffords_from(graph)) return false;
+  graph.apply_to(diag);
+  return true;
+}
+
+bool Rewrite::remove_interior_cliffords_at(
+    ZXDiagram& diag, const ZXVert& v, ZXVertSeqSet& worklist) {
+  DiagramAdapter graph(diag, true);
+  return remove_interior_clifford(graph, v, worklist);
+}
+
 Rewrite Rewrite::remove_interior_cliffords() {
-  return Rewrite(remove_interior_cliffords_fun);
+  return Rewrite(remove_interior_cliffords_fun, remove_interior_cliffords_at);
 }
 
+template <typename Graph>
 static void add_phase_to_vertices(
-    ZXDiagram& diag, const ZXVertSeqSet& verts, const Expr& phase) {
-  for (const ZXVert& v : verts) {
-    const PhasedGen& old_spid = diag.get_vertex_ZXGen<PhasedGen>(v);
+    Graph& graph, const sequence_set_t<typename Graph::vertex_t>& verts,
+    const Expr& phase) {
+  for (const typename Graph::vertex_t& v : verts) {
+    const PhasedGen& old_spid = graph.get_spider(v);
     ZXGen_ptr new_spid = std::make_shared<const PhasedGen>(
         ZXType::ZSpider, old_spid.get_param() + phase, *old_spid.get_qtype());
-    diag.set_vertex_ZXGen_ptr(v, new_spid);
+    graph.set_vertex_ZXGen_ptr(v, new_spid);
   }
 }
 
+template <typename Graph>
 static void bipartite_complementation(
-    ZXDiagram& diag, const ZXVertSeqSet& sa, const ZXVertSeqSet& sb,
-    QuantumType qtype) {
-  for (const ZXVert& a : sa.get<TagSeq>()) {
-    for (const ZXVert& b : sb.get<TagSeq>()) {
+    Graph& graph, const sequence_set_t<typename Graph::vertex_t>& sa,
+    const sequence_set_t<typename Graph::vertex_t>& sb, QuantumType qtype) {
+  for (const typename Graph::vertex_t& a : sa.template get<TagSeq>()) {
+    for (const typename Graph::vertex_t& b : sb.template get<TagSeq>()) {
       // Don't add a doubled edge between classicals to preserve graph-like
       if (!(qtype == QuantumType::Quantum &&
-            *diag.get_qtype(a) == QuantumType::Classical &&
-            *diag.get_qtype(b) == QuantumType::Classical)) {
-        std::optional<Wire> wire = diag.wire_between(a, b);
-        if (wire)
-          diag.remove_wire(*wire);
-        else
-          diag.add_wire(a, b, ZXWireType::H, qtype);
+            graph.get_qtype(a) == QuantumType::Classical &&
+            graph.get_qtype(b) == QuantumType::Classical)) {
+        graph.toggle_wire(a, b, qtype);
       }
     }
   }
 }
 
-bool Rewrite::remove_interior_paulis_fun(ZXDiagram& diag) {
-  if (!diag.is_graphlike()) return false;
+/**
+ * Pivots about the wire between `v` and an adjacent Pauli spider and removes
+ * both, if `v` is an interior Pauli spider with such a neighbour. Vertices
+ * affected are added to the worklist.
+ */
+template <typename Graph>
+static bool remove_interior_pauli_pair(
+    Graph& graph, const typename Graph::vertex_t& v,
+    sequence_set_t<typename Graph::vertex_t>& worklist) {
+  typedef typename Graph::vertex_t vertex_t;
+  typedef sequence_set_t<vertex_t> vertex_set_t;
+  // Check `v` is an interior Pauli
+  if (!graph.is_pauli_spider(v)) return false;
+  std::vector<vertex_t> v_ns = graph.neighbours(v);
+  QuantumType vqtype = graph.get_qtype(v);
+  if (!can_complement_neighbourhood(graph, vqtype, v_ns)) return false;
+  // Look for an interior Pauli neighbour
+  bool pair_found = false;
+  vertex_t u{};
+  std::vector<vertex_t> u_ns;
+  for (const vertex_t& n : v_ns) {
+    if (!graph.is_pauli_spider(n)) continue;
+    std::vector<vertex_t> n_ns = graph.neighbours(n);
+    QuantumType nqtype = graph.get_qtype(n);
+    if (can_complement_neighbourhood(graph, nqtype, n_ns) &&
+        graph.is_graphlike_around({v, n})) {
+      pair_found = true;
+      u = n;
+      u_ns = n_ns;
+      break;
+    }
+  }
+  if (!pair_found) return false;
+  // Found a valid pair
+  // Identify the three sets from the neighbourhoods of `u` and `v`
+  vertex_set_t excl_v{v_ns.begin(), v_ns.end()};
+  excl_v.erase(u);
+  vertex_set_t excl_u, joint;
+  auto& lookup_v = excl_v.template get<TagKey>();
+  for (const vertex_t& nu : u_ns) {
+    if (lookup_v.find(nu) != lookup_v.end())
+      joint.insert(nu);
+    else
+      excl_u.insert(nu);
+  }
+  excl_u.erase(v);
+  excl_v.erase(joint.begin(), joint.end());
+  const PhasedGen& v_spid = graph.get_spider(v);
+  const PhasedGen& u_spid = graph.get_spider(u);
+
+  add_phase_to_vertices(
+      graph, joint, v_spid.get_param() + u_spid.get_param() + 1.);
+  add_phase_to_vertices(graph, excl_u, v_spid.get_param());
+  add_phase_to_vertices(graph, excl_v, u_spid.get_param());
+
+  // Because `can_complement_neighbourhood` checks all neighbours,
+  // v and u have the same QuantumType
+  bipartite_complementation(graph, joint, excl_u, vqtype);
+  bipartite_complementation(graph, joint, excl_v, vqtype);
+  bipartite_complementation(graph, excl_u, excl_v, vqtype);
+
+  worklist.erase(u);
+  worklist.erase(v);
+  graph.remove_vertex(u);
+  graph.remove_vertex(v);
+  // Changing the phase or the neighbourhood could introduce a new match
+  for (const vertex_set_t* verts : {&joint, &excl_u, &excl_v}) {
+    for (const vertex_t& n : verts->template get<TagSeq>()) {
+      worklist.insert(n);
+    }
+  }
+  return true;
+}
+
+template <typename Graph>
+static bool remove_interior_paulis_from(Graph& graph) {
+  typedef typename Graph::vertex_t vertex_t;
   bool success = false;
-  ZXVertSeqSet candidates;  // Need an indirect iterator as BGL_FORALL_VERTICES
-                            // breaks when removing the current vertex
-  BGL_FORALL_VERTICES(v, *diag.graph, ZXGraph) { candidates.insert(v); }
-  auto& view = candidates.get<TagSeq>();
+  // Need an indirect iterator as vertices are removed during the iteration
+  std::vector<vertex_t> verts = graph.vertices();
+  sequence_set_t<vertex_t> candidates{verts.begin(), verts.end()};
+  auto& view = candidates.template get<TagSeq>();
   while (!candidates.empty()) {
     auto it = view.begin();
-    ZXVert v = *it;
+    vertex_t v = *it;
     view.erase(it);
-    // Check `v` is an interior Pauli
-    if (!diag.is_pauli_spider(v)) continue;
-    ZXVertVec v_ns = diag.neighbours(v);
-    QuantumType vqtype = *diag.get_qtype(v);
-    if (!can_complement_neighbourhood(diag, vqtype, v_ns)) continue;
-    // Look for an interior Pauli neighbour
-    bool pair_found = false;
-    ZXVert u;
-    ZXVertVec u_ns;
-    for (const ZXVert& n : v_ns) {
-      if (!diag.is_pauli_spider(n)) continue;
-      ZXVertVec n_ns = diag.neighbours(n);
-      QuantumType nqtype = *diag.get_qtype(n);
-      if (can_complement_neighbourhood(diag, nqtype, n_ns)) {
-        pair_found = true;
-        u = n;
-        u_ns = n_ns;
-        break;
-      }
-    }
-    if (!pair_found) continue;
-    // Found a valid pair
-    // Identify the three sets from the neighbourhoods of `u` and `v`
-    ZXVertSeqSet excl_v{v_ns.begin(), v_ns.end()};
-    excl_v.erase(u);
-    ZXVertSeqSet excl_u, joint;
-    auto& lookup_v = excl_v.get<TagKey>();
-    for (const ZXVert& nu : u_ns) {
-      if (lookup_v.find(nu) != lookup_v.end())
-        joint.insert(nu);
-      else
-        excl_u.insert(nu);
-    }
-    excl_u.erase(v);
-    excl_v.erase(joint.begin(), joint.end());
-    const PhasedGen& v_spid = diag.get_vertex_ZXGen<PhasedGen>(v);
-    const PhasedGen& u_spid = diag.get_vertex_ZXGen<PhasedGen>(u);
-
-    add_phase_to_vertices(
-        diag, joint, v_spid.get_param() + u_spid.get_param() + 1.);
-    add_phase_to_vertices(diag, excl_u, v_spid.get_param());
-    add_phase_to_vertices(diag, excl_v, u_spid.get_param());
-
-    // Because `can_complement_neighbourhood` checks all neighbours,
-    // v and u have the same QuantumType
-    bipartite_complementation(diag, joint, excl_u, vqtype);
-    bipartite_complementation(diag, joint, excl_v, vqtype);
-    bipartite_complementation(diag, excl_u, excl_v, vqtype);
-
-    diag.remove_vertex(u);
-    diag.remove_vertex(v);
-    candidates.erase(u);
-    success = true;
+    success = remove_interior_pauli_pair(graph, v, candidates) || success;
   }
   return success;
 }
 
+bool Rewrite::remove_interior_paulis_fun(ZXDiagram& diag) {
+  if (!diag.is_graphlike()) return false;
+  GraphLikeView graph(diag);
+  if (!graph.is_simple()) {
+    DiagramAdapter adapter(diag, false);
+    return remove_interior_paulis_from(adapter);
+  }
+  if (!remove_interior_paulis_from(graph)) return false;
+  graph.apply_to(diag);
+  return true;
+}
+
+bool Rewrite::remove_interior_paulis_at(
+    ZXDiagram& diag, const ZXVert& v, ZXVertSeqSet& worklist) {
+  DiagramAdapter graph(diag, true);
+  return remove_interior_pauli_pair(graph, v, worklist);
+}
+
 Rewrite Rewrite::remove_interior_paulis() {
-  return Rewrite(remove_interior_paulis_fun);
+  return Rewrite(remove_interior_paulis_fun, remove_interior_paulis_at);
 }
 
 bool Rewrite::extend_at_boundary_paulis_fun(ZXDiagram& diag) {
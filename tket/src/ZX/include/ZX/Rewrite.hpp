@@ -42,6 +42,14 @@ class Rewrite {
  public:
   typedef std::function<bool(ZXDiagram&)> RewriteFun;
   typedef std::function<unsigned(const ZXDiagram&)> Metric;
+  /**
+   * A rewrite attempted at a single vertex, as used by `worklist`.
+   * Returns true iff some change is made, in which case every remaining
+   * vertex whose generator or incident wires changed is added to the
+   * worklist, and every removed vertex is erased from it.
+   */
+  typedef std::function<bool(ZXDiagram&, const ZXVert&, ZXVertSeqSet&)>
+      VertexRewriteFun;
 
   /**
    * The actual rewrite to be applied.
@@ -50,6 +58,12 @@ class Rewrite {
    */
   const RewriteFun apply;
 
+  /**
+   * The rewrite restricted to matches at a single vertex, for rewrites that
+   * can be driven by `worklist`; empty otherwise.
+   */
+  const VertexRewriteFun apply_at;
+
   ///////////////
   // Combinators//
   ///////////////
@@ -59,6 +73,25 @@ class Rewrite {
   static Rewrite repeat_with_metric(const Rewrite& rw, const Metric& eval);
   static Rewrite repeat_while(const Rewrite& cond, const Rewrite& body);
 
+  /**
+   * Applies the rewrites until none of them matches anywhere, without
+   * rescanning the diagram. Every vertex starts on a worklist; each vertex
+   * taken from it is tried against the rewrites in turn, and when one fires
+   * only the vertices it changed are queued to be matched again.
+   *
+   * Supported by `spider_fusion`, `parallel_h_removal`,
+   * `remove_interior_cliffords` and `remove_interior_paulis`. The graph-like
+   * rewrites only check that the diagram is graph-like around each match,
+   * not over the whole diagram, so they can be mixed with the others. This
+   * means they may fire on diagrams which are not graph-like as a whole,
+   * where `repeat(sequence(rvec))` would leave them untouched; matches are
+   * also tried in a different order, so the two need not give the same
+   * diagram.
+   *
+   * @throws ZXError if some rewrite has no vertex-local form
+   */
+  static Rewrite worklist(const std::vector<Rewrite>& rvec);
+
   //////////////////
   // Decompositions//
   //////////////////
@@ -163,6 +196,7 @@ class Rewrite {
 
  private:
   Rewrite(const RewriteFun& fun);
+  Rewrite(const RewriteFun& fun, const VertexRewriteFun& fun_at);
 
   static bool decompose_boxes_fun(ZXDiagram& diag);
   static bool basic_wires_fun(ZXDiagram& diag);
@@ -172,10 +206,18 @@ class Rewrite {
   static bool spider_fusion_fun(ZXDiagram& diag);
   static bool self_loop_removal_fun(ZXDiagram& diag);
   static bool parallel_h_removal_fun(ZXDiagram& diag);
+  static bool spider_fusion_at(
+      ZXDiagram& diag, const ZXVert& v, ZXVertSeqSet& worklist);
+  static bool parallel_h_removal_at(
+      ZXDiagram& diag, const ZXVert& v, ZXVertSeqSet& worklist);
   static bool separate_boundaries_fun(ZXDiagram& diag);
   static bool io_extension_fun(ZXDiagram& diag);
   static bool remove_interior_cliffords_fun(ZXDiagram& diag);
   static bool remove_interior_paulis_fun(ZXDiagram& diag);
+  static bool remove_interior_cliffords_at(
+      ZXDiagram& diag, const ZXVert& v, ZXVertSeqSet& worklist);
+  static bool remove_interior_paulis_at(
+      ZXDiagram& diag, const ZXVert& v, ZXVertSeqSet& worklist);
   static bool extend_at_boundary_paulis_fun(ZXDiagram& diag);
 };
 
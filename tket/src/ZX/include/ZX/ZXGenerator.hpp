@@ -265,6 +265,16 @@ class PhasedGen : public BasicGen {
   const Expr param_;
 };
 
+/**
+ * Whether a generator is a spider with phase an integer multiple of pi.
+ */
+bool is_pauli_spider(const ZXGen_ptr& op);
+
+/**
+ * Whether a generator is a spider with phase an odd multiple of pi/2.
+ */
+bool is_proper_clifford_spider(const ZXGen_ptr& op);
+
 /**
  * Implementation of BasicGen for Clifford generators.
  * The basis is determined by the ZX type, and the boolean parameter determines
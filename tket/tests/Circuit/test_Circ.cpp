@@ -16,6 +16,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <memory>
 #include <sstream>
+#include <thread>
 #include <unsupported/Eigen/MatrixFunctions>
 #include <vector>
 
@@ -1236,6 +1237,77 @@ SCENARIO("Test depth_by_type method") {
   }
 }
 
+SCENARIO("Depth queries remain correct as the circuit changes") {
+  Circuit circ(3);
+  circ.add_op<unsigned>(OpType::H, {0});
+  Vertex cx = circ.add_op<unsigned>(OpType::CX, {0, 1});
+  circ.add_op<unsigned>(OpType::CX, {1, 2});
+  circ.add_op<unsigned>(OpType::T, {2});
+  REQUIRE(circ.depth() == 4);
+  REQUIRE(circ.depth_by_type(OpType::CX) == 2);
+  GIVEN("A removed vertex") {
+    circ.remove_vertex(
+        cx, Circuit::GraphRewiring::Yes, Circuit::VertexDeletion::Yes);
+    CHECK(circ.depth() == 2);
+    CHECK(circ.depth_by_type(OpType::CX) == 1);
+  }
+  GIVEN("An added vertex") {
+    circ.add_op<unsigned>(OpType::CX, {2, 0});
+    CHECK(circ.depth() == 5);
+    CHECK(circ.depth_by_type(OpType::CX) == 3);
+  }
+  GIVEN("A substitution") {
+    Circuit replacement(2);
+    replacement.add_op<unsigned>(OpType::H, {1});
+    replacement.add_op<unsigned>(OpType::CZ, {0, 1});
+    replacement.add_op<unsigned>(OpType::H, {1});
+    circ.substitute(replacement, cx);
+    CHECK(circ.depth() == 5);
+    CHECK(circ.depth_by_type(OpType::CX) == 1);
+  }
+  GIVEN("A changed op") {
+    circ.dag[cx].op = get_op_ptr(OpType::CZ);
+    CHECK(circ.depth() == 4);
+    CHECK(circ.depth_by_type(OpType::CX) == 1);
+    CHECK(circ.depth_by_type(OpType::CZ) == 1);
+  }
+  GIVEN("A copy assignment") {
+    Circuit other(2);
+    other.add_op<unsigned>(OpType::X, {0});
+    circ = other;
+    CHECK(circ.depth() == 1);
+    const VertexVec order = circ.vertices_in_order();
+    CHECK(order.size() == circ.n_vertices());
+  }
+  GIVEN("A barrier") {
+    circ.add_barrier(std::vector<unsigned>{0, 1, 2});
+    CHECK(circ.depth() == 4);
+  }
+}
+
+SCENARIO("Depth queries on a shared const circuit") {
+  Circuit circ(4);
+  for (unsigned i = 0; i < 50; ++i) {
+    circ.add_op<unsigned>(OpType::CX, {i % 4, (i + 1) % 4});
+    circ.add_op<unsigned>(OpType::H, {(i + 2) % 4});
+  }
+  const Circuit& shared = circ;
+  const unsigned depth = Circuit(circ).depth();
+  // Each thread may be the one to fill the cached order.
+  std::vector<unsigned> depths(4, 0);
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < depths.size(); ++t) {
+    threads.emplace_back(
+        [&shared, &depths, t]() { depths[t] = shared.depth(); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (unsigned d : depths) {
+    CHECK(d == depth);
+  }
+}
+
 SCENARIO("Test extracting slice segments") {
   GIVEN("A simple circuit") {
     Circuit circ(3);
@@ -0,0 +1,200 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+#include "Circuit/Circuit.hpp"
+#include "Circuit/CompactDAG.hpp"
+
+namespace tket {
+namespace test_CompactDAG {
+
+static void check_topological(
+    const CompactDAG& g, const std::vector<CompactDAG::VertexIndex>& order) {
+  REQUIRE(order.size() == g.n_vertices());
+  std::vector<unsigned> position(g.vertex_capacity(), 0);
+  for (unsigned i = 0; i < order.size(); ++i) {
+    position[order[i]] = i;
+  }
+  for (CompactDAG::EdgeIndex e = 0; e < g.edge_capacity(); ++e) {
+    if (!g.edge_exists(e)) continue;
+    CHECK(position[g.source(e)] < position[g.target(e)]);
+  }
+}
+
+SCENARIO("Building a CompactDAG from a circuit") {
+  Circuit circ(3, 1);
+  circ.add_op<unsigned>(OpType::H, {0});
+  circ.add_op<unsigned>(OpType::CX, {0, 1});
+  circ.add_op<unsigned>(OpType::CCX, {2, 1, 0});
+  circ.add_op<unsigned>(OpType::Rz, 0.25, {2});
+  circ.add_measure(2, 0);
+  circ.add_conditional_gate<unsigned>(OpType::X, {}, {1}, {0}, 1);
+
+  VertexVec vertex_map;
+  const CompactDAG g(circ, &vertex_map);
+  REQUIRE(g.n_vertices() == circ.n_vertices());
+  REQUIRE(g.n_edges() == circ.n_edges());
+  REQUIRE(vertex_map.size() == g.n_vertices());
+  for (CompactDAG::VertexIndex v = 0; v < g.vertex_capacity(); ++v) {
+    const Vertex orig = vertex_map[v];
+    CHECK(g.get_op(v) == circ.get_Op_ptr_from_Vertex(orig));
+    CHECK(g.in_degree(v) == circ.n_in_edges(orig));
+    CHECK(g.out_degree(v) == circ.n_out_edges(orig));
+  }
+  for (CompactDAG::VertexIndex v = 0; v < g.vertex_capacity(); ++v) {
+    for (port_t p = 0; p < g.in_degree(v); ++p) {
+      const CompactDAG::EdgeIndex e = g.get_nth_in_edge(v, p);
+      REQUIRE(e != CompactDAG::null_index);
+      const Edge orig = circ.get_nth_in_edge(vertex_map[v], p);
+      CHECK(vertex_map[g.source(e)] == circ.source(orig));
+      CHECK(g.get_source_port(e) == circ.get_source_port(orig));
+      CHECK(g.get_edgetype(e) == circ.get_edgetype(orig));
+    }
+  }
+  check_topological(g, g.topological_order());
+}
+
+SCENARIO("Building a CompactDAG in a given vertex order") {
+  Circuit circ(3);
+  circ.add_op<unsigned>(OpType::CX, {2, 1});
+  circ.add_op<unsigned>(OpType::H, {0});
+  circ.add_op<unsigned>(OpType::CCX, {0, 1, 2});
+  circ.add_op<unsigned>(OpType::T, {1});
+  const VertexVec order = circ.vertices_in_order();
+  const CompactDAG g(circ.dag, order);
+  REQUIRE(g.n_vertices() == order.size());
+  REQUIRE(g.n_edges() == circ.n_edges());
+  for (CompactDAG::VertexIndex v = 0; v < g.n_vertices(); ++v) {
+    CHECK(g.get_op(v) == circ.get_Op_ptr_from_Vertex(order[v]));
+    for (CompactDAG::EdgeIndex e : g.in_edges(v)) {
+      CHECK(g.source(e) < v);
+      const Edge orig = circ.get_nth_in_edge(order[v], g.get_target_port(e));
+      CHECK(order[g.source(e)] == circ.source(orig));
+    }
+  }
+}
+
+SCENARIO("Circuit depth computed on the compact graph") {
+  // Without barriers or classical wires, the depth is the number of slices.
+  Circuit circ(5);
+  std::mt19937 rng(3);
+  for (unsigned i = 0; i < 200; ++i) {
+    const unsigned q0 = rng() % 5;
+    const unsigned q1 = (q0 + 1 + rng() % 4) % 5;
+    switch (rng() % 3) {
+      case 0:
+        circ.add_op<unsigned>(OpType::H, {q0});
+        break;
+      case 1:
+        circ.add_op<unsigned>(OpType::CX, {q0, q1});
+        break;
+      default:
+        circ.add_op<unsigned>(OpType::CZ, {q1, q0});
+    }
+  }
+  CHECK(circ.depth() == circ.get_slices().size());
+  Circuit cx_only(circ);
+  VertexList to_remove;
+  BGL_FORALL_VERTICES(v, cx_only.dag, DAG) {
+    const OpType type = cx_only.get_OpType_from_Vertex(v);
+    if (type == OpType::H || type == OpType::CZ) to_remove.push_back(v);
+  }
+  cx_only.remove_vertices(
+      to_remove, Circuit::GraphRewiring::Yes, Circuit::VertexDeletion::Yes);
+  const unsigned cx_depth = cx_only.get_slices().size();
+  CHECK(circ.depth_by_type(OpType::CX) == cx_depth);
+  CHECK(circ.depth_by_types({OpType::CX}) == cx_depth);
+}
+
+SCENARIO("Removing and adding elements of a CompactDAG") {
+  Circuit circ(2);
+  circ.add_op<unsigned>(OpType::H, {0});
+  const Vertex cx = circ.add_op<unsigned>(OpType::CX, {0, 1});
+  circ.add_op<unsigned>(OpType::S, {1});
+  VertexVec vertex_map;
+  CompactDAG g(circ, &vertex_map);
+  const unsigned n_vertices = g.n_vertices();
+  const unsigned n_edges = g.n_edges();
+
+  GIVEN("A removed gate, with its wires reconnected") {
+    const CompactDAG::VertexIndex v =
+        std::find(vertex_map.begin(), vertex_map.end(), cx) -
+        vertex_map.begin();
+    std::vector<std::pair<CompactDAG::VertexIndex, CompactDAG::VertexIndex>>
+        wires;
+    for (port_t p = 0; p < 2; ++p) {
+      wires.push_back(
+          {g.source(g.get_nth_in_edge(v, p)),
+           g.target(g.get_nth_out_edge(v, p))});
+    }
+    g.remove_vertex(v);
+    CHECK(!g.vertex_exists(v));
+    CHECK(g.n_vertices() == n_vertices - 1);
+    CHECK(g.n_edges() == n_edges - 4);
+    CHECK(g.vertex_capacity() == n_vertices);
+    for (const auto& wire : wires) {
+      g.add_edge(wire.first, 0, wire.second, 0, EdgeType::Quantum);
+    }
+    CHECK(g.n_edges() == n_edges - 2);
+    // Freed edge slots are reused.
+    CHECK(g.edge_capacity() == n_edges);
+    check_topological(g, g.topological_order());
+
+    WHEN("A new vertex is added") {
+      const CompactDAG::VertexIndex w =
+          g.add_vertex(VertexProperties(get_op_ptr(OpType::Z)));
+      THEN("The free slot is reused") {
+        CHECK(w == v);
+        CHECK(g.vertex_capacity() == n_vertices);
+      }
+    }
+    WHEN("The graph is compacted") {
+      const auto old_index = g.compact();
+      THEN("There are no holes, and vertices are in topological order") {
+        CHECK(old_index.size() == n_vertices - 1);
+        CHECK(g.vertex_capacity() == n_vertices - 1);
+        CHECK(g.edge_capacity() == n_edges - 2);
+        for (CompactDAG::EdgeIndex e = 0; e < g.edge_capacity(); ++e) {
+          CHECK(g.source(e) < g.target(e));
+        }
+        const DAG dag = g.to_dag();
+        CHECK(boost::num_vertices(dag) == n_vertices - 1);
+        CHECK(boost::num_edges(dag) == n_edges - 2);
+      }
+    }
+  }
+  GIVEN("A vertex with many out-edges") {
+    const CompactDAG::VertexIndex v =
+        g.add_vertex(VertexProperties(get_op_ptr(OpType::Input)));
+    std::vector<CompactDAG::VertexIndex> targets;
+    for (unsigned i = 0; i < 3 * CompactDAG::inline_ports; ++i) {
+      targets.push_back(
+          g.add_vertex(VertexProperties(get_op_ptr(OpType::Output))));
+      g.add_edge(v, i, targets.back(), 0, EdgeType::Classical);
+    }
+    REQUIRE(g.out_degree(v) == 3 * CompactDAG::inline_ports);
+    for (unsigned i = 0; i < targets.size(); i += 2) {
+      g.remove_vertex(targets[i]);
+    }
+    REQUIRE(g.out_degree(v) == targets.size() / 2);
+    for (unsigned i = 0; i < g.out_degree(v); ++i) {
+      CHECK(g.target(g.out_edges(v)[i]) == targets[2 * i + 1]);
+    }
+  }
+}
+
+}  // namespace test_CompactDAG
+}  // namespace tket
@@ -117,6 +117,75 @@ SCENARIO("Disconnected graphs") {
   }
 }
 
+SCENARIO("Precomputed distances") {
+  GIVEN("a grid graph") {
+    using Conn = DirectedGraph<Node>::Connection;
+    const unsigned rows = 12, cols = 11;
+    std::vector<Conn> edges;
+    for (unsigned r = 0; r < rows; r++) {
+      for (unsigned c = 0; c < cols; c++) {
+        if (c + 1 < cols) {
+          edges.push_back({Node(r * cols + c), Node(r * cols + c + 1)});
+        }
+        if (r + 1 < rows) {
+          edges.push_back({Node((r + 1) * cols + c), Node(r * cols + c)});
+        }
+      }
+    }
+    DirectedGraph<Node> lazy(edges);
+    DirectedGraph<Node> eager(edges);
+    eager.precompute_distances(4);
+    REQUIRE(eager.distances_precomputed());
+    const DistanceMatrix& matrix = eager.get_distance_matrix();
+    CHECK(matrix.size() == rows * cols);
+    CHECK(matrix.is_connected());
+    THEN("All queries agree with the lazily computed distances") {
+      for (unsigned i = 0; i < rows * cols; i++) {
+        CHECK(eager.get_distances(Node(i)) == lazy.get_distances(Node(i)));
+        for (unsigned j = 0; j < rows * cols; j++) {
+          const unsigned d = lazy.get_distance(Node(i), Node(j));
+          CHECK(eager.get_distance(Node(i), Node(j)) == d);
+          CHECK(
+              matrix(
+                  eager.get_node_index(Node(i)),
+                  eager.get_node_index(Node(j))) == d);
+        }
+      }
+      CHECK(eager.get_diameter() == rows + cols - 2);
+      CHECK(lazy.get_diameter() == rows + cols - 2);
+      CHECK(
+          eager.nodes_at_distance(Node(0), 3) ==
+          lazy.nodes_at_distance(Node(0), 3));
+    }
+    THEN("Distance rows are read from the matrix") {
+      const std::size_t root = eager.get_node_index(Node(5));
+      const DistanceRow row = eager.get_distances(Node(5));
+      REQUIRE(row.size() == rows * cols);
+      for (std::size_t j = 0; j < row.size(); j++) {
+        CHECK(row[j] == matrix(root, j));
+      }
+      CHECK(row == lazy.get_distances(Node(5)));
+      CHECK_FALSE(row < lazy.get_distances(Node(5)));
+      const std::vector<std::size_t> smaller(row.size(), 0);
+      CHECK(DistanceRow(smaller) < row);
+      CHECK_FALSE(row < DistanceRow(smaller));
+    }
+    WHEN("The graph is modified") {
+      CHECK(eager.get_distances(Node(0)).size() == rows * cols);
+      eager.add_node(Node(1000));
+      THEN("The precomputed distances are discarded") {
+        CHECK(eager.get_distances(Node(0)).size() == rows * cols + 1);
+        REQUIRE(!eager.distances_precomputed());
+        CHECK_THROWS_AS(eager.get_distance_matrix(), std::logic_error);
+        eager.precompute_distances();
+        CHECK(!eager.get_distance_matrix().is_connected());
+        CHECK_THROWS(eager.get_distance(Node(0), Node(1000)));
+        CHECK_THROWS(eager.get_diameter());
+      }
+    }
+  }
+}
+
 }  // namespace test_DirectedGraph
 }  // namespace tests
 }  // namespace graphs
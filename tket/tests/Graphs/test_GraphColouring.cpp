@@ -13,12 +13,14 @@
 // limitations under the License.
 
 #include <catch2/catch_test_macros.hpp>
+#include <numeric>
 #include <tkrng/RNG.hpp>
 
 #include "EdgeSequence.hpp"
 #include "EdgeSequenceColouringParameters.hpp"
 #include "GraphTestingRoutines.hpp"
 #include "Graphs/AdjacencyData.hpp"
+#include "Graphs/CSRGraph.hpp"
 #include "Graphs/GraphColouring.hpp"
 #include "RandomGraphGeneration.hpp"
 #include "RandomPlanarGraphs.hpp"
@@ -341,6 +343,57 @@ static void test_Mycielski_graph_sequence(
   }
 }
 
+SCENARIO("Test greedy colourings of compressed graphs") {
+  RNG rng;
+  for (std::size_t number_of_vertices : {0, 1, 10, 100, 1500}) {
+    for (std::size_t percentage : {2, 20, 60}) {
+      for (bool bipartite : {false, true}) {
+        // Vertices of equal parity are never joined in a bipartite graph.
+        vector<vector<CSRGraph::vertex_t>> upper_neighbours(
+            number_of_vertices);
+        vector<vector<std::size_t>> raw_data(number_of_vertices);
+        for (std::size_t i = 0; i < number_of_vertices; ++i) {
+          for (std::size_t j = i + 1; j < number_of_vertices; ++j) {
+            if (bipartite && (i + j) % 2 == 0) continue;
+            if (rng.check_percentage(percentage)) {
+              upper_neighbours[i].push_back(j);
+              raw_data[i].push_back(j);
+            }
+          }
+        }
+        const CSRGraph graph(upper_neighbours);
+        const AdjacencyData adjacency_data(raw_data);
+        REQUIRE(graph.get_number_of_vertices() == number_of_vertices);
+        REQUIRE(
+            graph.get_number_of_edges() ==
+            adjacency_data.get_number_of_edges());
+
+        vector<std::size_t> order(number_of_vertices);
+        std::iota(order.begin(), order.end(), 0);
+        const auto greedy =
+            GraphColouringRoutines::get_greedy_colouring(graph, order);
+        GraphTestingRoutines::require_valid_suboptimal_colouring(
+            greedy, adjacency_data);
+
+        const auto dsatur = GraphColouringRoutines::get_dsatur_colouring(graph);
+        GraphTestingRoutines::require_valid_suboptimal_colouring(
+            dsatur, adjacency_data);
+        // DSATUR is exact for bipartite graphs.
+        if (bipartite) CHECK(dsatur.number_of_colours <= 2);
+
+        // The result does not depend upon the number of threads.
+        const auto jones_plassmann =
+            GraphColouringRoutines::get_jones_plassmann_colouring(graph, 1);
+        GraphTestingRoutines::require_valid_suboptimal_colouring(
+            jones_plassmann, adjacency_data);
+        CHECK(
+            GraphColouringRoutines::get_jones_plassmann_colouring(graph, 4)
+                .colours == jones_plassmann.colours);
+      }
+    }
+  }
+}
+
 SCENARIO("Test Mycielski graphs") {
   AdjacencyData graph(2);
 
@@ -15,8 +15,10 @@
 #include <symengine/eval.h>
 
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
 #include <optional>
 #include <stdexcept>
+#include <thread>
 #include <unsupported/Eigen/MatrixFunctions>
 
 #include "../testutil.hpp"
@@ -36,7 +38,10 @@
 namespace tket {
 namespace test_Ops {
 
-void clear_symbol_table() { SymTable::get_registered_symbols().clear(); }
+void clear_symbol_table() {
+  std::lock_guard<std::mutex> lock(SymTable::get_mutex());
+  SymTable::get_registered_symbols().clear();
+}
 
 SCENARIO("Check op retrieval overloads are working correctly.", "[ops]") {
   GIVEN("Transposes retrieval at the Op level") {
@@ -322,6 +327,67 @@ SCENARIO("Examples for is_singleq_unitary") {
   }
 }
 
+SCENARIO("Numeric gates are interned", "[ops]") {
+  GIVEN("Parameter-free gates") {
+    const Op_ptr cx0 = get_op_ptr(OpType::CX);
+    const Op_ptr cx1 = get_op_ptr(OpType::CX);
+    REQUIRE(cx0 == cx1);
+    REQUIRE(get_op_ptr(OpType::H) != cx0);
+  }
+  GIVEN("Gates with numeric parameters") {
+    const Op_ptr rz0 = get_op_ptr(OpType::Rz, 0.25);
+    const Op_ptr rz1 = get_op_ptr(OpType::Rz, 0.25);
+    REQUIRE(rz0 == rz1);
+    REQUIRE(get_op_ptr(OpType::Rz, 0.5) != rz0);
+    REQUIRE(get_op_ptr(OpType::Rx, 0.25) != rz0);
+    REQUIRE(get_op_ptr(OpType::Rz, 1) == get_op_ptr(OpType::Rz, 1));
+    // An integer and a double parameter are distinct expressions
+    const Op_ptr rz_int = get_op_ptr(OpType::Rz, 1);
+    const Op_ptr rz_double = get_op_ptr(OpType::Rz, 1.);
+    REQUIRE(rz_int != rz_double);
+    REQUIRE(rz_int->get_params() == std::vector<Expr>{Expr(1)});
+    REQUIRE(rz_double->get_params() == std::vector<Expr>{Expr(1.)});
+  }
+  GIVEN("Gates with variable arity") {
+    const Op_ptr cnx2 = get_op_ptr(OpType::CnX, std::vector<Expr>{}, 2);
+    const Op_ptr cnx3 = get_op_ptr(OpType::CnX, std::vector<Expr>{}, 3);
+    REQUIRE(cnx2 != cnx3);
+    REQUIRE(cnx2->n_qubits() == 2);
+    REQUIRE(cnx3->n_qubits() == 3);
+  }
+  GIVEN("Symbolic gates") {
+    clear_symbol_table();
+    const Sym s = SymEngine::symbol("s");
+    const Op_ptr rz0 = get_op_ptr(OpType::Rz, Expr(s));
+    const Op_ptr rz1 = get_op_ptr(OpType::Rz, Expr(s));
+    REQUIRE(rz0 != rz1);
+    REQUIRE(*rz0 == *rz1);
+    // Creating the gates registered their symbol
+    REQUIRE(SymTable::fresh_symbol("s")->get_name() == "s_1");
+  }
+  GIVEN("A gate with a NaN parameter") {
+    const Op_ptr rz0 = get_op_ptr(OpType::Rz, std::nan(""));
+    const Op_ptr rz1 = get_op_ptr(OpType::Rz, std::nan(""));
+    REQUIRE(rz0 != rz1);
+    REQUIRE_FALSE(*rz0 == *rz0);
+  }
+  GIVEN("A cleared cache") {
+    const Op_ptr rz0 = get_op_ptr(OpType::Rz, 0.25);
+    clear_numeric_gate_cache();
+    const Op_ptr rz1 = get_op_ptr(OpType::Rz, 0.25);
+    REQUIRE(rz0 != rz1);
+    REQUIRE(*rz0 == *rz1);
+    REQUIRE(get_op_ptr(OpType::Rz, 0.25) == rz1);
+  }
+  GIVEN("Gates built on different threads") {
+    const Op_ptr cx0 = get_op_ptr(OpType::CX);
+    Op_ptr cx1;
+    std::thread([&cx1]() { cx1 = get_op_ptr(OpType::CX); }).join();
+    REQUIRE(cx0 != cx1);
+    REQUIRE(*cx0 == *cx1);
+  }
+}
+
 SCENARIO("Check exceptions in basic Op methods", "[ops]") {
   GIVEN("A non-single-qubit gate for get_tk1_angles") {
     const Op_ptr o = get_op_ptr(OpType::CX);
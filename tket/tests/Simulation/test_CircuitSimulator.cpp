@@ -21,10 +21,12 @@
 
 #include "../Gate/GatesData.hpp"
 #include "../testutil.hpp"
+#include "Circuit/Boxes.hpp"
 #include "Circuit/CircPool.hpp"
 #include "Circuit/CircUtils.hpp"
 #include "ComparisonFunctions.hpp"
 #include "Gate/GateUnitaryMatrix.hpp"
+#include "Gate/GateUnitaryMatrixError.hpp"
 #include "Gate/GateUnitaryMatrixUtils.hpp"
 #include "Simulation/CircuitSimulator.hpp"
 #include "Transformations/OptimisationPass.hpp"
@@ -211,6 +213,309 @@ SCENARIO("Directly simulate circuits with >= 3 qubit gates") {
   REQUIRE(is_unitary(u));
 }
 
+SCENARIO("Statevectors are consistent with unitaries") {
+  Circuit circ(5);
+  circ.add_op<unsigned>(OpType::H, {0});
+  circ.add_op<unsigned>(OpType::Rx, 0.3, {4});
+  circ.add_op<unsigned>(OpType::CX, {0, 3});
+  circ.add_op<unsigned>(OpType::CRy, 0.7, {4, 1});
+  circ.add_op<unsigned>(OpType::CCX, {3, 0, 2});
+  circ.add_op<unsigned>(OpType::TK1, {0.1, 0.2, 0.3}, {2});
+  circ.add_op<unsigned>(OpType::ZZPhase, 0.45, {2, 4});
+  circ.add_op<unsigned>(OpType::CSWAP, {1, 4, 0});
+  circ.add_op<unsigned>(OpType::CnRy, 0.1234, {4, 2, 0, 3});
+  circ.add_op<unsigned>(OpType::SWAP, {1, 3});
+  circ.add_phase(0.25);
+  const StateVector sv = tket_sim::get_statevector(circ);
+  const Eigen::MatrixXcd u = tket_sim::get_unitary(circ);
+  CHECK(tket_sim::compare_statevectors_or_unitaries(sv, u.col(0)));
+
+  GIVEN("An implicit qubit permutation") {
+    Transforms::clifford_simp().apply(circ);
+    const StateVector sv_permuted = tket_sim::get_statevector(circ);
+    CHECK(tket_sim::compare_statevectors_or_unitaries(sv, sv_permuted));
+  }
+  GIVEN("More qubits than the default limit") {
+    const unsigned n_qubits = 16;
+    Circuit ghz(n_qubits);
+    ghz.add_op<unsigned>(OpType::H, {0});
+    for (unsigned ii = 1; ii < n_qubits; ++ii) {
+      ghz.add_op<unsigned>(OpType::CX, {ii - 1, ii});
+    }
+    REQUIRE_THROWS(tket_sim::get_statevector(ghz));
+    const StateVector ghz_sv = tket_sim::get_statevector(ghz, EPS, n_qubits);
+    CHECK(std::abs(ghz_sv(0) - 1.0 / std::sqrt(2.0)) < EPS);
+    CHECK(std::abs(ghz_sv(ghz_sv.size() - 1) - 1.0 / std::sqrt(2.0)) < EPS);
+    CHECK(std::abs(ghz_sv.norm() - 1.0) < EPS);
+  }
+}
+
+SCENARIO("Simulation results do not depend on the number of threads") {
+  // Every amplitude is updated by exactly the same arithmetic,
+  // whichever thread does it, so the results should be identical.
+  const auto get_circuit = [](unsigned n_qubits) {
+    Circuit circ(n_qubits);
+    for (unsigned ii = 0; ii < n_qubits; ++ii) {
+      circ.add_op<unsigned>(OpType::TK1, {0.1 * ii, 0.2, 0.3 + ii}, {ii});
+    }
+    for (unsigned ii = 0; ii + 1 < n_qubits; ++ii) {
+      circ.add_op<unsigned>(OpType::ZZPhase, 0.17, {ii, ii + 1});
+      circ.add_op<unsigned>(OpType::CCX, {ii, (ii + 2) % n_qubits, ii + 1});
+    }
+    return circ;
+  };
+  const Circuit small_circ = get_circuit(10);
+  const Circuit large_circ = get_circuit(17);
+  tket_sim::set_max_number_of_threads(1);
+  CHECK(tket_sim::get_max_number_of_threads() == 1);
+  const auto unitary = tket_sim::get_unitary(small_circ);
+  const auto statevector = tket_sim::get_statevector(large_circ, EPS, 17);
+
+  tket_sim::set_max_number_of_threads(4);
+  CHECK(tket_sim::get_unitary(small_circ) == unitary);
+  CHECK(tket_sim::get_statevector(large_circ, EPS, 17) == statevector);
+
+  // Restore the default.
+  tket_sim::set_max_number_of_threads(0);
+  CHECK(tket_sim::get_max_number_of_threads() >= 1);
+}
+
+SCENARIO("Vectorised kernels agree with the scalar kernels") {
+  // Random dense 1, 2 and 3 qubit gates on every qubit, so that some
+  // act on the lowest bits of the index (which the vectorised kernels
+  // cannot process in groups) and some do not.
+  const unsigned n_qubits = 7;
+  Circuit circ(n_qubits);
+  int seed = 0;
+  for (unsigned ii = 0; ii < n_qubits; ++ii) {
+    const Eigen::Matrix2cd u = random_unitary(2, seed++);
+    circ.add_box(Unitary1qBox(u), std::vector<unsigned>{ii});
+  }
+  for (unsigned ii = 0; ii + 1 < n_qubits; ++ii) {
+    const Eigen::Matrix4cd u = random_unitary(4, seed++);
+    circ.add_box(Unitary2qBox(u), std::vector<unsigned>{ii, ii + 1});
+    circ.add_box(Unitary2qBox(u), std::vector<unsigned>{n_qubits - 1, ii});
+  }
+  for (unsigned ii = 0; ii + 2 < n_qubits; ++ii) {
+    const Matrix8cd u = random_unitary(8, seed++);
+    circ.add_box(Unitary3qBox(u), std::vector<unsigned>{ii, ii + 2, ii + 1});
+  }
+  // Apply every gate separately, so that each one goes through a kernel.
+  const unsigned max_fused_qubits = tket_sim::get_max_fused_qubits();
+  tket_sim::set_max_fused_qubits(0);
+
+  tket_sim::set_simd_level(tket_sim::SimdLevel::SCALAR);
+  CHECK(tket_sim::get_simd_level() == tket_sim::SimdLevel::SCALAR);
+  const auto unitary = tket_sim::get_unitary(circ);
+  const auto statevector = tket_sim::get_statevector(circ);
+
+  const tket_sim::SimdLevel supported = tket_sim::get_supported_simd_level();
+  for (const auto level :
+       {tket_sim::SimdLevel::AVX2, tket_sim::SimdLevel::AVX512}) {
+    if (static_cast<int>(level) > static_cast<int>(supported)) {
+      CHECK_THROWS_AS(tket_sim::set_simd_level(level), std::invalid_argument);
+      continue;
+    }
+    tket_sim::set_simd_level(level);
+    CHECK(tket_sim::get_simd_level() == level);
+    CHECK(tket_sim::get_unitary(circ).isApprox(unitary, 1e-12));
+    CHECK(tket_sim::get_statevector(circ).isApprox(statevector, 1e-12));
+  }
+
+  // Restore the defaults.
+  tket_sim::set_simd_level(supported);
+  tket_sim::set_max_fused_qubits(max_fused_qubits);
+}
+
+SCENARIO("Gate fusion does not change simulation results") {
+  const unsigned n_qubits = 7;
+  Circuit circ(n_qubits);
+  for (unsigned layer = 0; layer < 20; ++layer) {
+    for (unsigned ii = 0; ii < n_qubits; ++ii) {
+      circ.add_op<unsigned>(
+          OpType::TK1, {0.1 * layer + 0.3 * ii, 0.7 * ii, 0.2 * layer}, {ii});
+    }
+    for (unsigned ii = layer % 2; ii + 1 < n_qubits; ii += 2) {
+      if (layer % 3 == 0) {
+        circ.add_op<unsigned>(OpType::CX, {ii + 1, ii});
+      } else {
+        circ.add_op<unsigned>(OpType::CX, {ii, ii + 1});
+      }
+    }
+    circ.add_op<unsigned>(
+        OpType::CCX, {1 + layer % (n_qubits - 2), 0, n_qubits - 1});
+    circ.add_op<unsigned>(OpType::CnRy, 0.123, {1, 2, 3, 4, 5, 6});
+  }
+  REQUIRE(tket_sim::get_max_fused_qubits() == 3);
+
+  tket_sim::set_max_fused_qubits(0);
+  const auto unfused_unitary = tket_sim::get_unitary(circ);
+  const auto unfused_statevector = tket_sim::get_statevector(circ);
+  for (unsigned max_fused_qubits = 1; max_fused_qubits <= n_qubits;
+       ++max_fused_qubits) {
+    tket_sim::set_max_fused_qubits(max_fused_qubits);
+    const auto unitary = tket_sim::get_unitary(circ);
+    const auto statevector = tket_sim::get_statevector(circ);
+    CHECK((unitary - unfused_unitary).cwiseAbs().maxCoeff() < EPS);
+    CHECK((statevector - unfused_statevector).cwiseAbs().maxCoeff() < EPS);
+  }
+  // Restore the default.
+  tket_sim::set_max_fused_qubits(3);
+}
+
+SCENARIO("Sampling shots from circuits with measurements") {
+  const unsigned n_shots = 1000;
+  GIVEN("A Bell circuit with final measurements") {
+    Circuit circ(2, 2);
+    circ.add_op<unsigned>(OpType::H, {0});
+    circ.add_op<unsigned>(OpType::CX, {0, 1});
+    circ.add_measure(0, 0);
+    circ.add_measure(1, 1);
+    const auto table = tket_sim::sample_shots(circ, n_shots, 1);
+    REQUIRE(table.get_number_of_shots() == n_shots);
+    REQUIRE(table.get_number_of_bits() == 2);
+    REQUIRE(table.get_words_per_shot() == 1);
+    unsigned number_of_ones = 0;
+    for (unsigned shot = 0; shot < n_shots; ++shot) {
+      CHECK(table.get_bit(shot, 0) == table.get_bit(shot, 1));
+      number_of_ones += table.get_bit(shot, 0);
+    }
+    CHECK(number_of_ones > 400);
+    CHECK(number_of_ones < 600);
+    // The results are determined by the seed.
+    CHECK(tket_sim::sample_shots(circ, n_shots, 1) == table);
+  }
+  GIVEN("Mid-circuit measurement, reset and conditional gates") {
+    Circuit circ(3, 3);
+    circ.add_op<unsigned>(OpType::H, {0});
+    circ.add_op<unsigned>(OpType::Ry, 0.4, {2});
+    circ.add_measure(0, 0);
+    circ.add_conditional_gate<unsigned>(OpType::X, {}, {1}, {0}, 1);
+    circ.add_op<unsigned>(OpType::Reset, {0});
+    circ.add_measure(1, 1);
+    circ.add_measure(0, 2);
+    const auto table = tket_sim::sample_shots(circ, n_shots, 2);
+    unsigned number_of_ones = 0;
+    for (unsigned shot = 0; shot < n_shots; ++shot) {
+      CHECK(table.get_bit(shot, 0) == table.get_bit(shot, 1));
+      CHECK(!table.get_bit(shot, 2));
+      number_of_ones += table.get_bit(shot, 0);
+    }
+    CHECK(number_of_ones > 400);
+    CHECK(number_of_ones < 600);
+  }
+  GIVEN("Many bits") {
+    Circuit circ(2, 70);
+    circ.add_op<unsigned>(OpType::X, {1});
+    circ.add_measure(1, 65);
+    const auto table = tket_sim::sample_shots(circ, 3, 3);
+    REQUIRE(table.get_words_per_shot() == 2);
+    for (unsigned shot = 0; shot < 3; ++shot) {
+      const auto bits = table.get_shot(shot);
+      for (unsigned bit = 0; bit < 70; ++bit) {
+        CHECK(bits[bit] == (bit == 65));
+      }
+      CHECK(table.get_shot_words(shot)[1] == 2);
+    }
+  }
+  GIVEN("Too many qubits") {
+    Circuit circ(21);
+    CHECK_THROWS_AS(tket_sim::sample_shots(circ, 1, 0), GateUnitaryMatrixError);
+  }
+}
+
+SCENARIO("Sampling shots from Clifford circuits with a stabiliser tableau") {
+  GIVEN("A GHZ circuit on thousands of qubits") {
+    const unsigned n_qubits = 2000;
+    const unsigned n_shots = 100;
+    Circuit circ(n_qubits, n_qubits);
+    circ.add_op<unsigned>(OpType::H, {0});
+    for (unsigned qb = 0; qb + 1 < n_qubits; ++qb) {
+      circ.add_op<unsigned>(OpType::CX, {qb, qb + 1});
+    }
+    for (unsigned qb = 0; qb < n_qubits; ++qb) {
+      circ.add_measure(qb, qb);
+    }
+    const auto table = tket_sim::sample_stabiliser_shots(circ, n_shots, 1);
+    REQUIRE(table.get_number_of_shots() == n_shots);
+    REQUIRE(table.get_number_of_bits() == n_qubits);
+    unsigned number_of_ones = 0;
+    for (unsigned shot = 0; shot < n_shots; ++shot) {
+      const auto bits = table.get_shot(shot);
+      for (unsigned bit = 1; bit < n_qubits; ++bit) {
+        CHECK(bits[bit] == bits[0]);
+      }
+      number_of_ones += bits[0];
+    }
+    CHECK(number_of_ones > 25);
+    CHECK(number_of_ones < 75);
+    // The results are determined by the seed.
+    CHECK(tket_sim::sample_stabiliser_shots(circ, n_shots, 1) == table);
+  }
+  GIVEN("Determined outcomes, reset and classically controlled Paulis") {
+    Circuit circ(3, 4);
+    circ.add_op<unsigned>(OpType::X, {0});
+    circ.add_op<unsigned>(OpType::H, {1});
+    circ.add_op<unsigned>(OpType::S, {1});
+    circ.add_op<unsigned>(OpType::S, {1});
+    circ.add_op<unsigned>(OpType::H, {1});
+    circ.add_measure(0, 0);
+    circ.add_measure(1, 1);
+    circ.add_conditional_gate<unsigned>(OpType::X, {}, {2}, {0}, 1);
+    circ.add_conditional_gate<unsigned>(OpType::Z, {}, {2}, {1}, 1);
+    circ.add_op<unsigned>(OpType::Reset, {0});
+    circ.add_measure(2, 2);
+    circ.add_measure(0, 3);
+    const auto table = tket_sim::sample_stabiliser_shots(circ, 10, 2);
+    for (unsigned shot = 0; shot < 10; ++shot) {
+      CHECK(table.get_shot(shot) == std::vector<bool>{true, true, true, false});
+    }
+  }
+  GIVEN("Small circuits, compared with the statevector sampler") {
+    const unsigned n_shots = 4000;
+    Circuit circ(4, 4);
+    circ.add_op<unsigned>(OpType::H, {0});
+    circ.add_op<unsigned>(OpType::CX, {0, 1});
+    circ.add_op<unsigned>(OpType::S, {1});
+    circ.add_op<unsigned>(OpType::H, {2});
+    circ.add_op<unsigned>(OpType::CZ, {2, 3});
+    circ.add_op<unsigned>(OpType::V, {3});
+    circ.add_measure(1, 1);
+    circ.add_conditional_gate<unsigned>(OpType::X, {}, {2}, {1}, 1);
+    circ.add_op<unsigned>(OpType::H, {1});
+    circ.add_op<unsigned>(OpType::Reset, {0});
+    circ.add_op<unsigned>(OpType::CY, {3, 0});
+    circ.add_op<unsigned>(OpType::Sdg, {2});
+    circ.add_op<unsigned>(OpType::H, {2});
+    circ.add_op<unsigned>(OpType::SWAP, {1, 3});
+    for (unsigned qb = 0; qb < 4; ++qb) {
+      circ.add_measure(qb, qb);
+    }
+    const auto stabiliser_table =
+        tket_sim::sample_stabiliser_shots(circ, n_shots, 3);
+    const auto statevector_table = tket_sim::sample_shots(circ, n_shots, 4);
+    std::array<unsigned, 16> stabiliser_counts{};
+    std::array<unsigned, 16> statevector_counts{};
+    for (unsigned shot = 0; shot < n_shots; ++shot) {
+      ++stabiliser_counts[stabiliser_table.get_shot_words(shot)[0]];
+      ++statevector_counts[statevector_table.get_shot_words(shot)[0]];
+    }
+    for (unsigned outcome = 0; outcome < 16; ++outcome) {
+      const double stabiliser_frequency =
+          double(stabiliser_counts[outcome]) / n_shots;
+      const double statevector_frequency =
+          double(statevector_counts[outcome]) / n_shots;
+      CHECK(std::abs(stabiliser_frequency - statevector_frequency) < 0.05);
+    }
+  }
+  GIVEN("A non-Clifford gate") {
+    Circuit circ(1, 1);
+    circ.add_op<unsigned>(OpType::T, {0});
+    circ.add_measure(0, 0);
+    CHECK_THROWS_AS(tket_sim::sample_stabiliser_shots(circ, 1, 0), BadOpType);
+  }
+}
+
 SCENARIO("Directly simulate circuits with CircBox") {
   Circuit w(3);
   w.add_op<unsigned>(OpType::Rx, 0.5, {0});
@@ -0,0 +1,182 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+#include "Utils/GF2Matrix.hpp"
+
+namespace tket {
+namespace test_GF2Matrix {
+
+static MatrixXb random_matrix(
+    unsigned rows, unsigned cols, std::mt19937& rng) {
+  MatrixXb m(rows, cols);
+  for (unsigned r = 0; r < rows; ++r) {
+    for (unsigned c = 0; c < cols; ++c) {
+      m(r, c) = rng() % 2;
+    }
+  }
+  return m;
+}
+
+static MatrixXb multiply(const MatrixXb& a, const MatrixXb& b) {
+  MatrixXb p = MatrixXb::Zero(a.rows(), b.cols());
+  for (unsigned r = 0; r < a.rows(); ++r) {
+    for (unsigned k = 0; k < a.cols(); ++k) {
+      if (!a(r, k)) continue;
+      for (unsigned c = 0; c < b.cols(); ++c) {
+        p(r, c) ^= b(k, c);
+      }
+    }
+  }
+  return p;
+}
+
+SCENARIO("Packing and unpacking GF(2) matrices") {
+  std::mt19937 rng(1);
+  // Sizes either side of the word boundaries.
+  for (unsigned cols : {0u, 1u, 63u, 64u, 65u, 130u}) {
+    const MatrixXb m = random_matrix(70, cols, rng);
+    const GF2Matrix g(m);
+    CHECK(g.get_n_rows() == 70);
+    CHECK(g.get_n_cols() == cols);
+    CHECK(g.get_matrix() == m);
+    CHECK(g.transpose().get_matrix() == m.transpose());
+  }
+  GIVEN("Row and column operations") {
+    const MatrixXb m = random_matrix(80, 100, rng);
+    GF2Matrix g(m);
+    MatrixXb expected = m;
+    g.row_add(3, 70);
+    expected.row(70) = expected.row(70).cwiseNotEqual(expected.row(3));
+    g.col_add(99, 0);
+    expected.col(0) = expected.col(0).cwiseNotEqual(expected.col(99));
+    g.swap_rows(1, 79);
+    expected.row(1).swap(expected.row(79));
+    CHECK(g.get_matrix() == expected);
+  }
+  GIVEN("The identity") {
+    const GF2Matrix id = GF2Matrix::identity(100);
+    CHECK(id.is_identity());
+    CHECK(id.get_matrix() == MatrixXb::Identity(100, 100));
+    CHECK_FALSE(GF2Matrix(100, 100).is_identity());
+    CHECK(GF2Matrix(100, 100).is_zero());
+  }
+}
+
+SCENARIO("Patel-Markov-Hayes elimination on packed matrices") {
+  std::mt19937 rng(2);
+  for (unsigned n : {5u, 40u, 100u}) {
+    const MatrixXb m = random_matrix(n, n, rng);
+    GF2Matrix g(m);
+    const std::vector<std::pair<unsigned, unsigned>> ops =
+        g.gaussian_elimination_row_ops();
+    // The free function gives the same operations, and the reduced matrix
+    // is the result of applying them.
+    CHECK(ops == gaussian_elimination_row_ops(m));
+    GF2Matrix applied(m);
+    for (const std::pair<unsigned, unsigned>& op : ops) {
+      applied.row_add(op.first, op.second);
+    }
+    CHECK(applied == g);
+    // Both eliminations reach the same reduced row echelon form.
+    GF2Matrix reduced(m);
+    const std::vector<unsigned> pivots = reduced.row_reduce();
+    CHECK(reduced == g);
+    CHECK(pivots.size() == GF2Matrix(m).rank());
+  }
+  GIVEN("An invertible matrix") {
+    GF2Matrix g = GF2Matrix::identity(90);
+    for (unsigned i = 0; i < 1000; ++i) {
+      const unsigned r0 = rng() % 90;
+      const unsigned r1 = rng() % 90;
+      if (r0 != r1) g.row_add(r0, r1);
+    }
+    CHECK(g.rank() == 90);
+    g.gaussian_elimination_row_ops(8);
+    CHECK(g.is_identity());
+  }
+}
+
+SCENARIO("Reduced row echelon form with M4RI") {
+  std::mt19937 rng(3);
+  GIVEN("A matrix of deficient rank") {
+    // The last 50 rows are combinations of the first 150.
+    const MatrixXb top = random_matrix(150, 300, rng);
+    MatrixXb m(200, 300);
+    m.topRows(150) = top;
+    m.bottomRows(50) = multiply(random_matrix(50, 150, rng), top);
+    GF2Matrix g(m);
+    const std::vector<unsigned> pivots = g.row_reduce();
+    REQUIRE(pivots.size() == 150);
+    for (unsigned i = 0; i < pivots.size(); ++i) {
+      for (unsigned r = 0; r < 200; ++r) {
+        CHECK(g(r, pivots[i]) == (r == i));
+      }
+      // Entries before the pivot are zero
+      for (unsigned c = 0; c < pivots[i]; ++c) {
+        CHECK_FALSE(g(i, c));
+      }
+    }
+    for (unsigned r = 150; r < 200; ++r) {
+      for (unsigned c = 0; c < 300; ++c) {
+        CHECK_FALSE(g(r, c));
+      }
+    }
+  }
+  GIVEN("Pivots restricted to the first columns") {
+    const MatrixXb m = random_matrix(60, 100, rng);
+    GF2Matrix g(m);
+    const std::vector<unsigned> pivots = g.row_reduce(30);
+    REQUIRE(pivots.size() == 30);
+    for (unsigned i = 0; i < pivots.size(); ++i) {
+      CHECK(pivots[i] == i);
+    }
+    // The other columns are carried along by the same row operations.
+    GF2Matrix reduced(m.leftCols(30));
+    reduced.row_reduce();
+    CHECK(g.get_matrix().leftCols(30) == reduced.get_matrix());
+    CHECK(GF2Matrix(g.get_matrix()).rank() == GF2Matrix(m).rank());
+  }
+}
+
+SCENARIO("Solving GF(2) linear systems") {
+  std::mt19937 rng(4);
+  const MatrixXb a = random_matrix(70, 120, rng);
+  GIVEN("A consistent system") {
+    const MatrixXb b = multiply(a, random_matrix(120, 5, rng));
+    const std::optional<GF2Matrix> x = GF2Matrix(a).solve(GF2Matrix(b));
+    REQUIRE(x);
+    CHECK(multiply(a, x->get_matrix()) == b);
+  }
+  GIVEN("An inconsistent system") {
+    MatrixXb a2(71, 120);
+    a2.topRows(70) = a;
+    a2.row(70) = a.row(0).cwiseNotEqual(a.row(1));
+    MatrixXb b = MatrixXb::Zero(71, 1);
+    b(70, 0) = true;
+    CHECK_FALSE(GF2Matrix(a2).solve(GF2Matrix(b)));
+  }
+  GIVEN("The nullspace") {
+    const GF2Matrix basis = GF2Matrix(a).nullspace();
+    CHECK(basis.get_n_rows() == 120 - GF2Matrix(a).rank());
+    CHECK(basis.rank() == basis.get_n_rows());
+    CHECK_FALSE(multiply(a, basis.get_matrix().transpose()).any());
+  }
+}
+
+}  // namespace test_GF2Matrix
+}  // namespace tket
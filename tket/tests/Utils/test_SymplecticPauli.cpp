@@ -0,0 +1,100 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#include "Utils/SymplecticPauli.hpp"
+
+namespace tket {
+namespace test_SymplecticPauli {
+
+// All products of Pauli strings on a few qubits, checked against the
+// map-based QubitPauliTensor.
+SCENARIO("Symplectic Pauli tensors agree with QubitPauliTensor") {
+  const unsigned n = 3;
+  qubit_vector_t qubits;
+  for (unsigned q = 0; q < n; ++q) qubits.push_back(Qubit(q));
+  const qubit_index_t index = make_qubit_index(qubits);
+  std::vector<std::vector<Pauli>> strings;
+  for (unsigned code = 0; code < 64; ++code) {
+    strings.push_back(
+        {Pauli(code % 4), Pauli((code / 4) % 4), Pauli((code / 16) % 4)});
+  }
+  for (const std::vector<Pauli>& s1 : strings) {
+    for (const std::vector<Pauli>& s2 : strings) {
+      const SymplecticPauliTensor sp1(s1, 1);
+      const SymplecticPauliTensor sp2(s2, 2);
+      const QubitPauliTensor qpt1 = to_qubit_pauli_tensor(sp1, qubits);
+      const QubitPauliTensor qpt2 = to_qubit_pauli_tensor(sp2, qubits);
+      CHECK(to_symplectic(qpt1, index) == sp1);
+      CHECK(sp1.commutes_with(sp2) == qpt1.commutes_with(qpt2));
+      CHECK(to_qubit_pauli_tensor(sp1 * sp2, qubits) == qpt1 * qpt2);
+      CHECK(
+          sp1.conflicting_qubits(sp2).size() ==
+          qpt1.conflicting_qubits(qpt2).size());
+      CHECK(sp1.common_qubits(sp2).size() == qpt1.common_qubits(qpt2).size());
+      CHECK(sp1.own_qubits(sp2).size() == qpt1.own_qubits(qpt2).size());
+    }
+  }
+}
+
+SCENARIO("Symplectic Pauli tensors over many words") {
+  GIVEN("Tensors on more than 64 qubits") {
+    const unsigned n = 130;
+    SymplecticPauliTensor a(n), b(n);
+    a.set(0, Pauli::X);
+    a.set(70, Pauli::Y);
+    a.set(129, Pauli::Z);
+    b.set(70, Pauli::Z);
+    b.set(129, Pauli::Z);
+    CHECK(a.weight() == 3);
+    CHECK(a.get(70) == Pauli::Y);
+    CHECK(a.get(71) == Pauli::I);
+    CHECK(!a.commutes_with(b));
+    b.set(0, Pauli::Z);
+    CHECK(a.commutes_with(b));
+    // X.Z = -iY, Y.Z = iX, Z.Z = I
+    SymplecticPauliTensor product = a * b;
+    CHECK(product.get_phase() == 0);
+    CHECK(product.get(0) == Pauli::Y);
+    CHECK(product.get(70) == Pauli::X);
+    CHECK(product.get(129) == Pauli::I);
+    CHECK(a.conflicting_qubits(b) == std::vector<unsigned>{0, 70});
+    CHECK(a.common_qubits(b) == std::vector<unsigned>{129});
+    CHECK(b.own_qubits(a).empty());
+    a *= a;
+    CHECK(a == SymplecticPauliTensor(n));
+  }
+  GIVEN("A conversion from an arbitrary qubit order") {
+    const qubit_vector_t qubits{Qubit("a", 1), Qubit("b", 0), Qubit(3)};
+    const qubit_index_t index = make_qubit_index(qubits);
+    const QubitPauliString qps(
+        QubitPauliMap{{Qubit(3), Pauli::X}, {Qubit("a", 1), Pauli::Z}});
+    const SymplecticPauliTensor spt = to_symplectic(qps, index);
+    CHECK(spt.get(0) == Pauli::Z);
+    CHECK(spt.get(1) == Pauli::I);
+    CHECK(spt.get(2) == Pauli::X);
+    CHECK(to_qubit_pauli_string(spt, qubits) == qps);
+    CHECK_THROWS_AS(
+        to_symplectic(QubitPauliString(Qubit(5), Pauli::Y), index),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        to_symplectic(QubitPauliTensor(qps, 0.5), index),
+        std::invalid_argument);
+  }
+}
+
+}  // namespace test_SymplecticPauli
+}  // namespace tket
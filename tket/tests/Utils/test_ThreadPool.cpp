@@ -0,0 +1,98 @@
+// Copyright 2019-2022 Cambridge Quantum Computing
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Utils/ThreadPool.hpp"
+
+namespace tket {
+namespace test_ThreadPool {
+
+SCENARIO("parallel_for runs every task once") {
+  for (unsigned number_of_threads : {1u, 2u, 4u, 0u}) {
+    std::vector<unsigned> counts(1000, 0);
+    const unsigned expected_number_of_threads =
+        get_number_of_threads(counts.size(), number_of_threads);
+    std::atomic<bool> thread_indices_in_range(true);
+    parallel_for(
+        counts.size(), number_of_threads,
+        [&](std::size_t i, unsigned thread_index) {
+          if (thread_index >= expected_number_of_threads) {
+            thread_indices_in_range = false;
+          }
+          ++counts[i];
+        });
+    CHECK(thread_indices_in_range);
+    for (unsigned count : counts) {
+      REQUIRE(count == 1);
+    }
+  }
+  GIVEN("No tasks") {
+    parallel_for(0, 4, [](std::size_t, unsigned) { FAIL(); });
+  }
+}
+
+SCENARIO("parallel_for gives concurrent tasks distinct thread indices") {
+  const unsigned number_of_threads = 4;
+  std::vector<std::atomic<unsigned>> in_use(number_of_threads);
+  std::atomic<bool> clash(false);
+  parallel_for(
+      2000, number_of_threads, [&](std::size_t, unsigned thread_index) {
+        if (in_use[thread_index]++ != 0) clash = true;
+        --in_use[thread_index];
+      });
+  CHECK_FALSE(clash);
+}
+
+SCENARIO("parallel_for may be called from within a task") {
+  std::atomic<std::size_t> sum(0);
+  parallel_for(8, 4, [&](std::size_t, unsigned) {
+    parallel_for(100, 4, [&](std::size_t j, unsigned) { sum += j; });
+  });
+  CHECK(sum == 8 * 4950);
+}
+
+SCENARIO("parallel_for rethrows the first failing task's exception") {
+  for (unsigned number_of_threads : {1u, 4u}) {
+    std::atomic<unsigned> n_run(0);
+    try {
+      parallel_for(100, number_of_threads, [&](std::size_t i, unsigned) {
+        ++n_run;
+        if (i % 10 == 7) throw std::runtime_error(std::to_string(i));
+      });
+      FAIL();
+    } catch (const std::runtime_error& e) {
+      CHECK(std::string(e.what()) == "7");
+    }
+    CHECK(n_run == 100);
+  }
+}
+
+SCENARIO("The default number of threads can be set") {
+  set_default_number_of_threads(3);
+  CHECK(get_default_number_of_threads() == 3);
+  CHECK(get_number_of_threads(10, 0) == 3);
+  CHECK(get_number_of_threads(2, 0) == 2);
+  CHECK(get_number_of_threads(0, 0) == 1);
+  CHECK(get_number_of_threads(10, 5) == 5);
+  set_default_number_of_threads(0);
+  CHECK(get_default_number_of_threads() >= 1);
+}
+
+}  // namespace test_ThreadPool
+}  // namespace tket
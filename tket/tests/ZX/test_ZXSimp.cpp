@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <catch2/catch_test_macros.hpp>
+#include <optional>
 
 #include "ZX/Rewrite.hpp"
 
@@ -111,6 +112,155 @@ SCENARIO("Testing graph state simplification") {
   CHECK_FALSE(Rewrite::parallel_h_removal().apply(diag1));
 }
 
+SCENARIO("Local complementation toggles wires between neighbours") {
+  GIVEN("A proper Clifford spider with three interior neighbours") {
+    ZXDiagram diag(3, 0, 0, 0);
+    ZXVertVec ins = diag.get_boundary(ZXType::Input);
+    ZXVert v = diag.add_vertex(ZXType::ZSpider, 0.5);
+    ZXVertVec ns;
+    for (unsigned i = 0; i < 3; ++i) {
+      ns.push_back(diag.add_vertex(ZXType::ZSpider, 0.25));
+      diag.add_wire(ins[i], ns[i]);
+      diag.add_wire(v, ns[i], ZXWireType::H);
+    }
+    diag.add_wire(ns[0], ns[1], ZXWireType::H);
+    REQUIRE(Rewrite::remove_interior_cliffords().apply(diag));
+    REQUIRE_NOTHROW(diag.check_validity());
+    CHECK(diag.is_graphlike());
+    CHECK(diag.n_vertices() == 6);
+    CHECK(diag.n_wires() == 5);
+    CHECK(!diag.wire_between(ns[0], ns[1]));
+    for (unsigned i = 0; i < 2; ++i) {
+      std::optional<Wire> w = diag.wire_between(ns[i], ns[2]);
+      REQUIRE(w);
+      CHECK(diag.get_wire_type(*w) == ZXWireType::H);
+    }
+    for (const ZXVert& n : ns) {
+      CHECK(diag.get_vertex_ZXGen<PhasedGen>(n).get_param() == -0.25);
+    }
+  }
+  GIVEN("A neighbourhood with parallel wires") {
+    ZXDiagram diag(2, 0, 0, 0);
+    ZXVertVec ins = diag.get_boundary(ZXType::Input);
+    ZXVert v = diag.add_vertex(ZXType::ZSpider, 0.5);
+    ZXVert a = diag.add_vertex(ZXType::ZSpider);
+    ZXVert b = diag.add_vertex(ZXType::ZSpider);
+    diag.add_wire(ins[0], a);
+    diag.add_wire(ins[1], b);
+    diag.add_wire(v, a, ZXWireType::H);
+    diag.add_wire(v, b, ZXWireType::H);
+    diag.add_wire(a, b, ZXWireType::H);
+    diag.add_wire(a, b, ZXWireType::H);
+    REQUIRE(Rewrite::remove_interior_cliffords().apply(diag));
+    REQUIRE_NOTHROW(diag.check_validity());
+    CHECK(diag.n_vertices() == 4);
+    CHECK(diag.wires_between(a, b).size() == 1);
+  }
+  GIVEN("A pair of adjacent interior Pauli spiders") {
+    ZXDiagram diag(4, 0, 0, 0);
+    ZXVertVec ins = diag.get_boundary(ZXType::Input);
+    ZXVert u = diag.add_vertex(ZXType::ZSpider);
+    ZXVert v = diag.add_vertex(ZXType::ZSpider, 1.);
+    ZXVertVec ns;
+    for (unsigned i = 0; i < 4; ++i) {
+      ns.push_back(diag.add_vertex(ZXType::ZSpider, 0.25));
+      diag.add_wire(ins[i], ns[i]);
+    }
+    diag.add_wire(u, v, ZXWireType::H);
+    // ns[0] neighbours only u, ns[1] only v, ns[2] and ns[3] both
+    diag.add_wire(u, ns[0], ZXWireType::H);
+    diag.add_wire(v, ns[1], ZXWireType::H);
+    for (unsigned i = 2; i < 4; ++i) {
+      diag.add_wire(u, ns[i], ZXWireType::H);
+      diag.add_wire(v, ns[i], ZXWireType::H);
+    }
+    diag.add_wire(ns[0], ns[1], ZXWireType::H);
+    REQUIRE(Rewrite::remove_interior_paulis().apply(diag));
+    REQUIRE_NOTHROW(diag.check_validity());
+    CHECK(diag.is_graphlike());
+    CHECK(diag.n_vertices() == 8);
+    // Every pair across the three sets is toggled
+    CHECK(!diag.wire_between(ns[0], ns[1]));
+    for (unsigned i = 2; i < 4; ++i) {
+      CHECK(diag.wire_between(ns[0], ns[i]));
+      CHECK(diag.wire_between(ns[1], ns[i]));
+    }
+    CHECK(!diag.wire_between(ns[2], ns[3]));
+    CHECK(diag.n_wires() == 8);
+  }
+}
+
+SCENARIO("Rewrites driven by a worklist") {
+  GIVEN("Spiders to fuse and parallel Hadamard wires") {
+    ZXDiagram diag(1, 1, 0, 0);
+    ZXVert in = diag.get_boundary(ZXType::Input).at(0);
+    ZXVert out = diag.get_boundary(ZXType::Output).at(0);
+    ZXVert z0 = diag.add_vertex(ZXType::ZSpider, 0.5);
+    ZXVert z1 = diag.add_vertex(ZXType::ZSpider);
+    ZXVert z2 = diag.add_vertex(ZXType::ZSpider, 0.25);
+    diag.add_wire(in, z0);
+    diag.add_wire(z0, z1, ZXWireType::H);
+    diag.add_wire(z0, z1, ZXWireType::H);
+    diag.add_wire(z1, z2);
+    diag.add_wire(z2, out);
+    Rewrite rw = Rewrite::worklist(
+        {Rewrite::spider_fusion(), Rewrite::parallel_h_removal()});
+    REQUIRE(rw.apply(diag));
+    REQUIRE_NOTHROW(diag.check_validity());
+    CHECK(diag.n_vertices() == 4);
+    CHECK(diag.n_wires() == 2);
+    CHECK(diag.degree(z0) == 1);
+    CHECK_FALSE(rw.apply(diag));
+  }
+  GIVEN("A long chain of spiders") {
+    const unsigned n = 100;
+    ZXDiagram diag(1, 1, 0, 0);
+    ZXVert prev = diag.get_boundary(ZXType::Input).at(0);
+    for (unsigned i = 0; i < n; ++i) {
+      ZXVert z = diag.add_vertex(
+          (i % 2 == 0) ? ZXType::ZSpider : ZXType::XSpider, 0.25);
+      diag.add_wire(prev, z, (i == 0) ? ZXWireType::Basic : ZXWireType::H);
+      prev = z;
+    }
+    diag.add_wire(prev, diag.get_boundary(ZXType::Output).at(0));
+    ZXDiagram diag2 = diag;
+    REQUIRE(Rewrite::worklist({Rewrite::spider_fusion()}).apply(diag));
+    REQUIRE(Rewrite::repeat(Rewrite::spider_fusion()).apply(diag2));
+    CHECK(diag.n_vertices() == 3);
+    CHECK(diag.n_vertices() == diag2.n_vertices());
+    CHECK(diag.n_wires() == diag2.n_wires());
+  }
+  GIVEN("A proper Clifford spider in a diagram that is not graph-like") {
+    ZXDiagram diag(4, 0, 0, 0);
+    ZXVertVec ins = diag.get_boundary(ZXType::Input);
+    ZXVert v = diag.add_vertex(ZXType::ZSpider, 0.5);
+    ZXVertVec ns;
+    for (unsigned i = 0; i < 3; ++i) {
+      ns.push_back(diag.add_vertex(ZXType::ZSpider, 0.25));
+      diag.add_wire(ins[i], ns[i]);
+      diag.add_wire(v, ns[i], ZXWireType::H);
+    }
+    // An X spider away from the neighbourhood of `v`
+    ZXVert x = diag.add_vertex(ZXType::XSpider);
+    diag.add_wire(ins[3], x);
+    diag.add_wire(x, ns[2]);
+    REQUIRE_FALSE(diag.is_graphlike());
+    CHECK_FALSE(Rewrite::remove_interior_cliffords().apply(diag));
+    REQUIRE(Rewrite::worklist({Rewrite::remove_interior_cliffords()})
+                .apply(diag));
+    REQUIRE_NOTHROW(diag.check_validity());
+    CHECK(diag.n_vertices() == 8);
+    CHECK(diag.wire_between(ns[0], ns[1]));
+    CHECK(diag.wire_between(ns[0], ns[2]));
+    CHECK(diag.wire_between(ns[1], ns[2]));
+    CHECK(diag.wire_between(x, ns[2]));
+  }
+  GIVEN("A rewrite with no vertex-local form") {
+    REQUIRE_THROWS_AS(
+        Rewrite::worklist({Rewrite::red_to_green()}), ZXError);
+  }
+}
+
 }  // namespace test_ZXSimp
 }  // namespace zx
 }  // namespace tket
@@ -218,6 +218,36 @@ SCENARIO("Synthesis of circuits from Tableaus") {
     CliffTableau res_tab = circuit_to_tableau(res);
     REQUIRE(res_tab == tab);
   }
+  GIVEN("A circuit on more qubits than fit in one word") {
+    const unsigned n = 70;
+    Circuit circ(n);
+    circ.add_op<unsigned>(OpType::H, {0});
+    for (unsigned i = 0; i + 1 < n; i++) {
+      circ.add_op<unsigned>(OpType::CX, {i, i + 1});
+    }
+    circ.add_op<unsigned>(OpType::S, {n - 1});
+    circ.add_op<unsigned>(OpType::CY, {n - 1, 3});
+    CliffTableau tab = circuit_to_tableau(circ);
+    Circuit res = tableau_to_circuit(tab);
+    CliffTableau res_tab = circuit_to_tableau(res);
+    REQUIRE(res_tab == tab);
+    THEN("Rows spanning the word boundary are correct") {
+      // Z on the last qubit commutes back through the CX ladder to
+      // Z on every qubit, and then through the H to X on the first
+      Circuit ladder(n);
+      ladder.add_op<unsigned>(OpType::H, {0});
+      for (unsigned i = 0; i + 1 < n; i++) {
+        ladder.add_op<unsigned>(OpType::CX, {i, i + 1});
+      }
+      CliffTableau ladder_tab = circuit_to_tableau(ladder);
+      QubitPauliMap expected{{Qubit(0), Pauli::X}};
+      for (unsigned i = 1; i < n; i++) {
+        expected.insert({Qubit(i), Pauli::Z});
+      }
+      REQUIRE(
+          ladder_tab.get_zpauli(Qubit(n - 1)) == QubitPauliTensor(expected));
+    }
+  }
 }
 
 }  // namespace test_CliffTableau
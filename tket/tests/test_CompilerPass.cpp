@@ -13,13 +13,18 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <thread>
 #include <tkrng/RNG.hpp>
 #include <vector>
 
+#include "Circuit/Boxes.hpp"
 #include "Circuit/CircPool.hpp"
 #include "Circuit/Circuit.hpp"
 #include "Circuit/Command.hpp"
+#include "Gate/SymTable.hpp"
 #include "Mapping/LexiLabelling.hpp"
 #include "Mapping/LexiRoute.hpp"
 #include "OpType/OpType.hpp"
@@ -30,6 +35,7 @@
 #include "Predicates/CompilerPass.hpp"
 #include "Predicates/PassGenerators.hpp"
 #include "Predicates/PassLibrary.hpp"
+#include "Predicates/PassProfiler.hpp"
 #include "Simulation/CircuitSimulator.hpp"
 #include "Simulation/ComparisonFunctions.hpp"
 #include "Transformations/ContextualReduction.hpp"
@@ -1441,5 +1447,168 @@ SCENARIO("CustomPass") {
   }
 }
 
+// Run f(0), ..., f(n-1) on several threads.
+template <typename F>
+static void run_concurrently(unsigned n, const F& f) {
+  std::atomic<unsigned> next(0);
+  auto worker = [&]() {
+    for (unsigned i = next++; i < n; i = next++) f(i);
+  };
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < 8; ++t) threads.emplace_back(worker);
+  for (std::thread& thread : threads) thread.join();
+}
+
+SCENARIO("Compiling circuits concurrently") {
+  // Build with the THREAD_SANITIZER option to check for data races.
+  GIVEN("Fresh symbols requested on many threads") {
+    const unsigned n_symbols = 400;
+    std::vector<std::string> names(n_symbols);
+    run_concurrently(n_symbols, [&](unsigned i) {
+      names[i] = SymTable::fresh_symbol("concurrent")->get_name();
+    });
+    std::set<std::string> distinct(names.begin(), names.end());
+    REQUIRE(distinct.size() == n_symbols);
+  }
+  GIVEN("Circuits sharing a box, a symbol and an architecture") {
+    const Sym alpha = SymTable::fresh_symbol("alpha");
+    // Copies of the base circuit share the box, whose circuit is only
+    // generated when it is first decomposed.
+    Circuit base(6);
+    base.add_box(PauliExpBox({Pauli::X, Pauli::Y}, Expr(alpha)), {0, 1});
+    RNG rng;
+    const unsigned n_circuits = 48;
+    std::vector<Circuit> circuits(n_circuits, base);
+    for (Circuit& circ : circuits) {
+      for (unsigned i = 0; i < 40; ++i) {
+        unsigned q0 = rng.get_size_t(5);
+        unsigned q1 = (q0 + 1 + rng.get_size_t(4)) % 6;
+        switch (rng.get_size_t(2)) {
+          case 0:
+            circ.add_op<unsigned>(OpType::CX, {q0, q1});
+            break;
+          case 1:
+            circ.add_op<unsigned>(OpType::Rz, 0.125 * q1, {q0});
+            break;
+          default:
+            circ.add_op<unsigned>(OpType::Rx, Expr(alpha) * q1, {q0});
+        }
+      }
+    }
+    Architecture arc(
+        {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 6}, {6, 7}, {1, 6}});
+    std::vector<PassPtr> passes = {
+        DecomposeBoxes(), SynthesiseTket(), gen_naive_placement_pass(arc),
+        gen_routing_pass(
+            arc, {std::make_shared<LexiLabellingMethod>(),
+                  std::make_shared<LexiRouteRoutingMethod>()}),
+        SynthesiseTket()};
+    PassPtr pass = std::make_shared<SequencePass>(passes);
+
+    std::vector<Circuit> results(n_circuits);
+    run_concurrently(n_circuits, [&](unsigned i) {
+      CompilationUnit cu(circuits[i]);
+      pass->apply(cu);
+      results[i] = cu.get_circ_ref();
+    });
+    for (unsigned i = 0; i < n_circuits; ++i) {
+      CompilationUnit cu(circuits[i]);
+      pass->apply(cu);
+      REQUIRE(results[i] == cu.get_circ_ref());
+    }
+  }
+}
+
+SCENARIO("Profiling pass applications") {
+  GIVEN("A repeated sequence of passes") {
+    Circuit circ(2);
+    circ.add_op<unsigned>(OpType::CX, {0, 1});
+    circ.add_op<unsigned>(OpType::X, {0});
+    circ.add_op<unsigned>(OpType::X, {0});
+    CompilationUnit cu(circ);
+    PassPtr pass = std::make_shared<RepeatPass>(
+        CommuteThroughMultis() >> RemoveRedundancies());
+    PassProfiler profiler;
+    REQUIRE(pass->apply(
+        cu, SafetyMode::Default, profiler.before_apply(),
+        profiler.after_apply()));
+    THEN("Every application is recorded with its nesting") {
+      const std::vector<PassProfiler::Record>& records =
+          profiler.get_records();
+      REQUIRE(!records.empty());
+      const PassProfiler::Record& outer = records.back();
+      CHECK(outer.name == "RepeatPass");
+      CHECK(outer.depth == 0);
+      CHECK(outer.gates_before == 3);
+      CHECK(outer.gates_after == 1);
+      REQUIRE(outer.iterations >= 2);
+      REQUIRE(records.size() == 1 + 3 * outer.iterations);
+      for (unsigned i = 0; i + 1 < records.size(); i += 3) {
+        CHECK(records[i].name == "CommuteThroughMultis");
+        CHECK(records[i].depth == 2);
+        CHECK(records[i + 1].name == "RemoveRedundancies");
+        CHECK(records[i + 1].depth == 2);
+        CHECK(records[i + 2].name == "SequencePass");
+        CHECK(records[i + 2].depth == 1);
+        CHECK(records[i + 2].iterations == 2);
+        CHECK(records[i + 2].start_us <= records[i].start_us);
+        CHECK(records[i + 2].wall_us >= records[i + 1].wall_us);
+      }
+    }
+    THEN("The records can be exported") {
+      nlohmann::json trace = profiler.to_chrome_trace();
+      REQUIRE(trace["traceEvents"].size() == profiler.get_records().size());
+      for (const nlohmann::json& event : trace["traceEvents"]) {
+        CHECK(event["ph"] == "X");
+        CHECK(event.contains("ts"));
+        CHECK(event.contains("dur"));
+      }
+      nlohmann::json summary = profiler.to_json();
+      CHECK(summary["RepeatPass"]["calls"] == 1);
+      CHECK(summary["RepeatPass"]["gate_change"] == -2);
+      CHECK(
+          summary["SequencePass"]["calls"] ==
+          profiler.get_records().back().iterations);
+      profiler.clear();
+      CHECK(profiler.get_records().empty());
+    }
+  }
+  GIVEN("A pass which throws") {
+    Circuit circ(2);
+    circ.add_op<unsigned>(OpType::CX, {0, 1});
+    circ.add_op<unsigned>(OpType::X, {0});
+    circ.add_op<unsigned>(OpType::X, {0});
+    OpTypeSet ots = {OpType::X};
+    PredicatePtr gsp = std::make_shared<GateSetPredicate>(ots);
+    PredicatePtrMap ppm{CompilationUnit::make_type_pair(gsp)};
+    PassPtr failing = std::make_shared<StandardPass>(
+        ppm, Transforms::id, PostConditions{},
+        nlohmann::json{{"name", "Failing"}});
+    PassPtr seq = std::make_shared<SequencePass>(std::vector<PassPtr>{failing});
+    PassProfiler profiler;
+    CompilationUnit cu(circ);
+    REQUIRE_THROWS_AS(
+        seq->apply(
+            cu, SafetyMode::Default, profiler.before_apply(),
+            profiler.after_apply()),
+        UnsatisfiedPredicate);
+    CHECK(profiler.get_records().empty());
+    CHECK(BasePass::apply_depth() == 0);
+    THEN("Later applications are recorded at the right depth") {
+      CompilationUnit cu2(circ);
+      REQUIRE(RemoveRedundancies()->apply(
+          cu2, SafetyMode::Default, profiler.before_apply(),
+          profiler.after_apply()));
+      const std::vector<PassProfiler::Record>& records =
+          profiler.get_records();
+      REQUIRE(records.size() == 1);
+      CHECK(records[0].name == "RemoveRedundancies");
+      CHECK(records[0].depth == 0);
+      CHECK(records[0].gates_before == 3);
+      CHECK(records[0].gates_after == 1);
+    }
+  }
+}
+
 }  // namespace test_CompilerPass
 }  // namespace tket
@@ -17,6 +17,8 @@
 #include <fstream>
 #include <iostream>
 
+#include "Mapping/LexiLabelling.hpp"
+#include "Mapping/LexiRouteRoutingMethod.hpp"
 #include "Mapping/MappingManager.hpp"
 
 namespace tket {
@@ -94,4 +96,42 @@ SCENARIO("Test MappingManager::route_circuit") {
     REQUIRE(*c2.get_op_ptr() == *get_op_ptr(OpType::CX));
   }
 }
+
+SCENARIO("Test MappingManager::route_circuits") {
+  SquareGrid sg(4, 5);
+  ArchitecturePtr shared_arc = std::make_shared<Architecture>(sg);
+  MappingManager test_mm(shared_arc);
+  std::vector<RoutingMethodPtr> vrm = {
+      std::make_shared<LexiLabellingMethod>(),
+      std::make_shared<LexiRouteRoutingMethod>()};
+  GIVEN("Many circuits of different sizes.") {
+    std::vector<Circuit> circuits;
+    for (unsigned n = 3; n <= 20; n++) {
+      Circuit circ(n);
+      for (unsigned i = 0; i < 3 * n; i++) {
+        circ.add_op<unsigned>(
+            OpType::CX, {(5 * i) % n, (5 * i + 1 + i % (n - 1)) % n});
+      }
+      circuits.push_back(circ);
+    }
+    std::vector<Circuit> sequential = circuits;
+    std::vector<bool> sequential_modified;
+    for (Circuit& circ : sequential) {
+      sequential_modified.push_back(test_mm.route_circuit(circ, vrm));
+    }
+    std::vector<bool> modified = test_mm.route_circuits(circuits, vrm, true, 4);
+    REQUIRE(shared_arc->distances_precomputed());
+    REQUIRE(modified == sequential_modified);
+    for (unsigned i = 0; i < circuits.size(); i++) {
+      CHECK(circuits[i] == sequential[i]);
+    }
+  }
+  GIVEN("A circuit which cannot be routed.") {
+    std::vector<Circuit> circuits(3, Circuit(2));
+    circuits[1] = Circuit(21);
+    REQUIRE_THROWS_AS(
+        test_mm.route_circuits(circuits, vrm, false), MappingManagerError);
+    REQUIRE(circuits[0] == Circuit(2));
+  }
+}
 }  // namespace tket
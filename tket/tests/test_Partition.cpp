@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
+#include <random>
 
 #include "Diagonalisation/PauliPartition.hpp"
 #include "testutil.hpp"
@@ -31,7 +33,8 @@ SCENARIO("Small sets of Gadgets are partitioned correctly") {
   // more extensive tests with larger sets.
   const std::vector<GraphColourMethod> colouring_methods{
       GraphColourMethod::LargestFirst, GraphColourMethod::Exhaustive,
-      GraphColourMethod::Lazy};
+      GraphColourMethod::Lazy, GraphColourMethod::DSatur,
+      GraphColourMethod::JonesPlassmann};
 
   GIVEN("No gadgets") {
     for (auto colouring_method : colouring_methods) {
@@ -96,5 +99,92 @@ SCENARIO("Small sets of Gadgets are partitioned correctly") {
   }
 }
 
+// Random strings over the given number of qubits, each qubit having
+// a nontrivial Pauli with probability 1/2.
+static std::list<QubitPauliString> random_strings(
+    unsigned n_strings, unsigned n_qubits, std::mt19937& rng) {
+  std::list<QubitPauliString> strings;
+  std::uniform_int_distribution<unsigned> dist(0, 5);
+  const std::vector<Pauli> paulis{Pauli::X, Pauli::Y, Pauli::Z};
+  for (unsigned i = 0; i < n_strings; ++i) {
+    QubitPauliString qps;
+    for (unsigned q = 0; q < n_qubits; ++q) {
+      const unsigned r = dist(rng);
+      if (r < 3) qps.map[Qubit(q)] = paulis[r];
+    }
+    strings.push_back(qps);
+  }
+  return strings;
+}
+
+static bool adjacent(
+    const QubitPauliString& qps1, const QubitPauliString& qps2,
+    PauliPartitionStrat strat) {
+  return strat == PauliPartitionStrat::CommutingSets
+             ? !qps1.commutes_with(qps2)
+             : !qps1.conflicting_qubits(qps2).empty();
+}
+
+SCENARIO("Larger sets of Pauli strings are partitioned correctly") {
+  std::mt19937 rng(1);
+  const std::vector<PauliPartitionStrat> strats{
+      PauliPartitionStrat::NonConflictingSets,
+      PauliPartitionStrat::CommutingSets};
+
+  GIVEN("Graphs built with several threads, over several words") {
+    // 70 qubits need two words per string.
+    const std::list<QubitPauliString> strings = random_strings(1200, 70, rng);
+    const std::vector<QubitPauliString> string_vec(
+        strings.cbegin(), strings.cend());
+    for (PauliPartitionStrat strat : strats) {
+      const PauliPartitionerGraph parallel(strings, strat, 4);
+      const PauliPartitionerGraph sequential(strings, strat, 1);
+      const graphs::CSRGraph& graph = parallel.get_graph();
+      REQUIRE(graph.get_number_of_vertices() == strings.size());
+      REQUIRE(
+          graph.get_number_of_edges() ==
+          sequential.get_graph().get_number_of_edges());
+      for (std::size_t v = 0; v < 50; ++v) {
+        const std::vector<std::size_t> neighbours(
+            graph.neighbours_begin(v), graph.neighbours_end(v));
+        REQUIRE(std::equal(
+            neighbours.cbegin(), neighbours.cend(),
+            sequential.get_graph().neighbours_begin(v),
+            sequential.get_graph().neighbours_end(v)));
+        std::vector<std::size_t> expected;
+        for (std::size_t w = 0; w < string_vec.size(); ++w) {
+          if (w != v && adjacent(string_vec[v], string_vec[w], strat)) {
+            expected.push_back(w);
+          }
+        }
+        REQUIRE(neighbours == expected);
+      }
+    }
+  }
+  GIVEN("Every colouring method") {
+    const std::list<QubitPauliString> strings = random_strings(40, 6, rng);
+    for (auto method :
+         {GraphColourMethod::Lazy, GraphColourMethod::LargestFirst,
+          GraphColourMethod::Exhaustive, GraphColourMethod::DSatur,
+          GraphColourMethod::JonesPlassmann}) {
+      for (PauliPartitionStrat strat : strats) {
+        const std::list<std::list<QubitPauliString>> terms =
+            term_sequence(strings, strat, method);
+        std::size_t total_terms = 0;
+        for (const std::list<QubitPauliString>& term : terms) {
+          REQUIRE(!term.empty());
+          total_terms += term.size();
+          for (const QubitPauliString& qps1 : term) {
+            for (const QubitPauliString& qps2 : term) {
+              REQUIRE(!adjacent(qps1, qps2, strat));
+            }
+          }
+        }
+        REQUIRE(total_terms == strings.size());
+      }
+    }
+  }
+}
+
 }  // namespace test_Partition
 }  // namespace tket
@@ -420,6 +420,77 @@ SCENARIO("Test PlacementPredicate") {
   }
 }
 
+SCENARIO("Predicates decided from a circuit summary") {
+  Node n0("test", 0);
+  Node n1("test", 1);
+  Node n2("test", 2);
+  Architecture arc({{n0, n1}, {n1, n2}});
+  const std::vector<PredicatePtr> preds{
+      std::make_shared<GateSetPredicate>(
+          OpTypeSet{OpType::CX, OpType::H, OpType::Rz, OpType::Measure}),
+      std::make_shared<NoClassicalControlPredicate>(),
+      std::make_shared<NoFastFeedforwardPredicate>(),
+      std::make_shared<MaxTwoQubitGatesPredicate>(),
+      std::make_shared<ConnectivityPredicate>(arc),
+      std::make_shared<DirectednessPredicate>(arc),
+      std::make_shared<CliffordCircuitPredicate>(),
+      std::make_shared<NoBarriersPredicate>(),
+      std::make_shared<NoMidMeasurePredicate>(),
+      std::make_shared<GlobalPhasedXPredicate>(),
+      std::make_shared<NormalisedTK2Predicate>()};
+
+  std::vector<Circuit> circs;
+  Circuit circ(3, 2);
+  circ.add_op<unsigned>(OpType::H, {0});
+  circ.add_op<unsigned>(OpType::CX, {0, 1});
+  circ.add_op<unsigned>(OpType::CX, {2, 1});
+  circs.push_back(circ);
+  circ.add_op<unsigned>(OpType::Rz, 0.3, {1});
+  circ.add_op<unsigned>(OpType::Measure, {1, 0});
+  circs.push_back(circ);
+  circ.add_conditional_gate<unsigned>(OpType::X, {}, {2}, {0}, 1);
+  circs.push_back(circ);
+  circ.add_op<unsigned>(OpType::Measure, {2, 1});
+  circ.add_barrier(std::vector<unsigned>{0, 1, 2});
+  circs.push_back(circ);
+  circ.add_op<unsigned>(OpType::CZ, {0, 2});
+  circs.push_back(circ);
+  Circuit circ2(3);
+  circ2.add_op<unsigned>(OpType::BRIDGE, {0, 1, 2});
+  circ2.add_op<unsigned>(OpType::TK2, {0.1, 0.2, 0.3}, {0, 1});
+  circ2.add_op<unsigned>(OpType::NPhasedX, {0.5, 0.}, {0, 1});
+  circs.push_back(circ2);
+  circ2.add_op<unsigned>(OpType::CCX, {0, 1, 2});
+  circs.push_back(circ2);
+  Circuit inner(2);
+  inner.add_op<unsigned>(OpType::CX, {0, 1});
+  circ2.add_box(CircBox(inner), {0, 2});
+  circs.push_back(circ2);
+
+  for (Circuit& c : circs) {
+    reassign_boundary(c, node_vector_t{n0, n1, n2});
+    const CircuitSummary summary(c);
+    for (const PredicatePtr& pred : preds) {
+      const std::optional<bool> result = pred->verify_summary(summary);
+      if (result) {
+        CHECK(*result == pred->verify(c));
+      }
+    }
+  }
+  GIVEN("A CompilationUnit whose circuit is changed by a pass") {
+    Circuit c(3);
+    c.add_op<unsigned>(OpType::CCX, {0, 1, 2});
+    PredicatePtr pred = std::make_shared<MaxTwoQubitGatesPredicate>();
+    CompilationUnit cu(c, std::vector<PredicatePtr>{pred});
+    REQUIRE_FALSE(cu.check_all_predicates());
+    CompilationUnit cu_copy(cu);
+    REQUIRE(DecomposeMultiQubitsCX()->apply(cu_copy, SafetyMode::Audit));
+    REQUIRE(cu_copy.check_all_predicates());
+    REQUIRE(&cu_copy.get_summary().get_circ() == &cu_copy.get_circ_ref());
+    REQUIRE_FALSE(cu.check_all_predicates());
+  }
+}
+
 SCENARIO("Verifying whether or not circuits have mid-circuit measurements") {
   PredicatePtr mid_meas_pred = std::make_shared<NoMidMeasurePredicate>();
   GIVEN("No measurements") {
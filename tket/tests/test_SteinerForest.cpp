@@ -17,6 +17,67 @@
 #include "ArchAwareSynth/SteinerForest.hpp"
 #include "testutil.hpp"
 namespace tket {
+
+namespace {
+
+bool is_better_reference(
+    const aas::CostedOperations& candidate,
+    const aas::CostedOperations& best) {
+  return (candidate.first < best.first) ||
+         ((candidate.first == best.first) &&
+          (candidate.second.size() < best.second.size()));
+}
+
+// The exhaustive search from before pruning was added, as a reference for
+// best_operations_lookahead.
+aas::CostedOperations unpruned_operation_search(
+    const aas::PathHandler& path, aas::SteinerForest forest,
+    unsigned lookahead, aas::OperationList row_operations) {
+  forest.add_row_globally(
+      row_operations.back().first, row_operations.back().second);
+  if ((lookahead == 0) || (forest.current_trees.empty())) {
+    return {forest.global_cost, row_operations};
+  }
+  unsigned index = forest.current_trees.rbegin()->first;
+  aas::OperationList operations_available =
+      forest.operations_available_under_the_index(path, index);
+  if (operations_available.empty()) {
+    return {forest.global_cost, row_operations};
+  }
+  aas::CostedOperations costed_operations;
+  bool first = true;
+  for (const aas::Operation& op : operations_available) {
+    row_operations.push_back(op);
+    aas::CostedOperations candidate_operations = unpruned_operation_search(
+        path, forest, lookahead - 1, row_operations);
+    row_operations.pop_back();
+    if (first || is_better_reference(candidate_operations, costed_operations)) {
+      costed_operations = std::move(candidate_operations);
+      first = false;
+    }
+  }
+  return costed_operations;
+}
+
+aas::CostedOperations unpruned_best_operations(
+    const aas::PathHandler& path, const aas::SteinerForest& forest,
+    unsigned lookahead) {
+  aas::CostedOperations costed_operations;
+  bool first = true;
+  for (const aas::Operation& op :
+       forest.operations_available_at_min_costs(path)) {
+    aas::CostedOperations candidate_operations =
+        unpruned_operation_search(path, forest, lookahead - 1, {op});
+    if (first || is_better_reference(candidate_operations, costed_operations)) {
+      costed_operations = std::move(candidate_operations);
+      first = false;
+    }
+  }
+  return costed_operations;
+}
+
+}  // namespace
+
 SCENARIO("Synthesise a CNOT-only steiner Forest") {
   GIVEN("Empty circuit") {
     const Architecture archi(
@@ -337,6 +398,46 @@ SCENARIO("Build a steiner Forest") {
     aas::CostedOperations expectedResult = std::pair(2, oplist2);
     REQUIRE(cosop == expectedResult);
   }
+  GIVEN("best_operations_lookahead with several threads") {
+    const Architecture archi(
+        {{Node(0), Node(1)},
+         {Node(1), Node(2)},
+         {Node(2), Node(3)},
+         {Node(2), Node(4)},
+         {Node(2), Node(5)}});
+
+    Circuit circ(6);
+    circ.add_op<unsigned>(OpType::CX, {0, 1});
+    circ.add_op<unsigned>(OpType::CX, {1, 2});
+    circ.add_op<unsigned>(OpType::CX, {2, 3});
+    circ.add_op<unsigned>(OpType::CX, {3, 4});
+    circ.add_op<unsigned>(OpType::CX, {4, 5});
+    circ.add_op<unsigned>(OpType::Rz, 0.3, {5});
+    circ.add_op<unsigned>(OpType::Rz, 0.3, {3});
+    circ.add_op<unsigned>(OpType::CX, {5, 0});
+    circ.add_op<unsigned>(OpType::CX, {2, 4});
+    circ.add_op<unsigned>(OpType::Rz, 0.3, {4});
+    circ.add_op<unsigned>(OpType::Rz, 0.3, {0});
+    PhasePolyBox ppbox(circ);
+    aas::SteinerForest sf = aas::SteinerForest(archi, ppbox);
+    aas::PathHandler pathhand(archi);
+
+    for (unsigned lookahead = 1; lookahead <= 4; ++lookahead) {
+      // Follow the synthesis to the end, checking each step against the
+      // search without pruning.
+      aas::SteinerForest forest = sf;
+      while (!forest.current_trees.empty()) {
+        aas::CostedOperations serial =
+            aas::best_operations_lookahead(pathhand, forest, lookahead, 1);
+        aas::CostedOperations parallel =
+            aas::best_operations_lookahead(pathhand, forest, lookahead, 4);
+        REQUIRE(serial == parallel);
+        REQUIRE(
+            serial == unpruned_best_operations(pathhand, forest, lookahead));
+        forest.add_operation_list(serial.second);
+      }
+    }
+  }
   GIVEN("operations_available_at_index") {
     const Architecture archi(
         {{Node(0), Node(1)}, {Node(1), Node(2)}, {Node(2), Node(3)}});
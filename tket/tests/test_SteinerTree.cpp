@@ -610,6 +610,34 @@ SCENARIO("Build some basic trees") {
     st.add_row(1, 2);
     st.add_row(2, 1);
   }
+  GIVEN("add row and undo") {
+    const Architecture archi(
+        {{Node(0), Node(1)},
+         {Node(1), Node(2)},
+         {Node(1), Node(3)},
+         {Node(1), Node(4)}});
+
+    aas::PathHandler handler(archi);
+    std::list<unsigned> nodes_to_add{0, 1, 4};
+    aas::SteinerTree st(handler, nodes_to_add, 0);
+
+    const std::vector<aas::SteinerNodeType> types = st.node_types;
+    const std::vector<unsigned> neighbours = st.num_neighbours;
+    const unsigned cost = st.tree_cost;
+    const int last_cost = st.last_operation_cost;
+    aas::SteinerRowChange change_1 = st.add_row(0, 1);
+    const std::vector<aas::SteinerNodeType> types_1 = st.node_types;
+    const unsigned cost_1 = st.tree_cost;
+    aas::SteinerRowChange change_2 = st.add_row(1, 4);
+    st.undo_row(change_2);
+    REQUIRE(st.node_types == types_1);
+    REQUIRE(st.tree_cost == cost_1);
+    st.undo_row(change_1);
+    REQUIRE(st.node_types == types);
+    REQUIRE(st.num_neighbours == neighbours);
+    REQUIRE(st.tree_cost == cost);
+    REQUIRE(st.last_operation_cost == last_cost);
+  }
   GIVEN("add row IV") {
     const Architecture archi(
         {{Node(0), Node(1)},
@@ -873,5 +901,69 @@ SCENARIO("Build some basic trees") {
     Circuit result = cnot.get_circuit();
     REQUIRE(cnot.valid_result());
   }
+  GIVEN("cached steiner trees") {
+    const Architecture archi(
+        {{Node(0), Node(1)},
+         {Node(1), Node(2)},
+         {Node(1), Node(3)},
+         {Node(1), Node(4)}});
+
+    aas::PathHandler handler(archi);
+    aas::SteinerCache cache(handler, aas::CNotSynthType::Rec);
+    const std::list<unsigned> nodes{0, 2, 4};
+    const aas::PathHandler& lower = cache.get_lower_paths();
+    const aas::SteinerTree& tree = cache.get_tree(lower, 0, nodes);
+    REQUIRE(cache.n_hits() == 0);
+    REQUIRE(&cache.get_tree(lower, 0, nodes) == &tree);
+    REQUIRE(cache.n_hits() == 1);
+    cache.get_tree(cache.get_paths(), 0, nodes);
+    REQUIRE(cache.n_hits() == 1);
+    cache.get_tree(cache.get_upper_paths(0), 0, nodes);
+    cache.get_tree(cache.get_upper_paths(0), 0, nodes);
+    REQUIRE(cache.n_hits() == 1);
+    std::list<unsigned> fresh_nodes(nodes);
+    aas::SteinerTree expected(lower, fresh_nodes, 0);
+    REQUIRE(tree.tree_nodes == expected.tree_nodes);
+    REQUIRE(tree.tree_cost == expected.tree_cost);
+  }
+  GIVEN("cnot synth with and without reusing steiner trees") {
+    const Architecture line(
+        {{Node(0), Node(1)},
+         {Node(1), Node(2)},
+         {Node(2), Node(3)},
+         {Node(3), Node(4)},
+         {Node(4), Node(5)}});
+    const Architecture tree(
+        {{Node(0), Node(1)},
+         {Node(0), Node(2)},
+         {Node(0), Node(3)},
+         {Node(1), Node(4)},
+         {Node(2), Node(5)}});
+    const std::vector<std::pair<unsigned, unsigned>> row_ops{
+        {0, 3}, {5, 1}, {2, 4}, {3, 5}, {1, 0}, {4, 2},
+        {0, 5}, {3, 1}, {5, 2}, {2, 0}, {4, 3}, {1, 4}};
+    DiagMatrix CNOT_matrix(MatrixXb::Identity(6, 6));
+    for (const auto& [r0, r1] : row_ops) {
+      CNOT_matrix.row_add(r0, r1);
+    }
+    const std::vector<std::pair<const Architecture*, aas::CNotSynthType>>
+        cases{
+            {&line, aas::CNotSynthType::HamPath},
+            {&line, aas::CNotSynthType::Rec},
+            {&tree, aas::CNotSynthType::Rec}};
+    for (const auto& [archi, cnottype] : cases) {
+      aas::PathHandler handler(*archi);
+      DiagMatrix cached_matrix = CNOT_matrix;
+      aas::SteinerCache cache(handler, cnottype);
+      Circuit cached = aas::aas_CNOT_synth(cached_matrix, cache);
+      DiagMatrix uncached_matrix = CNOT_matrix;
+      aas::SteinerCache no_cache(handler, cnottype, false);
+      Circuit uncached = aas::aas_CNOT_synth(uncached_matrix, no_cache);
+      REQUIRE(no_cache.n_hits() == 0);
+      REQUIRE(cached == uncached);
+      REQUIRE(cached_matrix.is_id());
+      REQUIRE(uncached_matrix.is_id());
+    }
+  }
 }
 }  // namespace tket
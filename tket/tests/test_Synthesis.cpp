@@ -20,6 +20,7 @@
 #include "Circuit/CircPool.hpp"
 #include "Circuit/CircUtils.hpp"
 #include "CircuitsForTesting.hpp"
+#include "Gate/GatePtr.hpp"
 #include "Gate/Rotation.hpp"
 #include "OpType/OpType.hpp"
 #include "OpType/OpTypeFunctions.hpp"
@@ -38,6 +39,7 @@
 #include "Transformations/PauliOptimisation.hpp"
 #include "Transformations/Rebase.hpp"
 #include "Transformations/Replacement.hpp"
+#include "Transformations/StandardSquash.hpp"
 #include "Transformations/Transform.hpp"
 #include "Utils/Expression.hpp"
 #include "testutil.hpp"
@@ -1820,6 +1822,115 @@ SCENARIO("Test TK1 gate decomp for some gates") {
   }
 }
 
+SCENARIO("Numeric TK1 angles and rotations") {
+  GIVEN("Single-qubit gates with numeric parameters") {
+    const std::vector<Expr> pars = {0.3, 0.7, 0.8};
+    const std::vector<OpType> types = {
+        OpType::Z,  OpType::X,       OpType::Y,    OpType::S,   OpType::Sdg,
+        OpType::T,  OpType::Tdg,     OpType::V,    OpType::Vdg, OpType::SX,
+        OpType::H,  OpType::SXdg,    OpType::Rx,   OpType::Ry,  OpType::Rz,
+        OpType::U1, OpType::PhasedX, OpType::TK1,  OpType::U2,  OpType::U3};
+    for (OpType type : types) {
+      std::vector<Expr> params(
+          pars.begin(), pars.begin() + optypeinfo().at(type).n_params());
+      Gate_ptr g = as_gate_ptr(get_op_ptr(type, params));
+      REQUIRE(g->get_numeric_params());
+      std::optional<std::vector<double>> angs = g->get_tk1_angles_numeric();
+      REQUIRE(angs);
+      std::vector<Expr> sym_angs = g->get_tk1_angles();
+      REQUIRE(angs->size() == 4);
+      for (unsigned i = 0; i < 4; i++) {
+        REQUIRE(test_equiv_val(sym_angs[i], angs->at(i), 4));
+      }
+    }
+  }
+  GIVEN("A gate with a symbolic parameter") {
+    Sym a = SymEngine::symbol("alpha");
+    Gate_ptr g = as_gate_ptr(get_op_ptr(OpType::Rz, Expr(a)));
+    REQUIRE_FALSE(g->get_numeric_params());
+    REQUIRE_FALSE(g->get_tk1_angles_numeric());
+  }
+  GIVEN("A chain of numeric rotations") {
+    const std::vector<std::pair<OpType, double>> rots = {
+        {OpType::Rz, 0.142}, {OpType::Rx, 0.528}, {OpType::Rz, 1.},
+        {OpType::Rx, 0.5},   {OpType::Ry, 1.5},   {OpType::Rx, 0.482},
+        {OpType::Rz, -0.3},  {OpType::Ry, 0.25}};
+    Circuit circ(1);
+    Rotation r;
+    for (const auto &[type, a] : rots) {
+      circ.add_op<unsigned>(type, a, {0});
+      r.apply(Rotation(type, a));
+    }
+    const std::vector<std::pair<OpType, OpType>> axes = {
+        {OpType::Rx, OpType::Ry}, {OpType::Ry, OpType::Rx},
+        {OpType::Ry, OpType::Rz}, {OpType::Rz, OpType::Ry},
+        {OpType::Rz, OpType::Rx}, {OpType::Rx, OpType::Rz}};
+    for (const auto &[p, q] : axes) {
+      auto [p1, q1, p2] = r.to_pqp(p, q);
+      Circuit pqp(1);
+      pqp.add_op<unsigned>(p, p1, {0});
+      pqp.add_op<unsigned>(q, q1, {0});
+      pqp.add_op<unsigned>(p, p2, {0});
+      REQUIRE(test_unitary_comparison(circ, pqp));
+    }
+  }
+  GIVEN("Rotations by exact angles") {
+    Rotation r(OpType::Rz, Expr(1) / 2);
+    r.apply(Rotation(OpType::Rz, Expr(1) / 4));
+    std::optional<Expr> a = r.angle(OpType::Rz);
+    REQUIRE(a);
+    REQUIRE_FALSE(eval_real_double(*a));
+    REQUIRE(*a == Expr(3) / 4);
+  }
+  GIVEN("Squashing gates with exact angles") {
+    Circuit circ(1);
+    circ.add_op<unsigned>(OpType::S, {0});
+    circ.add_op<unsigned>(OpType::T, {0});
+    circ.add_op<unsigned>(OpType::Rz, Expr(1) / 8, {0});
+    const Circuit original = circ;
+    Circuit pqp = circ;
+    REQUIRE(Transforms::squash_1qb_to_tk1().apply(pqp));
+    REQUIRE(Transforms::squash_factory({OpType::TK1}, CircPool::tk1_to_tk1)
+                .apply(circ));
+    for (const Circuit &c : {pqp, circ}) {
+      for (const Command &cmd : c) {
+        for (const Expr &e : cmd.get_op_ptr()->get_params()) {
+          REQUIRE_FALSE(eval_real_double(e));
+        }
+      }
+      REQUIRE_FALSE(eval_real_double(c.get_phase()));
+      REQUIRE(test_unitary_comparison(original, c));
+    }
+  }
+  GIVEN("Squashing exact gates together with numeric ones") {
+    Transforms::StandardSquasher squasher(
+        {OpType::H, OpType::S, OpType::Rz, OpType::TK1}, CircPool::tk1_to_tk1);
+    Circuit circ(1);
+    circ.add_op<unsigned>(OpType::H, {0});
+    circ.add_op<unsigned>(OpType::Rz, 0.3, {0});
+    circ.add_op<unsigned>(OpType::S, {0});
+    circ.add_op<unsigned>(OpType::Rz, Expr(1) / 4, {0});
+    circ.add_op<unsigned>(OpType::H, {0});
+    for (const Command &cmd : circ) {
+      squasher.append(as_gate_ptr(cmd.get_op_ptr()));
+    }
+    REQUIRE(squasher.is_numeric());
+    Circuit squashed = squasher.flush().first;
+    REQUIRE(squashed.n_gates() == 1);
+    REQUIRE(test_unitary_comparison(circ, squashed));
+    WHEN("A symbol is appended") {
+      Sym a = SymEngine::symbol("alpha");
+      squasher.append(as_gate_ptr(get_op_ptr(OpType::Rz, Expr(a))));
+      REQUIRE_FALSE(squasher.is_numeric());
+    }
+    WHEN("The squasher is cleared") {
+      squasher.clear();
+      squasher.append(as_gate_ptr(get_op_ptr(OpType::H)));
+      REQUIRE_FALSE(squasher.is_numeric());
+    }
+  }
+}
+
 SCENARIO("Testing in_weyl_chamber") {
   GIVEN("Normalised angles (1)") { REQUIRE(in_weyl_chamber({0.5, 0.5, 0})); }
   GIVEN("Normalised angles (2)") { REQUIRE(in_weyl_chamber({0.5, 0.3, 0})); }
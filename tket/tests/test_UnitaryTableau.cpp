@@ -276,6 +276,27 @@ SCENARIO("Compare SymplecticTableau and UnitaryTableau") {
   }
 }
 
+SCENARIO("Rank of a SymplecticTableau") {
+  GIVEN("Rows spanning several words, one the product of two others") {
+    const unsigned n = 70;
+    std::vector<Pauli> a(n, Pauli::I), b(n, Pauli::I), ab(n, Pauli::I),
+        c(n, Pauli::I);
+    a[0] = Pauli::Z;
+    a[69] = Pauli::X;
+    b[65] = Pauli::Y;
+    ab[0] = Pauli::Z;
+    ab[65] = Pauli::Y;
+    ab[69] = Pauli::X;
+    c[1] = Pauli::X;
+    SymplecticTableau dependent(
+        PauliStabiliserList{{a, true}, {b, true}, {ab, false}});
+    CHECK(dependent.rank() == 2);
+    SymplecticTableau independent(
+        PauliStabiliserList{{a, true}, {b, true}, {ab, false}, {c, true}});
+    CHECK(independent.rank() == 3);
+  }
+}
+
 SCENARIO("Tableau serialisation") {
   GIVEN("A circuit containing a tableau") {
     MatrixXb xx(3, 3);